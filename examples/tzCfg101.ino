@@ -7,10 +7,13 @@ The following discussion references functions as tzCfg.<functionName>() ... assu
 	TzCfg tzCfg;
  
 
-	WARNING: 	TzCfg requires 128 bytes of EEPROM storage. In TzCfg parlance, this 128 byte block is called the tzBlock. 
-					- Default location: 	The first 128 bytes of EEPROM storage.
+	WARNING: 	TzCfg requires 672 bytes of EEPROM storage (the tzJournal). The journal is a ring of 3 records, so that
+				EEPROM writes are spread across them. Each record holds a 16 byte header, and a 208 byte packed copy of the
+				tzBlock and the tzSchedule (upcoming DST transitions and the zone's rule).
+				TzCfg also uses the last 16 bytes of EEPROM (the tzDirectory), which record where the tzJournal is stored.
+					- Default location: 	The first 672 bytes of EEPROM storage.
 					- Alternate location:	Use tzCfg.setEepromStartByte() to select a different location
-											Valid locations range from 0 to (EEPROM.length() - 128);
+											Valid locations range from 0 to (EEPROM.length() - 688);
 					- Do NOT use TzCfg unless the required EEPROM storage is available.
             
     This code displays output on a serial console. The firmware has a 10 second countdown timer to give users
@@ -48,7 +51,7 @@ void setup() {
 	
 	//	Select the location where TzCfg will store the TzBlock mentioned in the WARNING above.
 	//	This is not normally required, but may be required by users who already use EEPROM.
-	tzCfg.setEepromStartByte(512); // <-- Tells tzCfg to use EEPROM bytes 512 to 639
+	tzCfg.setEepromStartByte(512); // <-- Tells tzCfg to use EEPROM bytes 512 to 1183
 
 	//	Configure the device's local time based on the IP address it uses.
 	tzCfg.setTimezoneByIP(); // <-- One of the "setTimzoneBy" commands is required here
@@ -24,8 +24,9 @@
     transition when Time.now() is not less than the transition time.
 
     It should be noted that these test methods do nothing unless the current time zone observes
-    DST and there is a pending DST transition. When a transition is triggered, the pending
-    transition is cleared until the next time tzCfg.setLocalTime() is run. This normally occurs
+    DST and there is a pending DST transition. When a transition is triggered, the next transition
+    in TzCfg's stored schedule becomes the pending transition. When the schedule is empty, the 
+    pending transition is cleared until the next time tzCfg.setLocalTime() is run. This normally occurs
     on reboots and scheduled refreshes, but tzCfg.setLocalTime() can be called (at will) in a
     test program if a reset is desired. 
     
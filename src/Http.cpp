@@ -1,8 +1,4 @@
-#include "application.h"
 #include "TzCfg.h"
-#include "spark_wiring_string.h"
-#include "spark_wiring_tcpclient.h"
-#include "spark_wiring_usbserial.h"
 
 /*      Library: TzCfg
         Module: Http.cpp contains the method that this library needs to perform
@@ -16,161 +12,274 @@
                 requirements as efficiently as possible. Since this project
                 encompasses both the library and the HTTP server code, a 
                 bare-bones approach can be used. 
+
+        The HTTP transaction is a state machine (connect, send, receive, parse)
+        that is advanced one non-blocking step per call to poll(), so that
+        TzCfg::maintainLocalTime() never stalls the firmware loop(). getJson()
+        remains available for callers that want a blocking transaction.
+
+        Requests are sent as HTTP/1.1. When the server frames its response
+        (Content-Length or chunked) and does not close the connection, the
+        connection is kept open for httpKeepAlive milliseconds, and the next
+        transaction to the same server skips DNS and the TCP handshake. This
+        halves the latency of the back-to-back timezonedb lookup passes.
 */
 // ----------------------------------------------------------- Class Constructor
 Http::Http() {
     this->error = false;
     this->statusCode = 0;
-    memset(&this->buffer[0], 0, sizeof(this->buffer));  // clears the response buffer
-    this->bufferIndex = 0;
+    this->state = HTTP_IDLE;
+    this->open = false;
+    this->reused = false;
+    this->binaryType = NULL;
+    this->errorCode = TZ_OK;
+    TZ_METRIC(this->metrics = NULL);
 };
 
-// ----------------------------------------------------------- getJson()
-int Http::getJson(char* hostName, int hostPort, char* hostPath, char*& jsonStr, uint& jsonSize, char* statusMsg, int statusMsgSize) {
-    client.connect(hostName, hostPort);
-    if (client.connected()) {
-        client.print("POST ");
-        client.print(hostPath);
-        client.print(" HTTP/1.0\r\n");
-    	client.println("Connection: close");
-    	client.print("HOST: ");
-    	client.println(hostName);
-    	client.println("Content-Length: 0");
-    	client.println("Accept: application/json");
-        client.println();
-        client.flush();
-    } else {
-        this->error = true;
-        strncpy(statusMsg, "(E621) Unable to connect to ", statusMsgSize);
-        strncat(statusMsg, hostName, statusMsgSize);
+// ----------------------------------------------------------- begin()
+// Prepares a new HTTP transaction. The transaction is performed by subsequent calls to poll()
+// The JSON in the response body is decoded into 'fields' as it arrives.
+// When a validator (from an earlier response's ETag or Last-Modified header) is given, the request is
+// conditional, and the server may answer "304 Not Modified" without a body.
+// When a binaryType is given, the request also accepts that Content-Type, and a binary body is kept in parser.bin[].
+void Http::begin(char* hostName, int hostPort, char* hostPath, JsonField* fields, int fieldCount, const char* validator, const char* binaryType) {
+    // An idle connection to the same server is reused, else it is closed
+    bool idle = ((this->state == HTTP_IDLE) || (this->state == HTTP_COMPLETE) || (this->state == HTTP_FAILED));
+    this->reused = (idle && this->open && (hostPort == this->hostPort) && (strcmp(hostName, this->hostName) == 0)
+                    && ((millis() - this->idleMillis) < httpKeepAlive) && client.connected());
+    if ( !this->reused) stop();
+    strncpy(this->hostName, hostName, sizeof(this->hostName));
+    this->hostName[sizeof(this->hostName) - 1] = '\0';
+    strncpy(this->hostPath, hostPath, sizeof(this->hostPath));
+    this->hostPath[sizeof(this->hostPath) - 1] = '\0';
+    this->hostPort = hostPort;
+    strncpy(this->validator, (validator != NULL) ? validator : "", sizeof(this->validator));
+    this->validator[sizeof(this->validator) - 1] = '\0';
+    this->binaryType = binaryType;
+    this->error = false;
+    this->errorCode = TZ_OK;
+    this->statusCode = 0;
+    TZ_METRIC(
+        if (this->metrics != NULL) {
+            this->metrics->connectMillis = 0;
+            this->metrics->firstByteMillis = 0;
+            this->metrics->responseMillis = 0;
+            this->metrics->parseMicros = 0;
+            this->metrics->httpStatus = 0;
+            if (this->reused) this->metrics->connectionsReused++;
+        }
+    )
+    this->json.begin(fields, fieldCount);
+    this->parser.begin(&this->json, binaryType);
+    this->state = (this->reused) ? HTTP_SENDING : HTTP_CONNECTING;
+}
+
+// ----------------------------------------------------------- stop()
+// Abandons the current HTTP transaction (if any) and releases the TCP connection
+void Http::stop(void) {
+    if ((this->state != HTTP_IDLE) || this->open) client.stop();
+    this->open = false;
+    this->state = HTTP_IDLE;
+}
+
+// ----------------------------------------------------------- closeIdle()
+// Releases an idle connection once it can no longer be reused
+void Http::closeIdle(void) {
+    if (this->open && (this->state != HTTP_CONNECTING) && (this->state != HTTP_SENDING) && (this->state != HTTP_RECEIVING)
+        && ((millis() - this->idleMillis) >= httpKeepAlive)) {
         client.stop();
+        this->open = false;
     }
+}
 
-    #ifdef LOGGING
-        Serial.println("\r\nHttp>\t---------- Start Http.getJson() ----------");
-        Serial.printf("Http>\thostName = %s\r\n", hostName);
-        Serial.printf("Http>\thostPort = %d\r\n", hostPort);
-        Serial.printf("Http>\thostPath = %s\r\n", hostPath);
-        if (jsonStr != NULL) Serial.printf("Http>\tjsonStr  = %s\r\n", jsonStr);
-        Serial.printf("Http>\tjsonSize = %d\r\n", jsonSize);
-    	if (client.connected()) {
-    		Serial.println("Http>\tClient is Connected to the HTTP server ...");
-    		Serial.println("Http>\tHTTP POST Request has been Sent ...");
-    	} else {
-    		Serial.println(statusMsg);
-        }
-    #endif
-    
-    if (this->error) return -1;
-       
-    // ------------------------------------------------------------------------------ Buffer the  Response
-    this->bufferIndex = 0;
-    this->startMillis = millis();
-    this->lastReadMillis = millis();
+// ----------------------------------------------------------- poll()
+/*  Advances the HTTP transaction by one step and returns the resulting state.
+        HTTP_CONNECTING ... connect to the server (TCPClient::connect() is the only
+                            step that may block, since Device OS performs DNS and
+                            the TCP handshake synchronously)
+        HTTP_SENDING ...... send the POST request
+        HTTP_RECEIVING .... parse whatever the server has sent so far (at most
+                            httpReadChunk bytes per call), until the response is
+                            complete or the server closes the connection
+        HTTP_COMPLETE ..... the response was parsed; statusCode and the JsonFields are valid
+        HTTP_FAILED ....... the transaction failed; statusMsg describes the error
+*/
+uint8_t Http::poll(char* statusMsg, int statusMsgSize) {
+    switch (this->state) {
+        case HTTP_CONNECTING:
+            TZ_METRIC(this->startMillis = millis());
+            client.connect(this->hostName, this->hostPort);
+            TZ_METRIC(if (this->metrics != NULL) this->metrics->connectMillis = millis() - this->startMillis);
+            if (client.connected()) {
+                this->open = true;
+                this->state = HTTP_SENDING;
+            } else {
+                this->error = true;
+                this->errorCode = TZ_E_CONNECT;
+                strncpy(statusMsg, "(E621) Unable to connect to ", statusMsgSize);
+                strncat(statusMsg, this->hostName, statusMsgSize);
+                client.stop();
+                this->state = HTTP_FAILED;
+                TZ_METRIC(if (this->metrics != NULL) this->metrics->transactions++);
+            }
+            TZ_LOG_HTTP(TZ_LEVEL_DEBUG, "%s:%d%s", this->hostName, this->hostPort, this->hostPath);
+            if (this->state == HTTP_SENDING) {
+                TZ_LOG_HTTP(TZ_LEVEL_DEBUG, "Client is Connected to the HTTP server ...");
+            } else {
+                TZ_LOG_HTTP(TZ_LEVEL_WARN, "%s", statusMsg);
+            }
+            break;
 
-    
-    while (client.connected() && !this->error) {
-        while (client.available() && !this->error) {
-                char c = client.read();
-           this->lastReadMillis = millis();
-            if (this->bufferIndex == sizeof(this->buffer)-1) {
-                // buffer overflow
+        case HTTP_SENDING:
+            client.print("POST ");
+            client.print(this->hostPath);
+            client.print(" HTTP/1.1\r\n");
+            client.print("HOST: ");
+            client.println(this->hostName);
+            client.println("Content-Length: 0");
+            if (this->binaryType != NULL) {
+                client.print("Accept: ");
+                client.print(this->binaryType);
+                client.println(", application/json;q=0.5");
+            } else {
+                client.println("Accept: application/json");
+            }
+            if (this->validator[0] != '\0') {
+                // an ETag is quoted (or weak: W/"..."), Last-Modified is an HTTP date
+                client.print(((this->validator[0] == '"') || (this->validator[0] == 'W')) ? "If-None-Match: " : "If-Modified-Since: ");
+                client.println(this->validator);
+            }
+            client.println();
+            client.flush();
+            this->startMillis = millis();
+            this->lastReadMillis = millis();
+            this->state = HTTP_RECEIVING;
+            TZ_LOG_HTTP(TZ_LEVEL_DEBUG, this->reused ? "HTTP POST Request has been Sent (connection reused) ..." : "HTTP POST Request has been Sent ...");
+            break;
+
+        case HTTP_RECEIVING:
+            // ------------------------------------------------------------------ Parse the Response
+            TZ_METRIC(
+                unsigned long parseStart = micros();
+                if ((this->metrics != NULL) && (this->parser.state == HP_STATUS) && (this->parser.lineLength == 0) && client.available()) {
+                    this->metrics->firstByteMillis = millis() - this->startMillis;
+                }
+            )
+            {
+                unsigned int i = 0;
+                for (; (i < httpReadChunk) && client.available() && !this->parser.done() && !this->parser.failed(); i++) {
+                    this->parser.feed((char)client.read());
+                    this->lastReadMillis = millis();
+                }
+                TZ_METRIC(
+                    if (this->metrics != NULL) {
+                        this->metrics->bytesReceived += i;
+                        this->metrics->parseMicros += micros() - parseStart;
+                    }
+                )
+            }
+            if ( !this->parser.done() && !this->parser.failed()) {
+                if (client.connected() || client.available()) {
+                    if ((millis() - this->lastReadMillis) > httpTimeout) {
+                        // timeout after 5 seconds of inactivity
+                        this->error = true;
+                        this->errorCode = TZ_E_TIMEOUT;
+                        strncpy(statusMsg, "(E668) Timeout waiting for server to respond", statusMsgSize);
+                    } else {
+                        break;  // <-- more of the response may follow on the next call
+                    }
+                } else if (this->reused && (this->parser.state == HP_STATUS) && (this->parser.lineLength == 0)) {
+                    // the server closed the reused connection before responding ... retry on a new connection
+                    client.stop();
+                    this->open = false;
+                    this->reused = false;
+                    this->state = HTTP_CONNECTING;
+                    break;
+                } else {
+                    this->parser.finish();  // <-- the server closed the connection
+                }
+            }
+            if ( !this->error && this->parser.failed()) {
                 this->error = true;
-                strncpy(statusMsg, "(E653) Response Buffer Overflow", statusMsgSize);
+                this->errorCode = TZ_E_MALFORMED;
+                strncpy(statusMsg, "(E653) Malformed or incomplete HTTP response", statusMsgSize);
+            }
+            // keep the connection open only when the response ended exactly at its framed length
+            if ( !this->error && this->parser.done() && this->parser.keepAlive && !client.available() && client.connected()) {
+                this->idleMillis = millis();
             } else {
-                this->buffer[this->bufferIndex] = c;
-                this->bufferIndex++;
+                client.stop();
+                this->open = false;
             }
-        }
-        buffer[bufferIndex] = '\0';
-        if ((millis() - lastReadMillis) > 5000) {
-            // timeout after 5 seconds of inactivity
-            this->error = true;
-            strncpy(statusMsg, "(E668) Timeout waiting for server to respond", statusMsgSize);
- 
-        } else if ( !this->error) {
-            delay(200);
-        }
+            TZ_LOG_HTTP(TZ_LEVEL_INFO, "Response Time (ms): %lu", (unsigned long)(millis() - startMillis));
+            if (this->error) TZ_LOG_HTTP(TZ_LEVEL_WARN, "%s", statusMsg);
+            if (this->error) {
+                this->state = HTTP_FAILED;
+            } else {
+                this->state = complete(statusMsg, statusMsgSize) ? HTTP_COMPLETE : HTTP_FAILED;
+            }
+            TZ_METRIC(
+                if (this->metrics != NULL) {
+                    this->metrics->responseMillis = millis() - this->startMillis;
+                    this->metrics->httpStatus = this->parser.statusCode;
+                    this->metrics->transactions++;
+                }
+            )
+            break;
+    }
+    return this->state;
+}
+
+// ----------------------------------------------------------- getJson()
+// Performs a complete (blocking) HTTP transaction, decoding the response's JSON into 'fields'
+int Http::getJson(char* hostName, int hostPort, char* hostPath, JsonField* fields, int fieldCount, char* statusMsg, int statusMsgSize) {
+    uint8_t httpState;
+    begin(hostName, hostPort, hostPath, fields, fieldCount);
+    while (((httpState = poll(statusMsg, statusMsgSize)) != HTTP_COMPLETE) && (httpState != HTTP_FAILED)) {
+        if (httpState == HTTP_RECEIVING) delay(1);
     }
-    client.stop();
+    stop();
+    if (httpState == HTTP_FAILED) return -1;
+    return this->statusCode;
+}
 
-    #ifdef LOGGING
-        Serial.printf("\r\nHttp>\tResponse Time (ms): %d\r\n", (millis() - startMillis));
-        Serial.println("---------------------------------------------------- Start of HTTP Response");
-        Serial.println(this->buffer);
-        Serial.println("---------------------------------------------------- End of HTTP Response");
-        if(this->error) {
-            Serial.println(statusMsg);
-        } else {
-            Serial.println("\r\nHttp>\tHTTP client processing terminated normally ...");
+// ----------------------------------------------------------- complete()
+// Checks the parsed HTTP response. Returns false if the response is unusable.
+bool Http::complete(char* statusMsg, int statusMsgSize) {
+    this->statusCode = this->parser.statusCode;
+    if ((this->statusCode == 200) && this->parser.binary) {
+        if (this->parser.binLength == 0) {
+            this->error = true;
+            this->errorCode = TZ_E_NO_JSON;
+            strncpy(statusMsg, "(E677) binary body not found in response", statusMsgSize);
+        } else if (this->parser.binLength > tzBinarySize) {
+            this->error = true;
+            this->errorCode = TZ_E_JSON_TRUNCATED;
+            strncpy(statusMsg, "(E679) binary body truncated in response", statusMsgSize);
         }
-    #endif
-	if (error) return -1;
-	
-    // parse the HTTP status code
-    char* cp;
-    char httpMsg[65] = "";
-    // parse HTTP status code
-    cp = strchr(this->buffer, ' ');
-    if (cp != NULL) {
-        uint ui;
-        this->statusCode = atoi(cp+1);
-        // parse HTTP status message
-        cp = cp + 5;
-        for(ui = 0; ui < sizeof(httpMsg); ui++, cp++) {
-            if (*cp == '\n') {
-                httpMsg[ui] = '\0'; 
-                break;
-            }
-            httpMsg[ui] = *cp;
+    } else if (this->statusCode == 200) {
+        if ( !this->json.started) {
+            this->error = true;
+            this->errorCode = TZ_E_NO_JSON;
+            strncpy(statusMsg, "(E677) JSON not found in response", statusMsgSize);
+        } else if (this->json.depth > 0) {
+            this->error = true;
+            this->errorCode = TZ_E_JSON_TRUNCATED;
+            strncpy(statusMsg, "(E679) JSON truncated in response", statusMsgSize);
         }
-        httpMsg[sizeof(httpMsg) -1] = '\0';
-    } else {
-        this->statusCode = 0;
-    }
-    if (this->statusCode == 200) {
-        
-        // Find where the JSON starts
-        cp = strstr(this->buffer, "{\"");
-	    if (cp == NULL) {
-	        this->error = true;
-	        strncpy(statusMsg, "(E677) JSON not found in buffer", statusMsgSize);
-	    } else {
-	        //find where the JSON ends
-	        this->cpJson = cp;
-	        char* lcp = strrchr(this->buffer, '}');
-	        if ((lcp == NULL) || (cp > lcp) || ((lcp - this->buffer) <= (int)(sizeof(this->buffer - 2)))) {
-	        this->error = true;
-	        strncpy(statusMsg, "(E679) JSON truncated in buffer", statusMsgSize);
-	        }
-	        lcp++;
-	        memset(lcp,'\0',1);
-	        // return a pointer to the JSON string within the HTTP buffer, along with the string's size
-	        jsonStr = cp;
-	        jsonSize = (lcp - cp);
-	    }
     }
-    #ifdef LOGGING
-        Serial.printf("Http>\tHTTP Status Code: %s\r\n", String(this->statusCode));
-        Serial.printf("Http>\tHTTP Message: %s\r\n", httpMsg); 
-        Serial.print("Http>\tJSON: ");
-        if (jsonStr == NULL) Serial.println("NULL"); else Serial.println(String(jsonStr));
-        if (this->error) Serial.printf("Http>\tStatusMsg: %s\r\n", statusMsg);
-     #endif
+    TZ_LOG_HTTP(TZ_LEVEL_DEBUG, "HTTP %d %s, JSON fields found: %d", this->statusCode, this->parser.reason, this->json.found());
 
 	if (this->error) {
-	    return -1;
+	    return false;
 	} else if (this->statusCode == 200) {
         strncpy(statusMsg, "HTTP Processing Completed Normally", statusMsgSize);
 	} else { 
         strncpy(statusMsg, "(H", statusMsgSize);
         strncat(statusMsg, String(this->statusCode), statusMsgSize);
         strncat(statusMsg, ") ", statusMsgSize);
-        strncat(statusMsg, httpMsg, statusMsgSize);
+        strncat(statusMsg, this->parser.reason, statusMsgSize);
     }
-    #ifdef LOGGING
-        Serial.printf("Http>\tStatusMsg: %s\r\n", statusMsg);
-    #endif
-    return this->statusCode;
+    TZ_LOG_HTTP((this->statusCode == 200) ? TZ_LEVEL_DEBUG : TZ_LEVEL_WARN, "%s", statusMsg);
+    return true;
 }
-
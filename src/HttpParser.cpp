@@ -0,0 +1,249 @@
+#include "TzCfg.h"
+
+/*      Library: TzCfg
+        Module: HttpParser.cpp contains an incremental HTTP/1.x response parser.
+
+        Response bytes are fed to the parser as they arrive from the server.
+        The parser consumes the status line and headers, frames the body
+        (Content-Length, chunked, or read-until-close), and notes whether the
+        server will keep the connection open for another request, keeps
+        the response's validator (ETag or Last-Modified) for conditional requests
+        and any Retry-After the server asks for, and feeds each body
+        byte straight to a Json tokenizer. Nothing is buffered beyond a
+        single (truncated) header line, so responses of any size can be
+        processed with a few dozen bytes of parser state (a validator too
+        long for the line is dropped, not kept truncated). The exception is
+        a compact binary body (Content-Type binaryType), which is kept in
+        bin[] (tzBinarySize bytes) for TzCfg::parseBinary().
+
+        The parser does not depend upon TCPClient, so it can be driven by
+        canned byte streams split at arbitrary boundaries.
+*/
+
+// ---------------------------- Class Constructor ---------------------------------
+
+HttpParser::HttpParser(void) {
+    begin(NULL);
+}
+
+// ------------------------------------------------------------------ begin()
+// Prepares the parser for a new response. Body bytes are fed to 'json' (which may be NULL), or
+// kept in bin[] when the response's Content-Type is 'binaryType'
+void HttpParser::begin(Json* json, const char* binaryType) {
+    this->json = json;
+    this->binaryType = binaryType;
+    this->binary = false;
+    this->binLength = 0;
+    this->state = HP_STATUS;
+    this->statusCode = 0;
+    this->reason[0] = '\0';
+    this->lineLength = 0;
+    this->chunked = false;
+    this->lengthKnown = false;
+    this->keepAlive = false;
+    this->validator[0] = '\0';
+    this->retryAfter = 0;
+    this->remaining = 0;
+}
+
+// ------------------------------------------------------------------ feed()
+// Consumes a block of response bytes
+void HttpParser::feed(const char* data, int size) {
+    for (int i = 0; (i < size) && (this->state < HP_DONE); i++) {
+        feed(data[i]);
+    }
+}
+
+// ------------------------------------------------------------------ feed()
+// Consumes the next response byte
+void HttpParser::feed(char c) {
+    switch (this->state) {
+        case HP_STATUS:
+        case HP_HEADER:
+        case HP_TRAILER:
+            if (c == '\r') return;
+            if (c != '\n') {
+                if (this->lineLength < (int)sizeof(this->line) - 1) this->line[this->lineLength] = c;
+                this->lineLength++;
+                return;
+            }
+            this->line[(this->lineLength < (int)sizeof(this->line)) ? this->lineLength : sizeof(this->line) - 1] = '\0';
+            endLine();
+            this->lineLength = 0;
+            return;
+
+        case HP_BODY:
+            body(c);
+            if (this->lengthKnown && (--this->remaining == 0)) this->state = HP_DONE;
+            return;
+
+        case HP_CHUNK_SIZE:
+            // chunk-size [; extensions] CRLF ... a line without a chunk-size is malformed (not the last chunk)
+            if ((c == '\n') || (c == ';')) {
+                if (this->lineLength == 0) {
+                    this->state = HP_ERROR;
+                } else if (c == ';') {
+                    this->lineLength = -1;  // <-- ignore chunk extensions
+                } else {
+                    this->state = (this->remaining == 0) ? HP_TRAILER : HP_CHUNK_DATA;
+                    this->lineLength = 0;
+                }
+            } else if ((this->lineLength >= 0) && (c != '\r')) {
+                int h = hexValue(c);
+                if ((h < 0) || (++this->lineLength > httpChunkDigits)) {
+                    this->state = HP_ERROR;
+                } else {
+                    this->remaining = (this->remaining << 4) | h;
+                }
+            }
+            return;
+
+        case HP_CHUNK_DATA:
+            body(c);
+            if (--this->remaining == 0) this->state = HP_CHUNK_END;
+            return;
+
+        case HP_CHUNK_END:
+            // the CRLF that follows chunk data
+            if (c == '\n') {
+                this->state = HP_CHUNK_SIZE;
+                this->remaining = 0;
+                this->lineLength = 0;
+            } else if (c != '\r') {
+                this->state = HP_ERROR;
+            }
+            return;
+    }
+}
+
+// ------------------------------------------------------------------ finish()
+// Called when the server closes the connection. A body without framing ends here.
+void HttpParser::finish(void) {
+    if ((this->state == HP_BODY) && !this->lengthKnown) {
+        this->state = HP_DONE;
+    } else if (this->state != HP_DONE) {
+        this->state = HP_ERROR;
+    }
+}
+
+// ------------------------------------------------------------------ done()
+bool HttpParser::done(void) {
+    return (this->state == HP_DONE);
+}
+
+// ------------------------------------------------------------------ failed()
+bool HttpParser::failed(void) {
+    return (this->state == HP_ERROR);
+}
+
+// -----------------------------  Private Methods --------------------------------
+
+// ------------------------------------------------------------------ endLine()
+// Processes a complete status, header or trailer line
+void HttpParser::endLine(void) {
+    switch (this->state) {
+        case HP_STATUS:
+            // HTTP/1.x nnn Reason Phrase
+            if (strncmp(this->line, "HTTP/1.", 7) != 0) {
+                this->state = HP_ERROR;
+                return;
+            }
+            this->keepAlive = (this->line[7] != '0');   // <-- HTTP/1.1 connections persist by default
+            {
+                char* cp = strchr(this->line, ' ');
+                if (cp == NULL) {
+                    this->state = HP_ERROR;
+                    return;
+                }
+                this->statusCode = atoi(cp + 1);
+                cp = strchr(cp + 1, ' ');
+                if (cp != NULL) {
+                    strncpy(this->reason, cp + 1, sizeof(this->reason));
+                    this->reason[sizeof(this->reason) - 1] = '\0';
+                }
+            }
+            this->state = HP_HEADER;
+            return;
+
+        case HP_HEADER:
+            if (this->lineLength == 0) {
+                // end of headers
+                if (this->chunked) {
+                    this->state = HP_CHUNK_SIZE;
+                    this->remaining = 0;
+                } else if ((this->lengthKnown && (this->remaining == 0)) || (this->statusCode == 204) || (this->statusCode == 304)) {
+                    this->state = HP_DONE;
+                } else {
+                    this->state = HP_BODY;
+                    if ( !this->lengthKnown) this->keepAlive = false;   // <-- the body ends when the server closes
+                }
+            } else if (headerIs("content-length")) {
+                // digits only ... a negative (or missing) length is malformed
+                char* end;
+                const char* value = headerValue();
+                this->lengthKnown = true;
+                this->remaining = strtol(value, &end, 10);
+                while ((*end == ' ') || (*end == '\t')) end++;
+                if ( !isdigit((unsigned char)value[0]) || (*end != '\0') || (this->remaining < 0)) this->state = HP_ERROR;
+            } else if (headerIs("transfer-encoding")) {
+                this->chunked = (strstr(headerValue(), "chunked") != NULL);
+            } else if (headerIs("etag") || (headerIs("last-modified") && (this->validator[0] == '\0'))) {
+                // an ETag is preferred ... a validator truncated by line[] would never match, so none is kept
+                if (this->lineLength < (int)sizeof(this->line)) {
+                    strncpy(this->validator, headerValue(), sizeof(this->validator));
+                    this->validator[sizeof(this->validator) - 1] = '\0';
+                } else {
+                    this->validator[0] = '\0';
+                }
+            } else if (headerIs("retry-after") || headerIs("x-ttl")) {
+                this->retryAfter = atol(headerValue());    // <-- seconds (an HTTP-date is ignored); X-Ttl is ip-api's rate limit reset
+            } else if (headerIs("content-type")) {
+                this->binary = (this->binaryType != NULL) && (strncmp(headerValue(), this->binaryType, strlen(this->binaryType)) == 0);
+            } else if (headerIs("connection")) {
+                this->keepAlive = (tolower(headerValue()[0]) == 'k');    // <-- "keep-alive" or "close"
+            }
+            return;
+
+        case HP_TRAILER:
+            if (this->lineLength == 0) this->state = HP_DONE;
+            return;
+    }
+}
+
+// ------------------------------------------------------------------ headerIs()
+// Returns true if the current header line has the specified (lower case) name
+bool HttpParser::headerIs(const char* name) {
+    int i = 0;
+    for (; name[i] != '\0'; i++) {
+        if (tolower(this->line[i]) != name[i]) return false;
+    }
+    return (this->line[i] == ':');
+}
+
+// ------------------------------------------------------------------ headerValue()
+// Returns the value of the current header line, without leading white space
+char* HttpParser::headerValue(void) {
+    char* cp = strchr(this->line, ':');
+    if (cp == NULL) return (char*)"";
+    cp++;
+    while ((*cp == ' ') || (*cp == '\t')) cp++;
+    return cp;
+}
+
+// ------------------------------------------------------------------ body()
+void HttpParser::body(char c) {
+    if (this->binary) {
+        if (this->binLength < tzBinarySize) this->bin[this->binLength] = (uint8_t)c;
+        if (this->binLength <= tzBinarySize) this->binLength++;  // <-- tzBinarySize + 1 = truncated
+    } else if (this->json != NULL) {
+        this->json->feed(c);
+    }
+}
+
+// ------------------------------------------------------------------ hexValue()
+int HttpParser::hexValue(char c) {
+    if ((c >= '0') && (c <= '9')) return c - '0';
+    if ((c >= 'a') && (c <= 'f')) return c - 'a' + 10;
+    if ((c >= 'A') && (c <= 'F')) return c - 'A' + 10;
+    return -1;
+}
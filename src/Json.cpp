@@ -5,163 +5,271 @@
 
         Methods are called using the json object. Format: json.method();
 
+        The decoder is a single-pass, zero-allocation tokenizer. The caller
+        supplies a table of JsonFields (name -> typed destination), and one
+        sweep over the JSON fills every field it names. Bytes are consumed
+        one at a time by feed(), so the JSON may be decoded as it arrives.
+
+        Only names in the top level object are matched, and names must match
+        exactly. String escapes (\" \\ \/ \b \f \n \r \t \uXXXX) are decoded.
 */
 
+// JSON tokenizer states
+const uint8_t JS_SCAN = 0, JS_KEY = 1, JS_STRING = 2, JS_SCALAR = 3;
+
 // ---------------------------- Class Constructor ---------------------------------
 
 Json::Json(void) {
+    begin(NULL, 0);
 }
 
-/* -------------------------------------------------------------------------- fix()
-
-    Fix JSON formatting
-        
-        - removes backslashes
-
-*/    
-void Json::fix (char* jsonStr, int jsonSize) {
-    for (int ir = 0, iw = 0; ir < jsonSize; ir++) {
-        if (jsonStr[ir] == '\\') { // delete backslashes
-        } else if (iw == ir) {
-            iw++;
-        } else {
-            jsonStr[iw] = jsonStr[ir];
-            iw++;
-        }
-    }
-    #ifdef LOGGING
-        Serial.printf("Json>\tJSON fixed: %s\r\n", jsonStr);
-    #endif
-    return;
-}
-
+/* -------------------------------------------------------------------------- begin()
 
-// -----------------------------  Decoding Methods --------------------------------
-
-/* ------------------------------------------------------------------ get(float ...)
-
-    Extract a floating point number
+    Prepare to decode a new JSON text
     Arguements:
-        n       Points to the 'float' where the extracted number will be written
-        jsonStr Points to the character array that contains the JSON string
-                from which we extract the value.
-        name    Specifies the JSON name associated with the JSON value.
+        fields      Points to the table of fields to be extracted
+        fieldCount  Specifies the number of fields in the table (max 32)
 */
-
-int Json::get(float& n, char* jsonStr, char* name) {
-    char str[33] = "\"";
-    strncat(str,name,sizeof(str));
-    strncat(str,"\":",sizeof(str));
-    char* pch = strstr(jsonStr,str);
-    if (pch != NULL) { 
-        n = atof(pch+strlen(str));
-        
-        #ifdef LOGGING
-            Serial.printf("json>\tParsed: %s = %.2f\r\n", name, n);
-        #endif
-
-        return EXIT_SUCCESS;
-    } else {
-        return EXIT_FAILURE;
+void Json::begin(JsonField* fields, int fieldCount) {
+    this->fields = fields;
+    this->fieldCount = (fieldCount > 32) ? 32 : fieldCount;
+    for (int i = 0; i < this->fieldCount; i++) {
+        this->fields[i].found = false;
+        this->fields[i].truncated = false;
     }
+    this->state = JS_SCAN;
+    this->depth = 0;
+    this->arrays = 0;
+    this->expectKey = false;
+    this->started = false;
+    this->escape = 0;
+    this->field = NULL;
 }
 
-/* -------------------------------------------------------------------get(time_t ...)
+/* -------------------------------------------------------------------------- parse()
 
-    Extract a time_t time stamp
-    Arguements:
-        n       Points to the 'time_t' where the extracted time stamp will be written
-        jsonStr Points to the character array that contains the JSON string
-                which we extract the value from.
-        name    Specifies the JSON name associated with the JSON value.
+    Decode a complete JSON text in a single pass
+    Returns the number of fields that were found.
 */
-
-int Json::get(time_t& n, char* jsonStr, char* name) {
-    char str[33] = "\"";
-    strncat(str,name,sizeof(str));
-    strncat(str,"\":",sizeof(str));
-    char* pch = strstr(jsonStr,str);
-    if (pch != NULL) { 
-        n = atol(pch+strlen(str));
-        
-        #ifdef LOGGING
-            Serial.printf("json>\tParsed: %s = %d\r\n", name, n);
-        #endif
-
-        
-        return EXIT_SUCCESS;
-    } else {
-        return EXIT_FAILURE;
+int Json::parse(const char* jsonStr, int jsonSize, JsonField* fields, int fieldCount) {
+    begin(fields, fieldCount);
+    for (int i = 0; (i < jsonSize) && (jsonStr[i] != '\0'); i++) {
+        feed(jsonStr[i]);
     }
+    return found();
 }
 
+/* -------------------------------------------------------------------------- found()
 
-/* --------------------------------------------------------------------- get (char* ...)
-
-    Extract a character array
-    Arguements:  
-        ca      Points to a character array where the extracted JSON value 
-                will be written.
-        caSize  Specifies sizeof(ca).
-        jsonStr Points to the character array that contains the JSON string
-                which we extract the value from.
-        name    Specifies the JSON name associated with the JSON value.
-
-*/    
-int Json::get(char* ca, int caSize, char* jsonStr, char* name) {
-    char str[33] = "\"";
-    strncat(str,name,sizeof(str));
-    strncat(str,"\":\"",sizeof(str));
-    char* pch = strstr(jsonStr,str);
-    if (pch != NULL) {
-        char* lch = (char*)memccpy(ca, pch + strlen(str), '\"', caSize);
-        if (lch != NULL) { 
-            // memccpy() copies the value's closing quote. 
-            // We try to locate the closing quote with memchr().
-            lch = (char*)memchr(ca, '\"', caSize);
-            if (lch != NULL) {
-                // The closing quote was located.
-                // We convert the closing quote to a '\0' and exit
-                memset(lch, '\0', 1);
-                
-                    #ifdef LOGGING
-                        Serial.printf("json>\tParsed: %s = %s\r\n", name, ca);
-                     #endif
-
-                 return EXIT_SUCCESS;
-            }
-        }
-        /*  The closing quote was not located, so ...
-                the JSON value was probably too long, but it is 
-                possible that the JSON was somehow corrupted.
-            We change the last character of the array to a '\0'.
-            The value is therefore truncated to the the size of the array.
-            EXIT_FAILURE is returned so the caller can determine if 
-                the value should be used. 
-        */
-        memset(ca + (caSize-1), '\0', 1);
-        
-                    #ifdef LOGGING
-                        Serial.printf("json>\tParsed: %s = %s\r\n", name, ca);
-                    #endif
-
-        return EXIT_FAILURE;
+    Returns the number of fields that have been found so far
+*/
+int Json::found(void) {
+    int n = 0;
+    for (int i = 0; i < this->fieldCount; i++) {
+        if (this->fields[i].found) n++;
     }
+    return n;
 }
 
+/* -------------------------------------------------------------------------- feed()
 
+    Consume the next character of the JSON text
+*/
+void Json::feed(char c) {
+    switch (this->state) {
+        case JS_KEY:
+        case JS_STRING:
+            if (this->escape == 1) {
+                // the character that follows a backslash
+                this->escape = 0;
+                switch (c) {
+                    case 'b': emit('\b'); break;
+                    case 'f': emit('\f'); break;
+                    case 'n': emit('\n'); break;
+                    case 'r': emit('\r'); break;
+                    case 't': emit('\t'); break;
+                    case 'u': this->escape = 2; this->unicode = 0; break;
+                    default:  emit(c);   // <-- \" \\ \/
+                }
+            } else if (this->escape > 1) {
+                // the four hex digits of a \uXXXX escape
+                this->unicode = (this->unicode << 4) | (uint16_t)hexValue(c);
+                if (++this->escape == 6) {
+                    this->escape = 0;
+                    emitUnicode(this->unicode);
+                }
+            } else if (c == '\\') {
+                this->escape = 1;
+            } else if (c == '"') {
+                if (this->state == JS_KEY) {
+                    endKey();
+                } else {
+                    endValue();
+                }
+                this->state = JS_SCAN;
+            } else {
+                emit(c);
+            }
+            return;
 
+        case JS_SCALAR:
+            if ((c == ',') || (c == '}') || (c == ']') || (c == ' ') || (c == '\t') || (c == '\r') || (c == '\n')) {
+                endValue();
+                this->state = JS_SCAN;
+                break;  // <-- the delimiter is processed below
+            }
+            emit(c);
+            return;
+    }
 
+    // JS_SCAN ... between tokens
+    switch (c) {
+        case '{':
+        case '[':
+            if (this->depth < 32) {
+                if (c == '[') this->arrays |= (1UL << this->depth); else this->arrays &= ~(1UL << this->depth);
+            }
+            this->depth++;
+            this->started = true;
+            this->expectKey = (c == '{');
+            this->field = NULL;
+            break;
+        case '}':
+        case ']':
+            if (this->depth > 0) this->depth--;
+            this->expectKey = false;
+            break;
+        case ',':
+            this->expectKey = (this->depth > 0) && (this->depth <= 32) && !(this->arrays & (1UL << (this->depth - 1)));
+            break;
+        case ':':
+            this->expectKey = false;
+            break;
+        case ' ':
+        case '\t':
+        case '\r':
+        case '\n':
+            break;
+        case '"':
+            if (this->expectKey) {
+                beginKey();
+                this->state = JS_KEY;
+            } else {
+                beginValue();
+                this->state = JS_STRING;
+            }
+            break;
+        default:
+            // number, true, false or null
+            beginValue();
+            this->state = JS_SCALAR;
+            emit(c);
+    }
+}
 
+// -----------------------------  Private Methods --------------------------------
+
+// ------------------------------------------------------------------ beginKey()
+// Starts matching a name against the (not yet found) fields of the top level object ... a field
+// without a name ("", a TzProvider field the server does not provide) matches nothing
+void Json::beginKey(void) {
+    this->candidates = 0;
+    this->length = 0;
+    if (this->depth == 1) {
+        for (int i = 0; i < this->fieldCount; i++) {
+            if (( !this->fields[i].found) && (this->fields[i].name[0] != '\0')) this->candidates |= (1UL << i);
+        }
+    }
+    this->field = NULL;
+}
 
+// ------------------------------------------------------------------ endKey()
+// Selects the field whose name matched exactly (if any) to receive the next value
+void Json::endKey(void) {
+    for (int i = 0; (i < this->fieldCount) && this->candidates; i++) {
+        if ((this->candidates & (1UL << i)) && (this->fields[i].name[this->length] == '\0')) {
+            this->field = &this->fields[i];
+            break;
+        }
+    }
+}
 
+// ------------------------------------------------------------------ beginValue()
+void Json::beginValue(void) {
+    this->length = 0;
+    this->truncated = false;
+}
 
+// ------------------------------------------------------------------ endValue()
+// Stores the value in the selected field's destination
+void Json::endValue(void) {
+    JsonField* f = this->field;
+    this->field = NULL;
+    if (f == NULL) return;
+    switch (f->type) {
+        case JSON_STRING:
+            ((char*)f->value)[this->length] = '\0';
+            break;
+        case JSON_FLOAT:
+            this->scalar[this->length] = '\0';
+            *(float*)f->value = atof(this->scalar);
+            break;
+        case JSON_TIME:
+            this->scalar[this->length] = '\0';
+            *(time_t*)f->value = atol(this->scalar);
+            break;
+    }
+    // A truncated value is stored, but is not reported as found
+    f->found = !this->truncated;
+    f->truncated = this->truncated;
 
+    TZ_LOG_HTTP(TZ_LEVEL_DEBUG, "json: %s%s", f->name, this->truncated ? " (truncated)" : "");
+}
 
+// ------------------------------------------------------------------ emit()
+// Appends a decoded character to the name being matched, or to the value being stored. A field stops
+// matching at the end of its name, so a decoded NUL (\u0000) never matches its terminator.
+void Json::emit(char c) {
+    if (this->state == JS_KEY) {
+        for (int i = 0; (i < this->fieldCount) && this->candidates; i++) {
+            if ((this->candidates & (1UL << i)) && ((this->fields[i].name[this->length] == '\0') || (this->fields[i].name[this->length] != c))) {
+                this->candidates &= ~(1UL << i);
+            }
+        }
+        this->length++;
+        return;
+    }
+    if (this->field == NULL) return;
+    int capacity = (this->field->type == JSON_STRING) ? this->field->size : (int)sizeof(this->scalar);
+    if (this->length < capacity - 1) {
+        char* dest = (this->field->type == JSON_STRING) ? (char*)this->field->value : this->scalar;
+        dest[this->length++] = c;
+    } else {
+        this->truncated = true;
+    }
+}
 
+// ------------------------------------------------------------------ emitUnicode()
+// Appends a \uXXXX code point, encoded as UTF-8
+void Json::emitUnicode(uint16_t u) {
+    if (u < 0x80) {
+        emit((char)u);
+    } else if (u < 0x800) {
+        emit((char)(0xC0 | (u >> 6)));
+        emit((char)(0x80 | (u & 0x3F)));
+    } else if ((u >= 0xD800) && (u <= 0xDFFF)) {
+        emit('?');  // <-- surrogate pairs are not supported
+    } else {
+        emit((char)(0xE0 | (u >> 12)));
+        emit((char)(0x80 | ((u >> 6) & 0x3F)));
+        emit((char)(0x80 | (u & 0x3F)));
+    }
+}
 
-
-
-
-
-
+// ------------------------------------------------------------------ hexValue()
+int Json::hexValue(char c) {
+    if ((c >= '0') && (c <= '9')) return c - '0';
+    if ((c >= 'a') && (c <= 'f')) return c - 'a' + 10;
+    if ((c >= 'A') && (c <= 'F')) return c - 'A' + 10;
+    return 0;
+}
@@ -6,53 +6,297 @@
 
 /* ---------------------------------------------------------------------------- begin
     TzCfg's constructor ... MUST BE THE FIRST TzCfg command that is executed on the device
+        sb  The first byte of an EEPROM region reserved for TzCfg (tzEepromSize bytes: the TzDirectory,
+            then the TzJournal ring), so begin() finds the stored settings without scanning EEPROM.
+            -1 (default): no region ... the ring goes to location 0 (or setEepromStartByte()), and
+            is found by a scan. Either way, TzCfg writes no bytes outside the ring & the region.
 */
-void TzCfg::begin() {
+void TzCfg::begin(int sb) {
     this->localIP[0]='\0';
+    this->tzdbValidator[0] = '\0';
+    this->tzdbApiKey[0] = '\0';
+    this->zoneProvider = &tzProviderTimezonedb;
+    this->ipProvider = &tzProviderIpApi;
     this->particleTimeSet = false;
-    // locate the TzBlock in EEPROM ... if found, load it into memory
-    this->eepromStartByte = searchForTzEeprom();
-    if (this->eepromStartByte > -1) {
-        EEPROM.get(this->eepromStartByte,this->tzEeprom);
+    this->refreshStatus = EXIT_SUCCESS;
+    this->refreshCallback = NULL;
+    this->queryWaiting = false;
+    this->lookupBlocking = false;
+    this->zones = NULL;
+    this->lookupZone = -1;
+    this->lastError = TZ_OK;
+    this->eepromRefreshTime = 0;    // <-- scheduled by the first maintainLocalTime() (or lookup)
+    this->eepromStartByte = -1;
+    this->tzEepromExists = false;
+    this->legacyByte = -1;
+    this->legacyLength = 0;
+    this->journal = TzJournal();
+    TZ_METRIC(
+        resetMetrics();
+        this->journal.metrics = &this->metrics;
+        this->http.metrics = &this->metrics;
+    )
+    if ((sb >= 0) && (sb + tzEepromSize <= (int)EEPROM.length())) {
+        this->journal.directoryByte = sb;
+    } else if (sb >= 0) {
+        TZ_LOG_CFG(TZ_LEVEL_ERROR, "EEPROM region %d ... %d out of range", sb, sb + tzEepromSize - 1);
+    }
+    this->refreshFailures = 0;
+    this->rateLimitWait = 0;
+    // FNV-1a hash of the device ID ... the same on every boot, but different for each device in a fleet
+    this->refreshSeed = 2166136261UL;
+    String deviceID = System.deviceID();
+    for (const char* cp = deviceID.c_str(); *cp != '\0'; cp++) {
+        this->refreshSeed = (this->refreshSeed ^ (uint8_t)*cp) * 16777619UL;
+    }
+    // locate the TzJournal in EEPROM ... if found, load its newest TzBlock & TzSchedule into memory
+    if ((this->journal.find() == EXIT_SUCCESS) && this->journal.load(this->tzEeprom, this->schedule)) {
+        this->eepromStartByte = this->journal.base;
         this->tzEepromExists = true;
-    } else {
+    } else if (this->journal.foundViaDirectory) {
+        // the TzDirectory locates an empty (erased) TzJournal ... EEPROM is not scanned
+        this->eepromStartByte = this->journal.base;
         this->tzEepromExists = false;
+    } else {
+        // a TzBlock stored without a TzJournal (legacy layout) is moved into a TzJournal at the same location.
+        // The journal's scan noted it ... unless it stopped at a ring without a valid record.
+        this->eepromStartByte = (this->journal.base < 0) ? this->journal.legacyFound : searchForTzEeprom();
+        if (this->eepromStartByte > -1) {
+            EEPROM.get(this->eepromStartByte,this->tzEeprom);
+            EEPROM.get(this->eepromStartByte + sizeof(TzBlock), this->schedule);
+            this->legacyByte = this->eepromStartByte;
+            this->legacyLength = sizeof(TzBlock);
+            if (this->schedule.valid()) {
+                this->legacyLength += sizeof(TzSchedule);
+            } else {
+                this->schedule = TzSchedule();
+            }
+            this->tzEepromExists = true;
+            if (this->journal.directoryByte >= 0) {
+                this->eepromStartByte = this->journal.directoryByte + sizeof(TzDirectory);     // <-- moved into TzCfg's region
+            } else if (this->eepromStartByte > this->journal.lastBase()) {
+                this->eepromStartByte = this->journal.lastBase();
+            }
+            this->journal.locate(this->eepromStartByte);
+            this->journal.sequence = 1;     // <-- the first record goes to slot 1, so a legacy TzBlock at the same location survives until it is complete
+            writeTzEeprom();
+        } else {
+            this->tzEepromExists = false;
+        }
+    }
+    if (this->tzEepromExists) {
+        if ( !this->schedule.valid()) this->schedule = TzSchedule();
+        if (this->schedule.rule[0] != '\0') this->rule.compile(this->schedule.rule);
     }
-    #ifdef LOGGING
+    #if TZCFG_LOG_LEVEL > TZ_LEVEL_NONE
         Serial.begin();
-        Serial.println("-------------------------------------------------- TzCfg::begin()");
-    	Serial.printf("tzCfg>\tParticle Settings: Time.zone() = %.2f, Time.isDST() = %s, Time.getDSTOffset() = %.2f\r\n", 
-    	    Time.zone(), Time.isDST()? "true":"false", Time.getDSTOffset());
-        Serial.printf("tzCfg>\tEepromStartByte = %d\r\n", this->eepromStartByte);
-        tzEeprom.log((char*)"tzEeprom");
-        Serial.printf("tzCfg>\tSizeof(tzEeprom) = %d\r\n", sizeof(this->tzEeprom));
     #endif
+    TZ_LOG_CFG(TZ_LEVEL_DEBUG, "begin(): Time.zone() = %.2f, Time.isDST() = %s, Time.getDSTOffset() = %.2f",
+        Time.zone(), Time.isDST()? "true":"false", Time.getDSTOffset());
+    TZ_LOG_CFG(TZ_LEVEL_INFO, "EepromStartByte = %d, tzEeprom %s", this->eepromStartByte, this->tzEepromExists ? "found" : "not found");
+    tzEeprom.log((char*)"tzEeprom");
 
 }
 // -------------------------------------------------------------------- setApiKey_timezonedb()
 // Loads the user's timezonedb API-key
 
 void TzCfg::setApiKey_timezonedb(char* apikey) {
-    strncpy(this->tzdbApiKey, apikey, sizeof(this->tzdbApiKey));
+    strncpy(this->tzdbApiKey, apikey, sizeof(this->tzdbApiKey) - 1);
+    this->tzdbApiKey[sizeof(this->tzdbApiKey) - 1] = '\0';
 }
 
 // ---------------------------------------------------------------------------- maintainLocalTime()
 void TzCfg::maintainLocalTime() {
     
-    // Perform a DST transition when the scheduled transition time arrives
+    // Perform a DST transition when the scheduled transition time arrives. 
+    // Transitions that were missed (while the device was off or asleep) are applied in one step.
     if ((this->tzEeprom.tranTime > 0) && !(this->tzEeprom.tranTime > Time.now())) {
-        #ifdef LOGGING
-            Serial.println("----- TzCfg::maintainLocalTime()");
-            Serial.printf("Triggering the Transition @ %s\r\n", (const char *)Time.format(Time.now()));
-            Serial.printf("tzEeprom.tranTime = %s\r\n", tzEeprom.tranTime);
-        #endif
-        transitionNow();
-        this->tzEeprom.tranTime = 0; // precaution to prevent retriggering in an error condition
+        TZ_LOG_CFG(TZ_LEVEL_INFO, "Triggering the Transition @ %s (tzEeprom.tranTime = %ld)", (const char *)Time.format(Time.now()), (long)this->tzEeprom.tranTime);
+        applyTransitions(Time.now());
+    }
+    // After a reset, the stored settings are applied at once ... only the network refresh waits.
+    if (( !this->particleTimeSet) && this->tzEepromExists) updateDeviceSettings();
+    // The first refresh is spread over tzBlockRetryInterval, so a fleet that restarts together
+    // (e.g. after a firmware update) does not query timezonedb together
+    if ((this->eepromRefreshTime == 0) && Time.isValid()) {
+        this->eepromRefreshTime = Time.now() + refreshJitter(tzBlockRetryInterval, 0);
     }
     // Verify or Update the TzBlock in EEPROM when the scheduled refresh time arrives
-    if (Time.now() >= this->eepromRefreshTime) {
-        setLocalTime(BY_ZONEID);
+    if ((this->refreshStatus != TZ_PENDING) && (Time.now() >= this->eepromRefreshTime)) {
+        if ( !zoneLookupReady()) {
+            setEepromRefreshTime();     // <-- no provider access (e.g. a zone set by rule) ... nothing to refresh from
+        } else {
+            if (this->tzEepromExists) strcpy(this->newZoneID, this->tzEeprom.id);
+            TZ_METRIC(if (this->refreshFailures > 0) this->metrics.retries++);
+            startLocalTime(BY_ZONEID);
+        }
+    }
+    // Refresh the TzSet's zones (the device's own zone takes priority)
+    if ((this->zones != NULL) && (this->refreshStatus != TZ_PENDING)) refreshZones();
+    // Advance a pending refresh by one non-blocking step
+    poll();
+}
+
+// ---------------------------------------------------------------------------- resume()
+// Call after the device wakes from sleep (in place of maintainLocalTime()). Applies the transitions that
+// were missed in one step, starts a refresh that fell due, and drops the kept-alive connection, which
+// does not survive sleep.
+void TzCfg::resume(void) {
+    if (this->refreshStatus != TZ_PENDING) this->http.stop();
+    maintainLocalTime();
+}
+
+// ---------------------------------------------------------------------------- nextDeadline()
+// Returns the time when TzCfg next needs maintainLocalTime() (or resume()) to be called: the next
+// transition, the next refresh or retry of the device's zone, or the next refresh of a TzSet zone.
+// While a lookup is in progress, the deadline is now ... keep calling maintainLocalTime() until
+// getRefreshStatus() is no longer TZ_PENDING. A device may sleep until the deadline.
+time_t TzCfg::nextDeadline(void) {
+    time_t now = Time.now();
+    if ((this->refreshStatus == TZ_PENDING) || (this->eepromRefreshTime == 0)) return now;
+    time_t deadline = 0;
+    if (zoneLookupReady()) deadline = this->eepromRefreshTime;   // <-- without a key there is nothing to refresh from
+    if ((this->tzEeprom.tranTime > 0) && ((deadline == 0) || (this->tzEeprom.tranTime < deadline))) deadline = this->tzEeprom.tranTime;
+    for (int i = 0; (this->zones != NULL) && (i < tzSetSize); i++) {
+        if (this->zones->zone[i].used && ((deadline == 0) || (this->zones->zone[i].refreshTime < deadline))) deadline = this->zones->zone[i].refreshTime;
+    }
+    if (deadline == 0) deadline = now + (tzBlockRefreshInterval * 3);  // <-- nothing is scheduled
+    return (deadline < now) ? now : deadline;
+}
+
+// ---------------------------------------------------------------------------- getRefreshFailures()
+// Returns the number of consecutive failed refreshes of the device's zone (0 after a successful refresh)
+uint8_t TzCfg::getRefreshFailures(void) {
+    return this->refreshFailures;
+}
+
+// ---------------------------------------------------------------------------- poll()
+// Advances a pending time zone lookup by one non-blocking step.
+// Returns TZ_PENDING while the lookup is in progress, then the lookup's result (EXIT_SUCCESS or EXIT_FAILURE)
+int TzCfg::poll(void) {
+    if (this->refreshStatus != TZ_PENDING) {
+        this->http.closeIdle();
+        TzLog::flush();     // <-- log output waits until no lookup is in progress
+        return this->refreshStatus;
+    }
+    if (this->queryWaiting) {
+        // respect the timezonedb rate limit between lookup passes
+        if ((millis() - this->queryMillis) < tzdbQueryGap) return TZ_PENDING;
+        this->queryWaiting = false;
+        startQuery();
+        return TZ_PENDING;
+    }
+    uint8_t httpState = this->http.poll(this->statusMsg, sizeof(this->statusMsg));
+    if ((httpState == HTTP_COMPLETE) || (httpState == HTTP_FAILED)) {
+        this->http.state = HTTP_IDLE;
+        if (httpState == HTTP_COMPLETE) {
+            parseQuery();
+        } else {
+            this->queryError = true;
+            this->lastError = this->http.errorCode;
+        }
+        this->queryPass++;
+        if (( !this->queryComplete) && ( !this->queryError) && (this->queryPass < (tzScheduleSize + 3))) {
+            this->queryWaiting = true;
+            if (this->lookupBlocking && (this->queryPass > 2) && (this->lookupZone < 0)) applyLookup();
+        } else {
+            finishLocalTime();
+        }
     }
+    return this->refreshStatus;
+}
+
+// ---------------------------------------------------------------------------- refreshZones()
+// Refreshes the TzSet zones that are due. Every zone with a rule (its own, or one from the built-in
+// zone table) is refreshed on the device in this call; one other zone starts a timezonedb lookup,
+// which poll() advances like the device's own refresh.
+void TzCfg::refreshZones(void) {
+    time_t now = Time.now();
+    bool lookupStarted = false;
+    for (int i = 0; i < tzSetSize; i++) {
+        TzSet* z = this->zones;
+        if ( !z->zone[i].used || (now < z->zone[i].refreshTime)) continue;
+        if (z->zone[i].loaded && !z->zone[i].rule.valid && (z->zone[i].refreshTime == 0)) {
+            z->zone[i].refreshTime = now + refreshJitter(tzBlockRetryInterval, i + 1);  // <-- restored from EEPROM ... spread the first refresh
+            continue;
+        }
+        char ruleStr[sizeof(z->zone[i].sched.rule)];
+        if ( !z->zone[i].rule.valid && (findZoneRule(z->zone[i].blk.id, ruleStr, sizeof(ruleStr)) == EXIT_SUCCESS)) {
+            if (z->zone[i].rule.compile(ruleStr) == EXIT_SUCCESS) strcpy(z->zone[i].sched.rule, ruleStr);
+        }
+        if (z->zone[i].rule.valid) {
+            applyRule(z->zone[i].rule, z->zone[i].blk, z->zone[i].sched, now);
+            z->zone[i].loaded = true;
+            z->zone[i].refreshTime = now + (tzBlockRefreshInterval * 3);
+            z->zone[i].failures = 0;
+            z->save(i);
+        } else if (zoneLookupReady() && !lookupStarted) {
+            strncpy(this->newZoneID, z->zone[i].blk.id, sizeof(this->newZoneID) - 1);
+            TZ_METRIC(if (z->zone[i].failures > 0) this->metrics.retries++);
+            startLocalTime(BY_ZONEID, i);
+            lookupStarted = true;
+        } else if ( !zoneLookupReady()) {
+            z->zone[i].refreshTime = now + tzBlockRetryInterval;    // <-- no source for the zone's settings
+        }
+    }
+}
+
+// ---------------------------------------------------------------------------- finishZone()
+// Stores the result of a TzSet zone lookup ... the device's settings and EEPROM record are not changed
+void TzCfg::finishZone(void) {
+    TzSet* z = this->zones;
+    int i = this->lookupZone;
+    this->lookupZone = -1;
+    bool ok = this->queryComplete && !this->queryError;
+    TZ_METRIC(if (ok) this->metrics.lookups++; else this->metrics.failures++);
+    if ((z != NULL) && z->zone[i].used) {
+        if (ok) {
+            z->zone[i].blk = this->tzWeb;
+            z->zone[i].sched = this->scheduleWeb;
+            z->zone[i].loaded = true;
+            int multiplier = (this->scheduleWeb.count > 0) ? 3 : 1;
+            z->zone[i].refreshTime = Time.now() + (tzBlockRefreshInterval * multiplier) - refreshJitter(tzRefreshSpread * multiplier, i + 1);
+            z->zone[i].failures = 0;
+            z->save(i);
+        } else {
+            if (z->zone[i].failures < 255) z->zone[i].failures++;
+            z->zone[i].refreshTime = Time.now() + retryDelay(z->zone[i].failures);
+        }
+    }
+    TZ_LOG_CFG(ok ? TZ_LEVEL_INFO : TZ_LEVEL_WARN, "TzSet zone %d refresh %s: %s", i, ok ? "complete" : "failed", this->statusMsg);
+    this->refreshStatus = ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+// ---------------------------------------------------------------------------- setTimezoneSet()
+// Has maintainLocalTime() refresh a TzSet's zones (NULL = none)
+void TzCfg::setTimezoneSet(TzSet* zones) {
+    TZ_METRIC(for (int i = 0; (zones != NULL) && (i < tzSetSize); i++) zones->zone[i].journal.metrics = &this->metrics);
+    if ((zones == NULL) && (this->lookupZone >= 0)) {
+        this->http.stop();  // <-- abandon the zone's pending lookup
+        this->lookupZone = -1;
+        this->refreshStatus = EXIT_FAILURE;
+    }
+    this->zones = zones;
+}
+
+// ---------------------------------------------------------------------------- convertBatch()
+// Converts n UTC timestamps (e.g. logged readings) to local time in the device's time zone.
+// 'in' and 'out' may be the same array. Sorted timestamps convert fastest.
+void TzCfg::convertBatch(const time_t* in, time_t* out, size_t n) {
+    TzTimeline timeline(this->tzEeprom, this->schedule, this->rule);
+    timeline.convert(in, out, n);
+}
+
+// ---------------------------------------------------------------------------- getRefreshStatus()
+// Returns TZ_PENDING while a time zone lookup is in progress, else the result of the last lookup
+int TzCfg::getRefreshStatus(void) {
+    return this->refreshStatus;
+}
+
+// ---------------------------------------------------------------------------- setRefreshCallback()
+// Sets a function that is called with the result (EXIT_SUCCESS or EXIT_FAILURE) when a lookup completes
+void TzCfg::setRefreshCallback(void (*callback)(int)) {
+    this->refreshCallback = callback;
 }
 // ----------------------------------------------------------------------------- getLocalIP()
 // Gets the IP address used to obtain time zone information
@@ -85,7 +329,13 @@ time_t TzCfg::getNextRefreshTime() {
 // ------------------------------------------------------------------------ setTimezoneByID()
 // Changes the time zone based on the time zone ID
 int TzCfg::setTimezoneByID(char* id) {
-    strncpy(this->newZoneID, id, sizeof(this->newZoneID));
+    // Zones in the built-in zone table (TZCFG_ZONE_TABLE) are resolved without HTTP
+    char zoneRule[sizeof(this->schedule.rule)];
+    if (findZoneRule(id, zoneRule, sizeof(zoneRule)) == EXIT_SUCCESS) {
+        return setTimezoneByRule(id, zoneRule);
+    }
+    strncpy(this->newZoneID, id, sizeof(this->newZoneID) - 1);
+    this->newZoneID[sizeof(this->newZoneID) - 1] = '\0';
 	int ret = setLocalTime(BY_ZONEID);
 	if (ret == EXIT_SUCCESS) return EXIT_SUCCESS;
 	// assure Particle time is set to tzBlock ... even in an error condition
@@ -99,11 +349,37 @@ int TzCfg::setTimezoneByID(char* id) {
 // ---------------------------------------------------------------------------- setTimezoneByGPS()
 // Sets the time zone based on GPS coordinates
 int TzCfg::setTimezoneByGPS(float lat,float lng) {
+    char zoneID[sizeof(this->newZoneID)];
     this->latitude = lat;
     this->longitude = lng;
+    // A position in a recently resolved cell needs no query ... nothing changes until the device leaves the zone
+    if (this->gpsCache.find(lat, lng, Time.now(), zoneID, sizeof(zoneID)) == EXIT_SUCCESS) {
+        if ((this->tzEepromExists) && (strcmp(zoneID, this->tzEeprom.id) == 0)) {
+            if ( !this->particleTimeSet) {
+                updateDeviceSettings();
+                setEepromRefreshTime();
+            }
+            strcpy(this->statusMsg, "GPS Position Resolved from Cache");
+            return EXIT_SUCCESS;
+        }
+        return setTimezoneByID(zoneID);
+    }
+    // Coordinates covered by the geographic index (TZCFG_GEO_INDEX) are resolved without a position query
+    if (findGeoZone(lat, lng, zoneID, sizeof(zoneID)) == EXIT_SUCCESS) {
+        this->gpsCache.insert(lat, lng, Time.now(), zoneID);
+        return setTimezoneByID(zoneID);
+    }
+    if (this->zoneProvider->positionPath == NULL) {
+        strncpy(this->statusMsg, "(E791) the zone provider does not support lookups by position", sizeof(this->statusMsg));
+        this->lastError = TZ_E_NO_POSITION;
+        return EXIT_FAILURE;
+    }
     this->newZoneID[0] = '\0';
     int ret = setLocalTime(BY_POSITION);
-	if (ret == EXIT_SUCCESS) return EXIT_SUCCESS;
+	if (ret == EXIT_SUCCESS) {
+        this->gpsCache.insert(lat, lng, Time.now(), this->tzEeprom.id);
+        return EXIT_SUCCESS;
+    }
 	// assure Particle time is set to tzBlock ... even in an error condition
     if (( !this->particleTimeSet) && (this->tzEepromExists)) {
         updateDeviceSettings();
@@ -112,65 +388,83 @@ int TzCfg::setTimezoneByGPS(float lat,float lng) {
     return EXIT_FAILURE;
 }
 
+// ---------------------------------------------------------------------------- setGpsCachePrecision()
+// Sets the geohash cell precision (even number of bits, 2 to 32) ... larger cells mean more cache hits,
+// but a position near a zone boundary may then resolve to the neighbouring zone. Clears the cache.
+void TzCfg::setGpsCachePrecision(uint8_t bits) {
+    this->gpsCache.clear(bits);
+    this->gpsCache.save();
+}
+
+// ---------------------------------------------------------------------------- setGpsCacheEepromByte()
+// Persists the GPS cache in EEPROM at location sb (-1 = RAM only) ... the cache may not overlap TzCfg's
+// own storage (its region, the TzJournal ring or a legacy TzBlock)
+void TzCfg::setGpsCacheEepromByte(int sb) {
+    if ((sb >= 0) && (sb > (int)(EEPROM.length() - sizeof(this->gpsCache.data)))) {
+        TZ_LOG_CFG(TZ_LEVEL_WARN, "GPS cache EEPROM location %d out of range", sb);
+        return;
+    }
+    if ((sb >= 0) && overlapsTzEeprom(sb, sizeof(this->gpsCache.data))) {
+        TZ_LOG_CFG(TZ_LEVEL_ERROR, "GPS cache EEPROM %d ... %d rejected: it overlaps the TzJournal", sb, sb + (int)sizeof(this->gpsCache.data) - 1);
+        return;
+    }
+    this->gpsCache.load(sb);
+}
+
+// ---------------------------------------------------------------------------- getGpsCacheHits()
+uint32_t TzCfg::getGpsCacheHits(void) {
+    return this->gpsCache.hits;
+}
+
+// ---------------------------------------------------------------------------- getGpsCacheMisses()
+uint32_t TzCfg::getGpsCacheMisses(void) {
+    return this->gpsCache.misses;
+}
+
+// ---------------------------------------------------------------------------- getEepromBytesWritten()
+// Returns the number of EEPROM bytes TzCfg has written since begin() ... bytes that are unchanged are never rewritten
+uint32_t TzCfg::getEepromBytesWritten(void) {
+    return this->journal.bytesWritten;
+}
+
+// ---------------------------------------------------------------------------- getEepromWriteRanges()
+// Returns the number of runs of consecutive changed bytes TzCfg has written since begin()
+uint32_t TzCfg::getEepromWriteRanges(void) {
+    return this->journal.rangesWritten;
+}
+
 // ---------------------------------------------------------------------------- setTimezoneByIP()
-// Sets the time zone based on the device's IP address
+// Sets the time zone based on the device's IP address. The IP provider's query is the first pass of the
+// lookup, so it runs on the same non-blocking path as setTimezoneByID() (see setLocalTime()).
 int TzCfg::setTimezoneByIP(void) {
-    Http http;
-    Json json;
-    bool error = false;
-    char* jsonStr = NULL;
-    uint jsonSize = 0;
-    char hostName[] = "ip-api.com";
-    char hostPath[] = "/json";
-    char ipapiStatus[16] = "";
-    char ipapiMsg[65] = "";
-    // Perform the HTTP query and update the TzWeb
-    this->statusMsg[0] = '\0';
     this->newZoneID[0] = '\0';
-    int statusCode = http.getJson(hostName, 80, hostPath, jsonStr, jsonSize, statusMsg, sizeof(statusMsg));
-    // note: jsonStr contains the JSON returned from the HTTP server.
-    if ((statusCode == 200) && (jsonStr != NULL)) {
-        json.fix(jsonStr, jsonSize);
-        // handle ip-api JSON with {"status":"fail"} and where status is unknown
-        if (json.get(ipapiStatus, sizeof(ipapiStatus), (char*) jsonStr, (char*) "status") == EXIT_SUCCESS) {
-            if (strcmp(ipapiStatus, "fail") == 0) {
-                error = true;
-                if (json.get(ipapiMsg, sizeof(ipapiMsg), (char*) jsonStr, (char*) "message") == EXIT_SUCCESS) {
-                    strncpy(this->statusMsg, "(ip-api) ", sizeof(this->statusMsg));
-                    strncat(this->statusMsg, ipapiMsg, sizeof(this->statusMsg));
-                } else { 
-                    strncpy(this->statusMsg, "(E735) unable to parse ip-api <message>", sizeof(this->statusMsg));
-                }
-            }
-        } else {
-            strncpy(this->statusMsg, "(E733) unable to parse ip-api status", sizeof(this->statusMsg));
-            error = true;
-        }
-        // parse ip-api JSON for IP address and time zone ID
-        if ( !error) {
-            if (json.get(this->newZoneID, sizeof(this->newZoneID), (char*) jsonStr, (char*) "timezone") == EXIT_SUCCESS) {
-                if (json.get(this->localIP, sizeof(this->localIP),(char*) jsonStr, (char*) "query") == EXIT_SUCCESS) {
-                    #ifdef LOGGING
-                        Serial.printf("TzCfg>\tQuery to ip-api.com returns: IP Address = %s, Timezone ID = %s\r\n",this->localIP, this->newZoneID);
-                    #endif
-                    return setLocalTime(BY_ZONEID);
-                } else {
-                    strncpy(this->statusMsg, "(E742) unable to parse ip-api <ipaddress>", sizeof(this->statusMsg));
-                    error = true;
-                }
-            } else {
-            strncpy(this->statusMsg, "(E743) unable to parse ip-api <timezone>", sizeof(this->statusMsg));
-            error = true;
-            }
-        }
-    }
+    return setLocalTime(BY_IP);
+}
 
-    // assure Particle time is set to tzBlock ... even in an error condition
-    if (( !this->particleTimeSet) && (this->tzEepromExists)) {
-        updateDeviceSettings();
-        setEepromRefreshTime();
+// ---------------------------------------------------------------------------- setTimezoneByRule()
+// Sets the time zone from a POSIX TZ rule (e.g. "CST6CDT,M3.2.0,M11.1.0"). 
+// Every transition is computed on the device, so no HTTP query is required.
+int TzCfg::setTimezoneByRule(char* id, char* ruleStr) {
+    TzRule r;
+    if ((strlen(ruleStr) >= sizeof(this->schedule.rule)) || (r.compile(ruleStr) != EXIT_SUCCESS)) {
+        strncpy(this->statusMsg, "(E781) unable to compile time zone rule", sizeof(this->statusMsg));
+        this->lastError = TZ_E_RULE;
+        return EXIT_FAILURE;
     }
-    return EXIT_FAILURE;
+    this->http.stop();  // <-- abandon a pending lookup (if any)
+    this->lookupZone = -1;
+    this->lastError = TZ_OK;
+    this->rule = r;
+    this->tzWeb = TzBlock();
+    this->scheduleWeb = TzSchedule();
+    strncpy(this->tzWeb.id, id, sizeof(this->tzWeb.id));
+    this->tzWeb.id[sizeof(this->tzWeb.id) - 1] = '\0';
+    strcpy(this->scheduleWeb.rule, ruleStr);
+    applyRule(this->rule, this->tzWeb, this->scheduleWeb, Time.now());
+    this->queryComplete = true;
+    this->queryError = false;
+    strncpy(this->statusMsg, "Time zone set by rule", sizeof(this->statusMsg));
+    return finishLocalTime();
 }
 
 // ---------------------------------------------------------------------------- setEepromStartByte()
@@ -179,61 +473,103 @@ void TzCfg::setEepromStartByte(int sb) {
     if (sb == this->eepromStartByte) {
         return;
     }
-    if ((sb > 0) && !(sb > (int)(EEPROM.length() - sizeof(this->tzEeprom)))){
-        #ifdef LOGGING
-            Serial.println("\n\r----- setEepromStartByte()");
-        #endif
+    if ((sb > 0) && !(sb > this->journal.lastBase())){
+        if ( !this->journal.claimable(sb, this->journal.base, (this->tzEepromExists && (this->legacyByte < 0)) ? this->journal.size() : 0)) {
+            TZ_LOG_CFG(TZ_LEVEL_ERROR, "Attempt to set EepromStartByte rejected: EEPROM %d ... %d holds other data", sb, sb + this->journal.size() - 1);
+            return;
+        }
         if (this->tzEepromExists) {
-            #ifdef LOGGING
-                Serial.printf("tzCfg>\tWriting TzBlock to EEPROM byte %d\r\n", sb);
-            #endif
+            TZ_LOG_CFG(TZ_LEVEL_INFO, "Writing TzBlock to EEPROM byte %d", sb);
             eraseTzEeprom();
-            EEPROM.put(sb,this->tzEeprom);
- 			this->tzEepromExists = true;
+            this->eepromStartByte = sb;
+            writeTzEeprom();
        } else {
-            #ifdef LOGGING
-                Serial.print ("tzCfg>\teepromStartByte has been set to %d\r\n, sb");
-            #endif
+            TZ_LOG_CFG(TZ_LEVEL_INFO, "eepromStartByte has been set to %d", sb);
         }
         this->eepromStartByte = sb;
     } else {
-        #ifdef LOGGING
-            Serial.println("tzCfg>\tERROR: Attempt to set EepromStartByte rejected: byte# not in range");
-        #endif
+        TZ_LOG_CFG(TZ_LEVEL_ERROR, "Attempt to set EepromStartByte rejected: byte# %d not in range", sb);
     }
     return;
 }
 
 // ---------------------------------------------------------------------------- transitionNow()
-// Allows tzCfg users to instantly simulate a transition for testing purposes
+// Performs the pending transition, then makes the next scheduled transition (if any) pending.
+// Also allows tzCfg users to instantly simulate a transition for testing purposes
 void TzCfg::transitionNow(void) {
     if (this->tzEeprom.tranTime > 0) {
-        this->tzEeprom.tranTime = 0;
         this->tzEeprom.curOffset = this->tzEeprom.tranOffset;
-        this->tzEeprom.tranOffset = 0;
         strcpy(this->tzEeprom.curAbbr, this->tzEeprom.tranAbbr);
-        this->tzEeprom.tranAbbr[0] = '\0';
-        EEPROM.put(this->eepromStartByte, this->tzEeprom);
+        if (this->schedule.count > 0) {
+            // roll the next scheduled transition forward
+            this->tzEeprom.tranTime = this->schedule.tran[0].time;
+            this->tzEeprom.tranOffset = this->schedule.tran[0].offset;
+            strcpy(this->tzEeprom.tranAbbr, this->schedule.tran[0].abbr);
+            this->schedule.count--;
+            memmove(&this->schedule.tran[0], &this->schedule.tran[1], this->schedule.count * sizeof(this->schedule.tran[0]));
+            if (this->rule.valid) {
+                // the rule keeps the schedule full
+                int n = this->schedule.count;
+                time_t after = (n > 0) ? this->schedule.tran[n - 1].time : this->tzEeprom.tranTime;
+                this->schedule.tran[n].time = this->rule.next(after, this->schedule.tran[n].offset, this->schedule.tran[n].abbr);
+                if (this->schedule.tran[n].time > 0) this->schedule.count++;
+            }
+        } else {
+            this->tzEeprom.tranTime = 0;
+            this->tzEeprom.tranOffset = 0;
+            this->tzEeprom.tranAbbr[0] = '\0';
+        }
+        writeTzEeprom();
         updateDeviceSettings();
-        #ifdef LOGGING
-            Serial.println("----- TzCfg::transitionNow()");
-            Serial.println(Time.format(Time.now()));
-            Serial.printf("EepromStartByte = %d\r\n", this->eepromStartByte);
-            this->tzEeprom.log((char*)"tzEeprom");
-        #endif
+        TZ_LOG_CFG(TZ_LEVEL_INFO, "transitionNow() @ %s", (const char *)Time.format(Time.now()));
+        this->tzEeprom.log((char*)"tzEeprom");
     }
     return;
 }
 
+// ---------------------------------------------------------------------------- applyTransitions()
+// Applies every transition that is due at 'now' in one step ... a single EEPROM write and settings
+// update however many transitions were missed. A zone with a rule is recomputed from the rule at 'now';
+// otherwise the last due transition from the TzSchedule sets the current settings, and the
+// transitions after it remain scheduled.
+void TzCfg::applyTransitions(time_t now) {
+    if ((this->tzEeprom.tranTime == 0) || (this->tzEeprom.tranTime > now)) return;
+    if (this->rule.valid) {
+        applyRule(this->rule, this->tzEeprom, this->schedule, now);
+    } else {
+        int n = 0;  // <-- scheduled transitions that are also due
+        while ((n < this->schedule.count) && (this->schedule.tran[n].time <= now)) n++;
+        if (n == 0) {
+            this->tzEeprom.curOffset = this->tzEeprom.tranOffset;
+            strcpy(this->tzEeprom.curAbbr, this->tzEeprom.tranAbbr);
+        } else {
+            this->tzEeprom.curOffset = this->schedule.tran[n - 1].offset;
+            strcpy(this->tzEeprom.curAbbr, this->schedule.tran[n - 1].abbr);
+        }
+        if (n < this->schedule.count) {
+            // roll the first transition that is not due forward
+            this->tzEeprom.tranTime = this->schedule.tran[n].time;
+            this->tzEeprom.tranOffset = this->schedule.tran[n].offset;
+            strcpy(this->tzEeprom.tranAbbr, this->schedule.tran[n].abbr);
+            this->schedule.count -= (n + 1);
+            memmove(&this->schedule.tran[0], &this->schedule.tran[n + 1], this->schedule.count * sizeof(this->schedule.tran[0]));
+        } else {
+            this->tzEeprom.tranTime = 0;
+            this->tzEeprom.tranOffset = 0;
+            this->tzEeprom.tranAbbr[0] = '\0';
+            this->schedule.count = 0;
+        }
+    }
+    writeTzEeprom();
+    updateDeviceSettings();
+}
+
 // ---------------------------------------------------------------------------- setNextTransitionTime()
 // Allows tzCfg users to simulate a transition at a future time for testing purposes
 // For example: "tzCfg.setNextTransitionTime(Time.now() + 30);", for 30 seconds from now
 int TzCfg::setNextTransitionTime(time_t time) {
     this->tzEeprom.tranTime = time;
-    #ifdef LOGGING
-        Serial.println("----- TzCfg::setNextTransitionTime()");
-        Serial.printf("NextTransitionTime = %s", (const char *)Time.format(this->tzEeprom.tranTime));
-    #endif
+    TZ_LOG_CFG(TZ_LEVEL_INFO, "NextTransitionTime = %s", (const char *)Time.format(this->tzEeprom.tranTime));
     return 0;
 }
 
@@ -242,26 +578,24 @@ int TzCfg::setNextTransitionTime(time_t time) {
 // For example: "tzCfg.setNextRefreshTime(Time.now() + 30);", for 30 seconds from now
 int TzCfg::setNextRefreshTime(time_t time) {
     this->eepromRefreshTime = time;
-    #ifdef LOGGING
-        Serial.println("----- TzCfg::setNextRefreshTime()");
-        Serial.printf("NextRefreshTime = %s", (const char *)Time.format(this->eepromRefreshTime)));
-    #endif
+    TZ_LOG_CFG(TZ_LEVEL_INFO, "NextRefreshTime = %s", (const char *)Time.format(this->eepromRefreshTime));
     return 0;
 }
  
 // ---------------------------------------------------------------------------- eraseTzEeprom()
-// Erases the TzBlock from EEPROM memory
+// Erases the TzJournal (every stored TzBlock) from EEPROM memory
 // Allows tzCfg users to simulate how tzCfg will perform on a new device. 
 void TzCfg::eraseTzEeprom(void) {
-    TzBlock tzBlk;
-    char signature[sizeof(TZ_SIGNATURE)];
-    EEPROM.get(this->eepromStartByte, signature);
-    if (strcmp(signature, TZ_SIGNATURE) == 0) {
-        memset(&tzBlk, 0xFF, sizeof(tzBlk));
-        EEPROM.put(this->eepromStartByte, tzBlk);
-        #ifdef LOGGING
-            Serial.printf("tzCfg>\tErased TzBlock @ EEPROM location %d\r\n ", eepromStartByte);
-        #endif
+    if (this->tzEepromExists) {
+        if (this->legacyByte >= 0) {
+            // a legacy TzBlock that was never moved into a TzJournal (its location was in use)
+            uint8_t erased = 0xFF;
+            for (int i = this->legacyByte; i < this->legacyByte + this->legacyLength; i++) this->journal.update(i, &erased, 1);
+            this->legacyByte = -1;
+        } else {
+            this->journal.erase();
+        }
+        TZ_LOG_CFG(TZ_LEVEL_INFO, "Erased TzJournal @ EEPROM location %d", eepromStartByte);
         this->tzEepromExists = false;
     }
 }
@@ -271,6 +605,26 @@ char* TzCfg::getHttpStatus(void) {
     return (char*)this->statusMsg;
 }
 
+// ---------------------------------------------------------------------------- getLastError()
+// Returns the result of the last lookup as an error code (TZ_OK = success) ... getHttpStatus() describes it
+TzError TzCfg::getLastError(void) {
+    return this->lastError;
+}
+
+#ifndef TZCFG_NO_METRICS
+// ---------------------------------------------------------------------------- getMetrics()
+// Returns the counters & timers (see TzMetrics)
+const TzMetrics& TzCfg::getMetrics(void) {
+    this->metrics.lastError = this->lastError;
+    return this->metrics;
+}
+
+// ---------------------------------------------------------------------------- resetMetrics()
+void TzCfg::resetMetrics(void) {
+    memset(&this->metrics, 0, sizeof(this->metrics));
+}
+#endif
+
 
 
 // ______________________________________________________________________________________________
@@ -278,166 +632,464 @@ char* TzCfg::getHttpStatus(void) {
 //                    P R I V A T E    M E T H O D S    B E L O W
 
 
-// ---------------------------------------------------------------------------- setLocalTime(char* id)
+// ---------------------------------------------------------------------------- setLocalTime()
+// Performs a blocking time zone lookup. The call returns once the current settings and the next
+// transition are known (two queries) ... the transitions after it (tzScheduleSize more queries,
+// tzdbQueryGap apart) are fetched in the background by maintainLocalTime() / poll(), while
+// getRefreshStatus() returns TZ_PENDING.
 int TzCfg::setLocalTime(uint8_t lookupBy) {
+    if (this->refreshStatus == TZ_PENDING) this->http.stop();  // <-- abandon a pending lookup (e.g. a schedule still being fetched)
+    startLocalTime(lookupBy);
+    this->lookupBlocking = true;
+    while ((poll() == TZ_PENDING) && this->lookupBlocking) {
+        delay(1);
+    }
+    this->lookupBlocking = false;
+    TzLog::flush();
+    return (this->refreshStatus == TZ_PENDING) ? EXIT_SUCCESS : this->refreshStatus;
+}
+
+// ---------------------------------------------------------------------------- applyLookup()
+// Stores & applies the settings of a blocking lookup whose first two passes have succeeded, so
+// setLocalTime() can return. finishLocalTime() stores them again with the complete TzSchedule
+// (or, if a later pass fails, retries the refresh ... the settings stored here remain valid).
+void TzCfg::applyLookup(void) {
+    this->lookupBlocking = false;
+    this->tzEeprom = this->tzWeb;
+    this->schedule = this->scheduleWeb;
+    if (this->schedule.count > 0) this->schedule.count--;  // <-- the last entry's offset arrives with the next pass
+    this->rule = TzRule();
+    writeTzEeprom();
+    updateDeviceSettings();
+    setEepromRefreshTime();
+    TZ_LOG_CFG(TZ_LEVEL_INFO, "Time zone set: %s ... fetching the TzSchedule in the background", this->tzEeprom.id);
+}
+
+// ---------------------------------------------------------------------------- startLocalTime()
+// Starts a time zone lookup. The lookup is advanced one non-blocking step at a time by poll().
+void TzCfg::startLocalTime(uint8_t lookupBy, int zone) {
    // Prepare to query server for timezone information ... 
-    TzBlock tzWeb;
-        #ifdef LOGGING
-            Serial.println("\n\r-------------------------------------------------- TzCfg::setLocalTime()");
-            Serial.printf("tzCfg>\teepromStartByte = %d\r\n",this->eepromStartByte);
-            Serial.println(this->tzEepromExists? "tzCfg>\tzEepromExists = true":"tzCfg>\tzEepromExists = false");
-            Serial.printf("tzCfg>\ttzEeprom.id = %s\r\n",this->tzEeprom.id);
-            switch (lookupBy) {
-                case BY_ZONEID:     
-                    Serial.printf("tzCfg>\tLOOKUP BY ZONEID: %s\r\n", this->newZoneID);
-                    break;
-                case BY_POSITION:   
-                    Serial.printf("tzCfg>\tLOOKUP BY POSITION --- Lat: %d, Lng: %d\r\n", this->latitude, this->longitude);
-                    break;
-                case BY_IP:
-                    Serial.printf("tzCfg>\tLOOKUP BY IP ADDRESS: %s\r\n", this->localIP);
+    TZ_LOG_CFG(TZ_LEVEL_DEBUG, "startLocalTime(): eepromStartByte = %d, tzEepromExists = %s, tzEeprom.id = %s",
+        this->eepromStartByte, this->tzEepromExists ? "true" : "false", this->tzEeprom.id);
+    switch (lookupBy) {
+        case BY_ZONEID:
+            TZ_LOG_CFG(TZ_LEVEL_INFO, "LOOKUP BY ZONEID: %s", this->newZoneID);
+            break;
+        case BY_POSITION:
+            TZ_LOG_CFG(TZ_LEVEL_INFO, "LOOKUP BY POSITION --- Lat: %.4f, Lng: %.4f", this->latitude, this->longitude);
+            break;
+        case BY_IP:
+            TZ_LOG_CFG(TZ_LEVEL_INFO, "LOOKUP BY IP ADDRESS: %s", this->localIP);
+    }
+    this->tzWeb = TzBlock();
+    this->scheduleWeb = TzSchedule();
+    this->lookupBy = lookupBy;
+    this->queryComplete = false;
+    this->queryError = false;
+    this->queryPass = (lookupBy == BY_IP) ? 0 : 1;     // <-- pass 0 asks the IP provider for the zone ID
+    this->queryWaiting = false;
+    this->refreshStatus = TZ_PENDING;
+    this->lookupZone = zone;
+    this->rateLimitWait = 0;
+    this->lastError = TZ_OK;
+    startQuery();
+}
+
+// ---------------------------------------------------------------------------- startQuery()
+// Starts the HTTP query for the current lookup pass
+void TzCfg::startQuery(void) {
+    const TzProvider* p = this->zoneProvider;
+    char hostPath[193] = "";
+    this->jsonStatus[0] = '\0';
+    this->jsonMessage[0] = '\0';
+    this->jsonGmtOffset = 0;
+    this->statusMsg[0] = '\0';
+    this->queryMillis = millis();
+    if (this->lookupBy == BY_IP) {
+        // the IP provider returns the zone ID (& the device's IP address) ... the zone provider's passes follow
+        p = this->ipProvider;
+        providerPath(p->path, hostPath, sizeof(hostPath));
+        JsonField fields[] = {
+            { p->fields[TZ_FIELD_STATUS],  JSON_STRING, this->jsonStatus,     sizeof(this->jsonStatus) },
+            { p->fields[TZ_FIELD_MESSAGE], JSON_STRING, this->jsonMessage,    sizeof(this->jsonMessage) },
+            { p->fields[TZ_FIELD_ZONE],    JSON_STRING, this->newZoneID,      sizeof(this->newZoneID) },
+            { p->fields[TZ_FIELD_IP],      JSON_STRING, this->localIP,        sizeof(this->localIP) },
+            { p->fields[TZ_FIELD_OFFSET],  JSON_FLOAT,  &this->jsonGmtOffset, 0 }
+        };
+        memcpy(this->jsonFields, fields, sizeof(fields));
+        this->http.begin((char*)p->host, p->port, hostPath, this->jsonFields, 5);
+        return;
+    }
+    providerPath((this->lookupBy == BY_POSITION) ? p->positionPath : p->path, hostPath, sizeof(hostPath));
+    if ((this->queryPass > 1) && (p->timeQuery != NULL)) {
+        providerPath(p->timeQuery, hostPath, sizeof(hostPath));
+    }
+    // The provider's response is decoded into these fields as it arrives.
+    // Fields after the first six are only used by the first pass.
+    JsonField fields[] = {
+        { p->fields[TZ_FIELD_STATUS],    JSON_STRING, this->jsonStatus,       sizeof(this->jsonStatus) },
+        { p->fields[TZ_FIELD_MESSAGE],   JSON_STRING, this->jsonMessage,      sizeof(this->jsonMessage) },
+        { p->fields[TZ_FIELD_OFFSET],    JSON_FLOAT,  &this->jsonGmtOffset,   0 },
+        { p->fields[TZ_FIELD_DST],       JSON_STRING, this->jsonDst,          sizeof(this->jsonDst) },
+        { p->fields[TZ_FIELD_DST_END],   JSON_TIME,   &this->jsonDstEnd,      0 },
+        { p->fields[TZ_FIELD_NEXT_ABBR], JSON_STRING, this->jsonNextAbbr,     sizeof(this->jsonNextAbbr) },
+        { p->fields[TZ_FIELD_ZONE],      JSON_STRING, this->tzWeb.id,         sizeof(this->tzWeb.id) },
+        { p->fields[TZ_FIELD_ABBR],      JSON_STRING, this->tzWeb.curAbbr,    sizeof(this->tzWeb.curAbbr) },
+        { p->fields[TZ_FIELD_SCHEDULE],  JSON_STRING, this->jsonSchedule,     sizeof(this->jsonSchedule) },
+        { p->fields[TZ_FIELD_RULE],      JSON_STRING, this->scheduleWeb.rule, sizeof(this->scheduleWeb.rule) }
+    };
+    memcpy(this->jsonFields, fields, sizeof(this->jsonFields));
+    this->jsonDst[0] = '\0';
+    this->jsonDstEnd = 0;
+    this->jsonNextAbbr[0] = '\0';
+    this->jsonSchedule[0] = '\0';
+    // A refresh of the device's zone is a conditional request ... an unchanged zone may be answered by "304 Not Modified"
+    bool conditional = (this->queryPass == 1) && (this->lookupZone < 0) && (this->lookupBy == BY_ZONEID)
+                        && this->tzEepromExists && (strcmp(this->newZoneID, this->tzEeprom.id) == 0);
+    this->http.begin((char*)p->host, p->port, hostPath, this->jsonFields, (this->queryPass == 1) ? TZ_FIELD_RULE + 1 : 6,
+                     conditional ? this->tzdbValidator : NULL, (this->queryPass == 1) ? p->binaryType : NULL);
+}
+
+// ---------------------------------------------------------------------------- parseQuery()
+// Updates tzWeb from the HTTP server's response to the current lookup pass
+void TzCfg::parseQuery(void) {
+    JsonField* fields = this->jsonFields;
+    const TzProvider* p = this->zoneProvider;
+    if (this->lookupBy == BY_IP) {
+        parseIpQuery();
+        return;
+    }
+    if ((this->http.statusCode == 304) && (this->queryPass == 1) && (this->lookupZone < 0) && this->tzEepromExists) {
+        // the conditional request confirms the stored settings
+        this->tzWeb = this->tzEeprom;
+        this->scheduleWeb = this->schedule;
+        this->queryComplete = true;
+        strncpy(this->statusMsg, "Time Zone Unchanged (HTTP 304)", sizeof(this->statusMsg));
+        return;
+    }
+    if ((this->http.statusCode == 200) && (this->queryPass == 1) && (this->lookupZone < 0)) {
+        strcpy(this->tzdbValidator, this->http.parser.validator);
+    }
+    if ((this->http.statusCode == 200) && this->http.parser.binary) {
+        // a compact binary response carries the whole lookup (see TzProvider.cpp)
+        if (parseBinary(this->http.parser.bin, this->http.parser.binLength) == EXIT_SUCCESS) {
+            this->queryComplete = true;
+        } else {
+            if (this->lastError == TZ_OK) {
+                snprintf(this->statusMsg, sizeof(this->statusMsg), "(E768) unable to decode %s binary response", p->name);
+                this->lastError = TZ_E_BINARY;
             }
-        #endif
-            
-    // Query the HTTP Server
-    bool queryComplete = false;
-    bool queryError = false;
-    int queryPass = 1;
-    while (( !queryComplete) && ( !queryError) && (queryPass < 3)) {
-        Http http;
-        Json json;
-        char hostName[] = "api.timezonedb.com";
-        char hostPath[193] = "";
-        char* jsonStr = NULL;
-        strncpy(hostPath, "/v2/get-time-zone?key=", sizeof(hostPath));
-        strncat(hostPath, this->tzdbApiKey, sizeof(hostPath));
-        strncat(hostPath, "&format=json", sizeof(hostPath));
-        switch (lookupBy) {
-            case BY_ZONEID:
-            case BY_IP:
-                strncat(hostPath, "&by=zone&zone=", sizeof(hostPath));
-                strncat(hostPath, this->newZoneID, sizeof(hostPath));
-                break;
-            case BY_POSITION:
-                strncat(hostPath, "&by=position&lat=", sizeof(hostPath));
-                strncat(hostPath, String(this->latitude), sizeof(hostPath));
-                strncat(hostPath, "&lng=", sizeof(hostPath));
-                strncat(hostPath, String(this->longitude), sizeof(hostPath));
-                break;
-        }
-            
-        if (queryPass == 2) {
-            strncat(hostPath, "&time=", sizeof(hostPath));
-            strncat(hostPath, String(tzWeb.tranTime), sizeof(hostPath));
+            this->queryError = true;
         }
-        // Perform the HTTP query and update the TzWeb
-        this->statusMsg[0] = '\0';
-        jsonStr = NULL;
-        uint jsonSize = 0;
-        int statusCode = http.getJson(hostName, 80, hostPath, jsonStr, jsonSize, this->statusMsg, sizeof(this->statusMsg));
-        if ((statusCode == 200) && (jsonStr != NULL)) { 
-            json.fix(jsonStr, jsonSize);
-            char jsonStatus[7] = "";
-            if (json.get(jsonStatus, sizeof(jsonStatus), (char*)jsonStr, (char*)"status") == EXIT_SUCCESS) {
-                if (strncmp(jsonStatus, "OK", 2) == 0) {
-                    float gmtOffset = 0;
-                    if (json.get(gmtOffset, (char*)jsonStr, (char*)"gmtOffset") == EXIT_SUCCESS) {
-                        gmtOffset = gmtOffset/3600;
-                        char dst[2];
-                        json.get(dst, sizeof(dst), (char*) jsonStr, (char*) "dst");
-                        switch (queryPass) {
-                            case 1:
-                                tzWeb.curOffset = gmtOffset;
-                                json.get(tzWeb.id, sizeof(tzWeb.id), (char*) jsonStr, (char*) "zoneName");
-                                json.get(tzWeb.curAbbr, sizeof(tzWeb.curAbbr), (char*) jsonStr, (char*) "abbreviation");
-                                json.get(tzWeb.tranAbbr, sizeof(tzWeb.tranAbbr), (char*) jsonStr, (char*) "nextAbbreviation");
-                                json.get(tzWeb.tranTime, (char*)jsonStr, (char*)"dstEnd");
-                                if (atoi(dst) == 0) { 
-                                    tzWeb.stdOffset = gmtOffset;
-                                }
-                                if (tzWeb.tranTime > 0) {
-                                    tzWeb.tranTime++;
-                                } else  {
-                                    queryComplete = true;
-                                }
-                                break;
-                            case 2:
-                                tzWeb.tranOffset = gmtOffset;
-                                if (atoi(dst) == 0) tzWeb.stdOffset = gmtOffset;
-                                queryComplete = true;
-                                break;
+        return;
+    }
+    if (this->http.statusCode == 200) { 
+        char* jsonStatus = this->jsonStatus;
+        char* message = this->jsonMessage;
+        char* dst = this->jsonDst;
+        float gmtOffset = this->jsonGmtOffset;
+        if (fields[TZ_FIELD_STATUS].found) {
+            if (strcmp(jsonStatus, p->okStatus) == 0) {
+                if (fields[TZ_FIELD_OFFSET].found) {
+                    gmtOffset = gmtOffset/3600;
+                    if (atoi(dst) == 0) { 
+                        this->tzWeb.stdOffset = gmtOffset;
+                    }
+                    // When the zone's rule is known and agrees with the provider, the rule provides every transition
+                    if ((this->queryPass == 1) && (this->lookupZone < 0) && this->rule.valid && this->tzEepromExists && (strcmp(this->tzWeb.id, this->tzEeprom.id) == 0)) {
+                        char abbr[6];
+                        if ((long)(this->rule.offsetAt(Time.now(), abbr) * 3600) == (long)this->jsonGmtOffset) {
+                            strcpy(this->scheduleWeb.rule, this->schedule.rule);
+                            applyRule(this->rule, this->tzWeb, this->scheduleWeb, Time.now());
+                            this->queryComplete = true;
+                            return;
+                        }
+                        TZ_LOG_CFG(TZ_LEVEL_WARN, "Time zone rule disagrees with %s ... rule discarded", p->name);
+                        this->rule = TzRule();
+                    }
+                    // A provider without a timeQuery answers in one response ... its <rule> or <schedule> provides every transition
+                    if ((this->queryPass == 1) && (p->timeQuery == NULL)) {
+                        TzRule r;
+                        this->tzWeb.curOffset = gmtOffset;
+                        this->queryComplete = true;
+                        if (fields[TZ_FIELD_RULE].truncated || fields[TZ_FIELD_SCHEDULE].truncated) {
+                            // a field that is present but did not fit is an error ... not a zone without transitions
+                            if (fields[TZ_FIELD_RULE].truncated) {
+                                strncpy(this->statusMsg, "(E781) unable to compile time zone rule", sizeof(this->statusMsg));
+                                this->lastError = TZ_E_RULE;
+                            } else {
+                                snprintf(this->statusMsg, sizeof(this->statusMsg), "(E766) unable to parse %s <schedule>", p->name);
+                                this->lastError = TZ_E_SCHEDULE;
+                            }
+                            this->queryError = true;
+                        } else if (fields[TZ_FIELD_RULE].found && (this->scheduleWeb.rule[0] != '\0')) {
+                            if (r.compile(this->scheduleWeb.rule) == EXIT_SUCCESS) {
+                                applyRule(r, this->tzWeb, this->scheduleWeb, Time.now());
+                            } else {
+                                strncpy(this->statusMsg, "(E781) unable to compile time zone rule", sizeof(this->statusMsg));
+                                this->lastError = TZ_E_RULE;
+                                this->queryError = true;
+                            }
+                        } else if (fields[TZ_FIELD_SCHEDULE].found && (parseSchedule(this->jsonSchedule) != EXIT_SUCCESS)) {
+                            snprintf(this->statusMsg, sizeof(this->statusMsg), "(E766) unable to parse %s <schedule>", p->name);
+                            this->lastError = TZ_E_SCHEDULE;
+                            this->queryError = true;
+                        } else if (atoi(dst) != 0) {
+                            this->tzWeb.stdOffset = this->tzWeb.tranOffset;    // <-- the next transition ends DST
                         }
+                        return;
+                    }
+                    /*  Pass 1 returns the current settings and the time of the next transition.
+                        Each following pass queries the time of a transition, which returns
+                        that transition's offset and the time of the transition after it. */
+                    int n = this->queryPass - 2;    // <-- schedule entry that receives dstEnd
+                    if (this->queryPass == 1) {
+                        this->tzWeb.curOffset = gmtOffset;
+                    } else if (this->queryPass == 2) {
+                        this->tzWeb.tranOffset = gmtOffset;
                     } else {
-                        strncpy(this->statusMsg, "(E764) unable to parse timezonedb <gmtOffset>", sizeof(this->statusMsg));
-                        queryError = true;
+                        this->scheduleWeb.tran[n - 1].offset = gmtOffset;
                     }
-                } else {
-                    char message[65] = "";
-                    if (json.get(message, sizeof(message), (char*)jsonStr, (char*)"message") == EXIT_SUCCESS) {
-                        strncpy(this->statusMsg, "(timezonedb) ", sizeof(this->statusMsg));
-                        strncat(this->statusMsg, message, sizeof(this->statusMsg));
+                    if ((this->jsonDstEnd == 0) || (n >= tzScheduleSize)) {
+                        this->queryComplete = true;
+                    } else if (this->queryPass == 1) {
+                        this->tzWeb.tranTime = this->jsonDstEnd + 1;
+                        strcpy(this->tzWeb.tranAbbr, this->jsonNextAbbr);
                     } else {
-                        strncpy(this->statusMsg, "(E757) unable to parse timezonedb <message>", sizeof(this->statusMsg));
+                        this->scheduleWeb.tran[n].time = this->jsonDstEnd + 1;
+                        strcpy(this->scheduleWeb.tran[n].abbr, this->jsonNextAbbr);
+                        this->scheduleWeb.count = n + 1;
                     }
+                    // A first-pass response that matches the stored settings (the zone, current settings and next
+                    // transition ... the fields that do not vary with the time of the query) confirms the stored
+                    // schedule, so the remaining passes are skipped
+                    if ((this->queryPass == 1) && (this->lookupZone < 0) && !this->queryComplete && (this->schedule.count >= (tzScheduleSize / 2))
+                     && (this->schedule.rule[0] == '\0') && this->tzEepromExists && (strcmp(this->tzWeb.id, this->tzEeprom.id) == 0)
+                     && (tzMinutes(this->tzWeb.curOffset) == tzMinutes(this->tzEeprom.curOffset)) && (strcmp(this->tzWeb.curAbbr, this->tzEeprom.curAbbr) == 0)
+                     && (this->tzWeb.tranTime == this->tzEeprom.tranTime) && (strcmp(this->tzWeb.tranAbbr, this->tzEeprom.tranAbbr) == 0)) {
+                        this->tzWeb = this->tzEeprom;
+                        this->scheduleWeb = this->schedule;
+                        this->queryComplete = true;
+                    }
+                } else {
+                    snprintf(this->statusMsg, sizeof(this->statusMsg), "(E764) unable to parse %s <gmtOffset>", p->name);
+                    this->lastError = TZ_E_TZDB_OFFSET;
+                    this->queryError = true;
                 }
             } else {
-                strncpy(this->statusMsg, "(E751) unable to parse timezonedb <status>", sizeof(this->statusMsg));
-                queryError = true;
+                if (fields[TZ_FIELD_MESSAGE].found) {
+                    providerMessage(p, message, strlen(message));
+                    this->lastError = TZ_E_TZDB_FAIL;
+                    if (strstr(message, "limit") != NULL) {
+                        // e.g. "You have exceeded the rate limit ..." ... back off like HTTP 429
+                        this->rateLimitWait = (this->http.parser.retryAfter > 0) ? this->http.parser.retryAfter : tzRateLimitInterval;
+                        this->lastError = TZ_E_RATE_LIMITED;
+                    }
+                } else {
+                    snprintf(this->statusMsg, sizeof(this->statusMsg), "(E757) unable to parse %s <message>", p->name);
+                    this->lastError = TZ_E_TZDB_MESSAGE;
+                }
+                this->queryError = true;
             }
-        } else { 
-            queryError = true;
+        } else {
+            snprintf(this->statusMsg, sizeof(this->statusMsg), "(E751) unable to parse %s <status>", p->name);
+            this->lastError = TZ_E_TZDB_STATUS;
+            this->queryError = true;
         }
-        queryPass++;
-    } // end of while()
-    
-    if (queryComplete && ( !queryError) && (tzEeprom != tzWeb)) {
-        //if the 'tzWeb' TzBlock has new data, update EEPROM
-		if (this->eepromStartByte == -1) { // <-- Occurs if no TzBlock was found in EEPROM, AND no startByte has been designated.
-			this->eepromStartByte = 0;     // <-- Set the startByte to the default location (zero).
-		}
-        EEPROM.put(this->eepromStartByte,tzWeb);
-        this->tzEepromExists = true;
-        EEPROM.get(this->eepromStartByte,this->tzEeprom);
-        #ifdef LOGGING
-            Serial.println("tzCfg>\tTzEeprom Updated ...");
-        #endif
+    } else { 
+        this->lastError = TZ_E_HTTP_STATUS;
+        if (this->http.statusCode == 429) {
+            // Too Many Requests ... wait as long as the server asks
+            this->rateLimitWait = (this->http.parser.retryAfter > 0) ? this->http.parser.retryAfter : tzRateLimitInterval;
+            this->lastError = TZ_E_RATE_LIMITED;
+        }
+        this->queryError = true;
+    }
+}
+
+// ---------------------------------------------------------------------------- parseIpQuery()
+// Processes the IP provider's response (pass 0 of a lookup by IP). The lookup continues by zone ID, or
+// completes at once when the stored settings are still current.
+void TzCfg::parseIpQuery(void) {
+    JsonField* fields = this->jsonFields;
+    const TzProvider* p = this->ipProvider;
+    if (this->http.statusCode != 200) {
+        this->lastError = TZ_E_HTTP_STATUS;
+        if (this->http.statusCode == 429) {
+            this->rateLimitWait = (this->http.parser.retryAfter > 0) ? this->http.parser.retryAfter : tzRateLimitInterval;
+            this->lastError = TZ_E_RATE_LIMITED;
+        }
+        this->queryError = true;
+        return;
+    }
+    // handle a provider status other than success (e.g. ip-api's {"status":"fail"}) and where status is unknown
+    if ( !fields[0].found) {
+        snprintf(this->statusMsg, sizeof(this->statusMsg), "(E733) unable to parse %s status", p->name);
+        this->lastError = TZ_E_IPAPI_STATUS;
+    } else if (strcmp(this->jsonStatus, p->okStatus) != 0) {
+        if (fields[1].found) {
+            providerMessage(p, this->jsonMessage, strlen(this->jsonMessage));
+            this->lastError = TZ_E_IPAPI_FAIL;
+        } else {
+            snprintf(this->statusMsg, sizeof(this->statusMsg), "(E735) unable to parse %s <message>", p->name);
+            this->lastError = TZ_E_IPAPI_MESSAGE;
+        }
+    } else if ( !fields[2].found) {
+        snprintf(this->statusMsg, sizeof(this->statusMsg), "(E743) unable to parse %s <timezone>", p->name);
+        this->lastError = TZ_E_IPAPI_ZONE;
+    } else if ( !fields[3].found) {
+        snprintf(this->statusMsg, sizeof(this->statusMsg), "(E742) unable to parse %s <ipaddress>", p->name);
+        this->lastError = TZ_E_IPAPI_ADDRESS;
+    }
+    if (this->lastError != TZ_OK) {
+        this->queryError = true;
+        return;
+    }
+    TZ_LOG_CFG(TZ_LEVEL_INFO, "Query to %s returns: IP Address = %s, Timezone ID = %s", p->host, this->localIP, this->newZoneID);
+    // The stored tzBlock is still current when the zone and its offset are unchanged, and its next transition
+    // (if the zone has one) is still ahead ... no zone provider query is needed
+    if ((fields[4].found) && (this->tzEepromExists) && ((this->tzEeprom.tranTime == 0) || (Time.now() < this->tzEeprom.tranTime))
+        && (strcmp(this->newZoneID, this->tzEeprom.id) == 0)
+        && ((long)(this->tzEeprom.curOffset * 3600) == (long)this->jsonGmtOffset)) {
+        this->tzWeb = this->tzEeprom;
+        this->scheduleWeb = this->schedule;
+        this->queryComplete = true;
+        snprintf(this->statusMsg, sizeof(this->statusMsg), "Time Zone Unchanged (%s)", p->name);
+        return;
+    }
+    this->lookupBy = BY_ZONEID;
+    this->queryMillis -= tzdbQueryGap;     // <-- tzdbQueryGap separates the zone provider's queries ... pass 1 starts at once
+}
+
+// ---------------------------------------------------------------------------- finishLocalTime()
+// Updates EEPROM & the device's local time settings when a lookup ends, and notifies the refresh callback
+int TzCfg::finishLocalTime(void) {
+    if (this->lookupZone >= 0) {
+        finishZone();
+        return this->refreshStatus;
+    }
+    TzRecord stored, web;   // <-- the packed images are compared, so offsets are compared in whole minutes
+    stored.pack(this->tzEeprom, this->schedule);
+    web.pack(this->tzWeb, this->scheduleWeb);
+    if (this->queryComplete && ( !this->queryError) && ( !this->tzEepromExists || (stored != web))) {
+        //if the 'tzWeb' TzBlock or its schedule has new data, update EEPROM
+        this->tzEeprom = this->tzWeb;
+        this->schedule = this->scheduleWeb;
+        writeTzEeprom();
+        this->rule = TzRule();
+        if (this->schedule.rule[0] != '\0') this->rule.compile(this->schedule.rule);
+        TZ_LOG_CFG(TZ_LEVEL_INFO, "TzEeprom Updated ...");
     } else {
-        #ifdef LOGGING
-            Serial.println("tzCfg>\tTime zone settings unchanged");
-        #endif
+        TZ_LOG_CFG(TZ_LEVEL_INFO, "Time zone settings unchanged");
     }
    
     // update the devices local time settings & schedule the next EEPROM refresh
     updateDeviceSettings();
-    if (queryError) {
-        this->eepromRefreshTime = Time.now() + (tzBlockRetryInterval);
-        return EXIT_FAILURE;
+    if (this->queryError || ( !this->queryComplete)) {
+        this->tzdbValidator[0] = '\0';  // <-- it may belong to another zone's response
+        if (this->refreshFailures < 255) this->refreshFailures++;
+        TZ_METRIC(this->metrics.failures++);
+        this->eepromRefreshTime = batchRefresh(Time.now() + retryDelay(this->refreshFailures));
+        this->refreshStatus = EXIT_FAILURE;
     } else {
+        this->refreshFailures = 0;
+        TZ_METRIC(this->metrics.lookups++);
         setEepromRefreshTime();
-        return EXIT_SUCCESS;
+        this->refreshStatus = EXIT_SUCCESS;
+    }
+    if (this->refreshCallback != NULL) {
+        this->refreshCallback(this->refreshStatus);
     }
+    return this->refreshStatus;
 }
 
 // ------------------------------------------------------------------------ setEepromRefreshTime()
-// Schedule the next EEPROM refresh
+// Schedule the next EEPROM refresh. The refresh is planned from the stored transitions: once in the
+// tzTransitionLead window before each transition (to pick up a late change to the zone's rules before
+// it is applied), and no more than the refresh interval apart otherwise.
 void TzCfg::setEepromRefreshTime() {
     int refresh_multiplier = 1;
     
-    // If the tz has no DST scheduled transitions, we will trebble the refresh Interval
+    // If the tz has no DST scheduled transitions, or the TzSchedule already holds the
+    // transitions that follow the next one, we will trebble the refresh Interval
     if ((this->tzEeprom.tranTime == 0) && (this->tzEeprom.stdOffset == this->tzEeprom.curOffset)) {
         refresh_multiplier = 3;
+    } else if (this->schedule.count > 0) {
+        refresh_multiplier = 3;
+    }
+    // Each device refreshes a little early, by its own share of tzRefreshSpread, so a fleet's refreshes
+    // stay spread out even when the devices were configured at the same time
+    time_t now = Time.now();
+    time_t refresh = now + (tzBlockRefreshInterval * refresh_multiplier) - refreshJitter(tzRefreshSpread * refresh_multiplier, 0);
+    // Find the first transition whose window has not begun (the window of the next transition has begun
+    // when this refresh ran inside it), and the last transition that is known
+    time_t tran = 0, last = 0;
+    for (int i = -1; i < this->schedule.count; i++) {
+        time_t t = (i < 0) ? this->tzEeprom.tranTime : this->schedule.tran[i].time;
+        if (t <= now) continue;
+        last = t;
+        if ((tran == 0) && ((t - tzTransitionLead) > now)) tran = t;
+    }
+    if (tran > 0) {
+        // a window that opens soon after the planned refresh replaces it ... one refresh serves both
+        time_t windowed = tran - tzTransitionLead + refreshJitter(tzTransitionLead - tzRefreshBatch, 0);
+        if (windowed < (refresh + tzBlockRefreshInterval)) refresh = windowed;
+    } else if ((last > 0) && (last < refresh)) {
+        refresh = last;     // <-- the known transitions run out at 'last' ... refresh as it is applied
     }
-    this->eepromRefreshTime = Time.now() + (tzBlockRefreshInterval * refresh_multiplier);
+    this->eepromRefreshTime = batchRefresh(refresh);
+    TZ_LOG_CFG(TZ_LEVEL_INFO, "Next refresh in %ld seconds", (long)(this->eepromRefreshTime - now));
     return;
 }
 
+// ------------------------------------------------------------------------ batchRefresh()
+// Returns the time for a refresh (or retry) planned for 'refresh'. A refresh that falls within
+// tzRefreshBatch of a known transition is moved to the transition, so maintainLocalTime() applies
+// the transition and starts the refresh in the same wake-up.
+time_t TzCfg::batchRefresh(time_t refresh) {
+    for (int i = -1; i < this->schedule.count; i++) {
+        time_t t = (i < 0) ? this->tzEeprom.tranTime : this->schedule.tran[i].time;
+        if ((t > Time.now()) && (refresh > (t - tzRefreshBatch)) && (refresh < (t + tzRefreshBatch))) return t;
+    }
+    return refresh;
+}
+
+// ------------------------------------------------------------------------ refreshJitter()
+// Returns this device's spread (0 ... span-1 seconds) for a refresh or retry. It is derived from the
+// device ID, so it is repeatable on a device but differs across a fleet; 'salt' (e.g. the failure
+// count) gives each retry of a backoff a different spread.
+time_t TzCfg::refreshJitter(time_t span, uint32_t salt) {
+    if (span <= 0) return 0;
+    uint32_t h = this->refreshSeed ^ (salt * 2654435769UL);
+    h ^= h >> 16;   // <-- 32-bit finalizer (murmur3), so nearby seeds spread evenly
+    h *= 2246822507UL;
+    h ^= h >> 13;
+    h *= 3266489909UL;
+    h ^= h >> 16;
+    return (time_t)(h % (uint32_t)span);
+}
+
+// ------------------------------------------------------------------------ retryDelay()
+// Returns the interval before the next retry of a failed refresh. The interval doubles with each
+// consecutive failure, from tzRetryMinInterval up to tzBlockRetryInterval, and is at least twice
+// the wait a rate-limited server asked for. Half the interval is fixed, half is this device's spread,
+// so devices that failed together (e.g. an outage or a shared rate limit) do not retry together.
+time_t TzCfg::retryDelay(uint8_t failures) {
+    time_t delay = tzRetryMinInterval;
+    for (int i = 1; (i < failures) && (delay < tzBlockRetryInterval); i++) delay *= 2;
+    if (delay > tzBlockRetryInterval) delay = tzBlockRetryInterval;
+    if ((this->rateLimitWait > 0) && (delay < (this->rateLimitWait * 2))) delay = this->rateLimitWait * 2;
+    TZ_LOG_CFG(TZ_LEVEL_WARN, "Refresh failure %d: retry within %ld seconds%s", failures, (long)delay, (this->rateLimitWait > 0) ? " (rate limited)" : "");
+    return (delay / 2) + refreshJitter(delay - (delay / 2), failures);
+}
+
 // ---------------------------------------------------------------------------- searchForTzBlock()
 // Locates the TzBlock stored in EEPROM. 
 //      Returns -1 when  TzBlock is NOT found
 //      Returns the location of TzBlocks first byte when a TzBlock is found
 int TzCfg::searchForTzEeprom(void) {
-    // The usable EEPROM location ranges from zero to (EEPROM storage size - tzBlockSize).
-    int endUsableRange = (EEPROM.length() - sizeof(this->tzEeprom));
+    // The usable EEPROM location ranges from zero to (EEPROM storage size - tzBlockSize - tzScheduleSize).
+    int endUsableRange = (EEPROM.length() - sizeof(this->tzEeprom) - sizeof(this->schedule));
     int rangeIndex = 0;
     // A small buffer is used to minimize memory usage.
     char buffer[128];
@@ -446,6 +1098,7 @@ int TzCfg::searchForTzEeprom(void) {
 
     while ( !(rangeIndex > endUsableRange)) {
         EEPROM.get(rangeIndex,buffer);
+        buffer[sizeof(buffer) - 1] = '\0';    // <-- strstr() needs a terminator (the step below overlaps reads by a signature)
         cp = strstr(buffer, TZ_SIGNATURE);
         if (cp == NULL) {
             rangeIndex = rangeIndex + (sizeof(buffer) - sizeof(TZ_SIGNATURE));
@@ -454,14 +1107,76 @@ int TzCfg::searchForTzEeprom(void) {
             rangeIndex = startingLocation +1;
             // Note: We continue to search the entire EEPROM ... so logging exposes 
             //       multiple tzBlocks ... should they exist. 
-            #ifdef LOGGING
-                Serial.printf("TzBlock found @ Location %d\r\n", startingLocation);
-            #endif
+            TZ_LOG_CFG(TZ_LEVEL_INFO, "TzBlock found @ Location %d", startingLocation);
         }
     }
     return startingLocation;
 }
 
+// ---------------------------------------------------------------------------- passTime()
+// Returns the transition time queried by the current lookup pass (pass 1 queries the current time)
+time_t TzCfg::passTime(void) {
+    if (this->queryPass == 2) return this->tzWeb.tranTime;
+    if (this->queryPass > 2) return this->scheduleWeb.tran[this->queryPass - 3].time;
+    return 0;
+}
+
+// ---------------------------------------------------------------------------- applyRule()
+// Computes a TzBlock's settings and transitions, and fills its TzSchedule, from a compiled rule.
+// O(1) arithmetic per transition ... no HTTP queries are required.
+void TzCfg::applyRule(TzRule& rule, TzBlock& blk, TzSchedule& sched, time_t now) {
+    blk.stdOffset = (float)rule.stdOffset / 3600;
+    blk.curOffset = rule.offsetAt(now, blk.curAbbr);
+    blk.tranTime = rule.next(now, blk.tranOffset, blk.tranAbbr);
+    sched.count = 0;
+    time_t after = blk.tranTime;
+    while ((after > 0) && (sched.count < tzScheduleSize)) {
+        after = rule.next(after, sched.tran[sched.count].offset, sched.tran[sched.count].abbr);
+        sched.tran[sched.count].time = after;
+        if (after > 0) sched.count++;
+    }
+}
+
+// ---------------------------------------------------------------------------- overlapsTzEeprom()
+// Returns true when EEPROM sb ... sb+length-1 overlaps TzCfg's region (begin(sb)), the TzJournal ring (where
+// it is, or where the first write will put it) or a legacy TzBlock that has not been moved yet
+bool TzCfg::overlapsTzEeprom(int sb, int length) {
+    int ring = this->eepromStartByte;
+    if (ring == -1) ring = (this->journal.directoryByte >= 0) ? this->journal.directoryByte + (int)sizeof(TzDirectory) : 0;
+    int from[3] = { ring, this->journal.directoryByte, this->legacyByte };
+    int size[3] = { this->journal.size(), tzEepromSize, this->legacyLength };
+    for (int i = 0; i < 3; i++) {
+        if ((from[i] >= 0) && (sb < from[i] + size[i]) && (from[i] < sb + length)) return true;
+    }
+    return false;
+}
+
+// ---------------------------------------------------------------------------- writeTzEeprom()
+// Appends the TzBlock & TzSchedule to the TzJournal in EEPROM
+void TzCfg::writeTzEeprom(void) {
+    if (this->eepromStartByte == -1) { // <-- Occurs if no TzBlock was found in EEPROM, AND no startByte has been designated.
+        // Set the startByte to the default location: after the TzDirectory in TzCfg's region, else zero
+        this->eepromStartByte = (this->journal.directoryByte >= 0) ? this->journal.directoryByte + (int)sizeof(TzDirectory) : 0;
+    }
+    if (this->journal.base != this->eepromStartByte) this->journal.locate(this->eepromStartByte);
+    // A new ring (or one replacing a legacy TzBlock) must not overwrite the application's data
+    if (((this->journal.sequence == 0) || (this->legacyByte >= 0)) && !this->journal.claimable(this->eepromStartByte, this->legacyByte, this->legacyLength)) {
+        TZ_LOG_CFG(TZ_LEVEL_ERROR, "EEPROM %d ... %d holds other data: settings not stored (see begin(), setEepromStartByte())",
+            this->eepromStartByte, this->eepromStartByte + this->journal.size() - 1);
+        return;
+    }
+    this->journal.write(this->tzEeprom, this->schedule);
+    this->tzEepromExists = true;
+    if (this->legacyByte >= 0) {
+        // the legacy TzBlock has been replaced ... erase what is left of it outside the ring
+        uint8_t erased = 0xFF;
+        for (int i = this->legacyByte; i < this->legacyByte + this->legacyLength; i++) {
+            if ((i < this->journal.base) || (i >= this->journal.base + this->journal.size())) this->journal.update(i, &erased, 1);
+        }
+        this->legacyByte = -1;
+    }
+}
+
 // ---------------------------------------------------------------------------- updateDeviceSettings()
 // Updates the devices local time settings based on the TzBlock stored in EEPROM  (object name =  tzEeprom)
 void TzCfg::updateDeviceSettings(void) {
@@ -478,33 +1193,18 @@ void TzCfg::updateDeviceSettings(void) {
     }
     this->particleTimeSet = true;
     
-    #ifdef LOGGING
-        tzEeprom.log((char*)"tzEeprom");
-        Serial.println("\r\ntzCfg>\tLocal Time Settings Complete ...");
-        Serial.printf("tzCfg>\tTime.zone() ---> %.2f\r\n", Time.zone());
-        Serial.printf("tzCfg>\tTime.getDSTOffset() --> %.2f\r\n", Time.getDSTOffset());
-        Serial.printf("tzCfg>\tTime.isDST() ---> %s\r\n", Time.isDST()? "true" : "false");
-        Serial.printf("tzCfg>\ttzCfg.getTimezone() ---> %s\r\n", getTimezone());
-        Serial.printf("tzCfg>\ttzCfg.getTimezoneAbbr() ---> %s\r\n", getTimezoneAbbr());
-        Serial.printf("tzCfg>\tTime.format(Time.now(), TIME_FORMAT_DEFAULT) ---> %s\r\n", (const char *)Time.format(Time.now(), TIME_FORMAT_DEFAULT));
-    #endif
+    TZ_LOG_CFG(TZ_LEVEL_INFO, "Local Time Settings Complete: %s (%s), Time.zone() = %.2f, Time.getDSTOffset() = %.2f, Time.isDST() = %s",
+        getTimezone(), getTimezoneAbbr(), Time.zone(), Time.getDSTOffset(), Time.isDST() ? "true" : "false");
+    TZ_LOG_CFG(TZ_LEVEL_DEBUG, "Local time: %s", (const char *)Time.format(Time.now(), TIME_FORMAT_DEFAULT));
     
     return;
 }
 
 // -------------------------------------------------------------------- log()
-// Displays the contents of a TzBlock when LOGGING
+// Logs the contents of a TzBlock (at TZ_LEVEL_DEBUG)
 void TzBlock::log(char* name) {
-    # ifdef LOGGING
-		Serial.printf("TzBlock>\t-------- %s\r\n", name);
-		Serial.printf("TzBlock>\tid         = %s\r\n", this->id);
-		Serial.printf("TzBlock>\tstdOffset  = %.2f\r\n", this->stdOffset);
-		Serial.printf("TzBlock>\tcurOffset  = %.2f\r\n", this->curOffset);
-		Serial.printf("TzBlock>\tcurAbbr    = %s\r\n", this->curAbbr);
-		Serial.printf("TzBlock>\ttranTime   = %d\r\n", this->tranTime);
-		Serial.printf("TzBlock>\ttranOffset = %.2f\r\n", this->tranOffset);
-		Serial.printf("TzBlock>\ttranAbbr   = %s\r\n", this->tranAbbr);
-	#endif
+    TZ_LOG_CFG(TZ_LEVEL_DEBUG, "%s: id = %s, stdOffset = %.2f, curOffset = %.2f, curAbbr = %s", name, this->id, this->stdOffset, this->curOffset, this->curAbbr);
+    TZ_LOG_CFG(TZ_LEVEL_DEBUG, "%s: tranTime = %ld, tranOffset = %.2f, tranAbbr = %s", name, (long)this->tranTime, this->tranOffset, this->tranAbbr);
 }
 
 
@@ -1,15 +1,155 @@
 #ifndef __TZCFG_H_
 #define __TZCFG_H_
 #include "application.h"
-//#define LOGGING true      // <-- true for debugging, false (or commented out) For production
+//#define TZCFG_LOG_LEVEL TZ_LEVEL_WARN   // <-- Log level (TZ_LEVEL_NONE ... TZ_LEVEL_DEBUG); not defined: none (LOGGING, from earlier versions: TZ_LEVEL_DEBUG)
+//#define TZCFG_LOG_LEVEL_HTTP TZ_LEVEL_ERROR   // <-- A module's own level (_CFG, _HTTP or _EEPROM); not defined: TZCFG_LOG_LEVEL
+//#define TZCFG_ZONE_TABLE  // <-- defined: setTimezoneByID() resolves zones from the built-in table (~8 KB of flash)
+//#define TZCFG_GEO_INDEX   // <-- defined: setTimezoneByGPS() resolves zones from src/TzGeo.h (generate it with tools/TzGeoGen.py)
+//#define TZCFG_NO_METRICS  // <-- defined: the TzMetrics counters & timers (getMetrics()) are compiled out
 
 const time_t tzBlockRefreshInterval = 1723680;  // <-- Specifies the interval between refreshes. (~3 weeks)
-const time_t tzBlockRetryInterval =  40000;     // <-- Specifies the interval between retries if a refresh fails (~ 11 hours)
+const time_t tzBlockRetryInterval =  40000;     // <-- Specifies the longest interval between retries if a refresh fails (~ 11 hours)
+const time_t tzRetryMinInterval = 600;          // <-- Interval before the first retry (doubled by each further failure, up to tzBlockRetryInterval)
+const time_t tzRateLimitInterval = 3600;        // <-- Minimum interval before a retry when the server reports its rate limit without a Retry-After
+const time_t tzRefreshSpread = tzBlockRefreshInterval / 8;  // <-- Refreshes are spread (per device, from the device ID) over this many seconds (~2.5 days)
+const time_t tzTransitionLead = 172800;         // <-- Each transition is confirmed by a refresh in the window of this many seconds before it (2 days)
+const time_t tzRefreshBatch = 21600;            // <-- A refresh within this many seconds of a transition is moved to the transition (one wake-up for both)
 const char TZ_SIGNATURE[10] = "#!#TZ001a";      // <-- Used to identify the TzBlock in EEPROM.
+const char TZ_SCHEDULE_SIGNATURE[8] = "#!#TS02";// <-- Used to identify the TzSchedule that follows the TzBlock in EEPROM.
+const uint8_t tzScheduleSize = 6;               // <-- Transitions stored beyond the next one (~3 years for most DST zones)
+const int tzScheduleEntryWidth = 24;            // <-- Longest provider <schedule> entry ("4294967295,-50400,ABCDE;")
+const unsigned long tzdbQueryGap = 1000;        // <-- Minimum milliseconds between timezonedb queries (free tier: 1 per second)
+const char TZ_JOURNAL_SIGNATURE[6] = "#!#TJ";   // <-- Used to identify TzJournal records in EEPROM.
+const uint8_t tzRecordFormat = 1;               // <-- TzRecord (packed TzBlock & TzSchedule) format version
+const int tzRecordEntries = 124;                 // <-- Location of the transition entries in a TzRecord (see TzRecord.cpp for the layout)
+const int tzRecordEntrySize = 12;               // <-- Bytes per transition entry (tzScheduleSize + 1 of them, at most 8 ... one mask byte)
+const int tzRecordSize = tzRecordEntries + ((tzScheduleSize + 1) * tzRecordEntrySize);  // <-- Bytes per TzRecord (208)
+const uint8_t tzJournalSlots = 3;               // <-- Records in the TzJournal ring (EEPROM writes are spread across them)
+const char TZ_DIRECTORY_SIGNATURE[6] = "#!#TD"; // <-- Used to identify the TzDirectory (the first 16 bytes of TzCfg's region ... see begin()).
+const uint8_t tzDirectoryVersion = 1;           // <-- TzDirectory format version
+const uint8_t tzSetSize = 4;                    // <-- Time zones held by a TzSet
+const char TZ_GPS_CACHE_SIGNATURE[8] = "#!#TG02";   // <-- Used to identify the TzGpsCache in EEPROM (332 bytes).
+const uint8_t tzGpsCacheSize = 4;               // <-- Positions (geohash cells) remembered by the GPS cache
+const uint8_t tzGpsCacheBits = 30;              // <-- Default geohash cell precision (30 bits: ~0.011 x 0.0055 degrees, ~1 km)
+const time_t tzGpsCacheTtl = tzBlockRefreshInterval;    // <-- Seconds a cached position remains valid
 const uint8_t BY_ZONEID = 0, BY_POSITION = 1, BY_IP = 2; // <-- type of time zone lookup
+const unsigned long httpTimeout = 5000;         // <-- Milliseconds of server inactivity before an HTTP transaction fails
+const unsigned long httpKeepAlive = 10000;      // <-- Milliseconds an idle connection is kept open for reuse by the next HTTP transaction
+const int tzBinarySize = 128;                   // <-- Largest compact binary response (see TzProvider::binaryType)
+const uint8_t tzBinaryVersion = 1;              // <-- Compact binary response format version (see TzProvider.cpp for the layout)
+const unsigned int httpReadChunk = 128;         // <-- Maximum bytes buffered per Http::poll() call (bounds per-call latency)
+const size_t tzTimelineBlock = 256;             // <-- Timestamps TzTimeline::convert() checks for time order at a time
+const int httpChunkDigits = 7;                  // <-- Most hex digits in a chunk size (larger sizes would overflow a 32-bit long)
+const uint8_t HTTP_IDLE = 0, HTTP_CONNECTING = 1, HTTP_SENDING = 2, HTTP_RECEIVING = 3, HTTP_COMPLETE = 4, HTTP_FAILED = 5; // <-- Http states
+const int TZ_PENDING = 2;                       // <-- Refresh status while a time zone lookup is in progress (see EXIT_SUCCESS, EXIT_FAILURE)
+
+// Offsets are stored, and compared, as whole minutes ... float hours are only used to configure the device
+inline int16_t tzMinutes(float hours) { return (int16_t)((hours * 60) + ((hours < 0) ? -0.5f : 0.5f)); }
+
+// Error codes (see getLastError()) ... each matches the "(Ennn)" prefix of the corresponding status message
+enum TzError {
+    TZ_OK = 0,                      // <-- The last lookup succeeded
+    TZ_E_HTTP_STATUS = 600,         // <-- The server answered with an HTTP status other than 200 (see TzMetrics::httpStatus)
+    TZ_E_CONNECT = 621,             // <-- Unable to connect to the server
+    TZ_E_MALFORMED = 653,           // <-- Malformed or incomplete HTTP response
+    TZ_E_TIMEOUT = 668,             // <-- Timeout waiting for the server to respond
+    TZ_E_NO_JSON = 677,             // <-- JSON (or a binary body) not found in the response
+    TZ_E_JSON_TRUNCATED = 679,      // <-- JSON (or a binary body) truncated in the response
+    TZ_E_IPAPI_FAIL = 730,          // <-- ip-api reported a failure (its message is in the status message)
+    TZ_E_IPAPI_STATUS = 733,        // <-- Unable to parse the ip-api <status>
+    TZ_E_IPAPI_MESSAGE = 735,       // <-- Unable to parse the ip-api <message>
+    TZ_E_IPAPI_ADDRESS = 742,       // <-- Unable to parse the ip-api <query> (IP address)
+    TZ_E_IPAPI_ZONE = 743,          // <-- Unable to parse the ip-api <timezone>
+    TZ_E_TZDB_FAIL = 750,           // <-- timezonedb reported a failure (its message is in the status message)
+    TZ_E_TZDB_STATUS = 751,         // <-- Unable to parse the timezonedb <status>
+    TZ_E_TZDB_MESSAGE = 757,        // <-- Unable to parse the timezonedb <message>
+    TZ_E_RATE_LIMITED = 759,        // <-- The server reported its rate limit (HTTP 429, or a timezonedb message)
+    TZ_E_TZDB_OFFSET = 764,         // <-- Unable to parse the timezonedb <gmtOffset>
+    TZ_E_SCHEDULE = 766,            // <-- Unable to parse the provider's <schedule>
+    TZ_E_BINARY = 768,              // <-- Unable to decode the provider's binary response
+    TZ_E_RULE = 781,                // <-- Unable to compile the time zone rule
+    TZ_E_NO_POSITION = 791          // <-- The zone provider does not support lookups by position
+};
+
+// Counters & timers for the lookups, HTTP transactions and EEPROM accesses (see getMetrics()).
+// Times are in milliseconds (micros: microseconds); counts are totals since begin().
+struct TzMetrics {
+    uint32_t connectMillis;         // <-- Last transaction: time to connect (0 when an open connection was reused)
+    uint32_t firstByteMillis;       // <-- Last transaction: time from sending the request to the first response byte
+    uint32_t responseMillis;        // <-- Last transaction: time from sending the request to the end of the response
+    uint32_t parseMicros;           // <-- Last transaction: time spent reading & parsing the response
+    int httpStatus;                 // <-- Last transaction: HTTP status code (0 = no response)
+    uint32_t transactions;          // <-- HTTP transactions completed (or failed)
+    uint32_t connectionsReused;     // <-- Transactions that reused an open connection
+    uint32_t bytesReceived;         // <-- Response bytes received
+    uint32_t eepromReads;           // <-- TzJournal headers, records & directories read
+    uint32_t eepromReadMicros;      // <-- Time spent locating & reading TzJournal records
+    uint32_t eepromWrites;          // <-- TzJournal records written
+    uint32_t eepromBytesWritten;    // <-- EEPROM bytes written (unchanged bytes are not rewritten)
+    uint32_t eepromWriteMicros;     // <-- Time spent writing TzJournal records
+    uint32_t lookups;               // <-- Lookups that succeeded
+    uint32_t failures;              // <-- Lookups that failed
+    uint32_t retries;               // <-- Refreshes started after a failed refresh (the backoff's retries)
+    TzError lastError;              // <-- Result of the last lookup
+};
+
+#ifdef TZCFG_NO_METRICS
+    #define TZ_METRIC(...)
+#else
+    #define TZ_METRIC(...) __VA_ARGS__
+#endif
+
+// ------------------------------------------------------------------- Logging
+// Log messages are formatted into a ring buffer, and TzLog::flush() writes them to Serial once TzCfg
+// is idle ... never from inside an HTTP transaction. A message above its module's level compiles to nothing.
+#define TZ_LEVEL_NONE   0
+#define TZ_LEVEL_ERROR  1
+#define TZ_LEVEL_WARN   2
+#define TZ_LEVEL_INFO   3
+#define TZ_LEVEL_DEBUG  4
+#ifndef TZCFG_LOG_LEVEL
+    #ifdef LOGGING
+        #define TZCFG_LOG_LEVEL TZ_LEVEL_DEBUG
+    #else
+        #define TZCFG_LOG_LEVEL TZ_LEVEL_NONE
+    #endif
+#endif
+#ifndef TZCFG_LOG_LEVEL_CFG
+    #define TZCFG_LOG_LEVEL_CFG TZCFG_LOG_LEVEL
+#endif
+#ifndef TZCFG_LOG_LEVEL_HTTP
+    #define TZCFG_LOG_LEVEL_HTTP TZCFG_LOG_LEVEL
+#endif
+#ifndef TZCFG_LOG_LEVEL_EEPROM
+    #define TZCFG_LOG_LEVEL_EEPROM TZCFG_LOG_LEVEL
+#endif
+// Each module's level is capped at TZCFG_LOG_LEVEL (TZ_LEVEL_NONE allocates no log buffer)
+const uint8_t tzLogCfg = (TZCFG_LOG_LEVEL_CFG < TZCFG_LOG_LEVEL) ? TZCFG_LOG_LEVEL_CFG : TZCFG_LOG_LEVEL;            // <-- Level for TzCfg, TzSet, TzRule & the zone tables
+const uint8_t tzLogHttp = (TZCFG_LOG_LEVEL_HTTP < TZCFG_LOG_LEVEL) ? TZCFG_LOG_LEVEL_HTTP : TZCFG_LOG_LEVEL;         // <-- Level for Http, HttpParser & Json
+const uint8_t tzLogEeprom = (TZCFG_LOG_LEVEL_EEPROM < TZCFG_LOG_LEVEL) ? TZCFG_LOG_LEVEL_EEPROM : TZCFG_LOG_LEVEL;   // <-- Level for TzJournal
+const unsigned int tzLogBufferSize = 1024;      // <-- Bytes of buffered log messages (allocated when TZCFG_LOG_LEVEL > TZ_LEVEL_NONE)
+const unsigned int tzLogLineSize = 128;         // <-- Longest log message (longer messages are truncated)
+
+#define TZ_LOG(moduleLevel, level, tag, ...) do { if ((level) <= (moduleLevel)) TzLog::write(tag, __VA_ARGS__); } while (0)
+#define TZ_LOG_CFG(level, ...)      TZ_LOG(tzLogCfg, level, "tzCfg", __VA_ARGS__)
+#define TZ_LOG_HTTP(level, ...)     TZ_LOG(tzLogHttp, level, "Http", __VA_ARGS__)
+#define TZ_LOG_EEPROM(level, ...)   TZ_LOG(tzLogEeprom, level, "TzJournal", __VA_ARGS__)
+
+class TzLog {
+    public:
+        static void write(const char* tag, const char* format, ...) __attribute__((format(printf, 2, 3)));  // <-- Formats a message into the ring buffer (use the TZ_LOG_... macros)
+        static void flush(void);                    // <-- Writes the buffered messages to Serial
+        static uint32_t dropped;                    // <-- Messages dropped because the ring buffer was full
+    private:
+        #if TZCFG_LOG_LEVEL > TZ_LEVEL_NONE
+        static char ring[tzLogBufferSize];          // <-- Buffered messages ("\r\n" terminated)
+        static unsigned int head;                   // <-- Where the next message is written
+        static unsigned int tail;                   // <-- Where flush() resumes
+        #endif
+};
 
 // ------------------------------------------------------------------- tzBlock Class
-// Defines the data that TzCfg stores in EEPROM
+// Defines the data that TzCfg stores in EEPROM (packed as a TzRecord)
 
 class TzBlock {
 	private:
@@ -36,36 +176,12 @@ class TzBlock {
 	            std::fill_n(this->futureUse,sizeof(this->futureUse),0xFF);
             }
 		// method declaration ---------
-    		void log(char*); // <-- Displays the contents of a TzBlock on the Serial console (when LOGGING)
+    		void log(char*); // <-- Logs the contents of a TzBlock (at TZ_LEVEL_DEBUG)
     	// operator definitions
-            bool operator==(const TzBlock& b) { 
-            if ((strcmp(this->signature, b.signature) == 0) 
-             && (strcmp(this->id, b.id) == 0)
-             && (this->stdOffset == b.stdOffset)
-             && (this->curOffset == b.curOffset)
-             && (strcmp(this->curAbbr, b.curAbbr) == 0)
-             && (this->tranTime == b.tranTime)
-             && (this->tranOffset == b.tranOffset)
-             && (strcmp(this->tranAbbr, b.tranAbbr) == 0))  return true;
-            else return false;
-        }
-        
-        bool operator!=(const TzBlock& b) {
-            if ((strcmp(this->signature, b.signature) == 0) 
-             && (strcmp(this->id, b.id) == 0)
-             && (this->stdOffset == b.stdOffset)
-             && (this->curOffset == b.curOffset)
-             && (strcmp(this->curAbbr, b.curAbbr) == 0)
-             && (this->tranTime == b.tranTime)
-             && (this->tranOffset == b.tranOffset)
-             && (strcmp(this->tranAbbr, b.tranAbbr) == 0))  return false;
-            else return true;
-        }
-        
         TzBlock operator=(const TzBlock &rt) {
             if (this != &rt) {
                 strncpy(this->signature, rt.signature, sizeof(this->signature)); 
-                strncpy(this->id, rt.id, sizeof(this->signature));
+                strncpy(this->id, rt.id, sizeof(this->id));
                 this->stdOffset = rt.stdOffset;
                 this->curOffset = rt.curOffset;
                 strncpy(this->curAbbr, rt.curAbbr, sizeof(this->curAbbr));
@@ -78,22 +194,422 @@ class TzBlock {
         }
 		
 		friend class TzCfg;
+		friend class TzRecord;
+		friend class TzSet;
+		friend class TzTimeline;
 		friend class Json;
 };
 
+// ------------------------------------------------------------------- TzSchedule Class
+// Defines the DST transitions that follow TzBlock::tranTime. 
+// TzCfg stores the TzSchedule in EEPROM with the TzBlock (packed as a TzRecord).
+
+class TzSchedule {
+	private:
+	    // variable declaration
+	        char signature[8];                  //  <-- Identifies the TzSchedule in EEPROM
+	        uint8_t count;                      //  <-- Number of scheduled transitions
+	        char rule[48];                      //  <-- POSIX TZ rule that generates the transitions ("" = none)
+	        struct {
+	            time_t time;                    //  <-- Date/time of the transition
+	            float offset;                   //  <-- Post-transition offset
+	            char abbr[6];                   //  <-- Post-transition abbreviation
+	        } tran[tzScheduleSize];             //  <-- Scheduled transitions, in time order
+	    // constructor --------------
+	        TzSchedule(void) {
+	            memset(this->tran, 0, sizeof(this->tran));
+	            strncpy(this->signature, TZ_SCHEDULE_SIGNATURE, sizeof(this->signature));
+	            this->count = 0;
+	            this->rule[0] = '\0';
+	        }
+	    // method declaration ---------
+	        bool valid(void) {                  // <-- Returns true if the TzSchedule read from EEPROM is usable
+	            return (strcmp(this->signature, TZ_SCHEDULE_SIGNATURE) == 0) && (this->count <= tzScheduleSize)
+	                && (memchr(this->rule, '\0', sizeof(this->rule)) != NULL);
+	        }
+
+		friend class TzCfg;
+		friend class TzRecord;
+		friend class TzSet;
+		friend class TzTimeline;
+};
+
+// ------------------------------------------------------------------- TzRecord Class
+// The packed, versioned EEPROM image of a TzBlock & its TzSchedule: offsets in whole minutes,
+// length-prefixed strings, little-endian integers and no padding ... so two records packed without a prior image are compared with memcmp().
+
+class TzRecord {
+    private:
+        uint8_t data[tzRecordSize];         // <-- Packed image (see TzRecord.cpp for the layout)
+        int position;                       // <-- Current read/write position in data
+        TzRecord(void);
+        void pack(const TzBlock& blk, const TzSchedule& sched, const TzRecord* prior = NULL);  // <-- Packs a TzBlock & TzSchedule into the image (aligned with 'prior')
+        bool unpack(TzBlock& blk, TzSchedule& sched);               // <-- Unpacks the image ... returns false if it is malformed
+        bool operator==(const TzRecord& b) { return memcmp(this->data, b.data, sizeof(this->data)) == 0; }
+        bool operator!=(const TzRecord& b) { return memcmp(this->data, b.data, sizeof(this->data)) != 0; }
+        void putInt(uint32_t value, int bytes);
+        uint32_t getInt(int bytes);
+        void putString(const char* str, int size);
+        bool getString(char* str, int size);
+        void putEntry(time_t time, float offset, const char* abbr);
+        const uint8_t* entry(int j) const;  // <-- Transition entry j of the image
+
+        friend class TzCfg;
+        friend class TzJournal;
+        friend class TzSet;
+};
+
+// ------------------------------------------------------------------- TzJournal Class
+// Stores the TzBlock & TzSchedule (as a TzRecord) in EEPROM in a ring of tzJournalSlots records.
+// Each update is written to the slot after the newest record, so writes are spread across
+// the ring, and an interrupted write leaves the previous record intact.
+
+struct TzJournalHeader {
+    char signature[6];                      // <-- Identifies a TzJournal record in EEPROM
+    uint16_t crc;                           // <-- CRC-16 of the rest of the record (sequence ... TzRecord)
+    uint32_t sequence;                      // <-- Incremented by each write ... the newest valid record is current
+    int16_t base;                           // <-- EEPROM location of the ring's first slot
+    uint8_t slots;                          // <-- Number of slots in the ring
+    uint8_t format;                         // <-- tzRecordFormat of the TzRecord that follows
+};
+
+// The TzDirectory, at the location given to begin(), records where the ring is,
+// so begin() does not have to scan EEPROM for it.
+struct TzDirectory {
+    char signature[6];                      // <-- Identifies the TzDirectory
+    uint8_t version;                        // <-- tzDirectoryVersion
+    uint8_t slots;                          // <-- Number of slots in the ring
+    int16_t offset;                         // <-- EEPROM location of the ring
+    uint16_t length;                        // <-- Bytes used by the ring
+    uint16_t crc;                           // <-- CRC-16 of the fields above
+    uint8_t reserved[2];
+};
+
+const int tzEepromSize = sizeof(TzDirectory) + (tzJournalSlots * (sizeof(TzJournalHeader) + tzRecordSize));  // <-- EEPROM bytes of TzCfg's region, begin(sb): the TzDirectory, then the TzJournal ring (688)
+
+class TzJournal {
+    private:
+        int base;                           // <-- EEPROM location of the ring (-1 = none)
+        uint8_t slot;                       // <-- Slot that holds the newest record
+        uint32_t sequence;                  // <-- Sequence number of the newest record (0 = no record)
+        bool foundViaDirectory;             // <-- Set when the ring was located by (or has since been recorded in) the TzDirectory ... the directory is not rewritten
+        uint8_t slots;                      // <-- Number of slots in the ring (tzJournalSlots for the device's zone)
+        bool ownsDirectoryEntry;            // <-- Set when this is the ring the TzDirectory records (TzCfg's ... not a TzSet zone's)
+        int directoryByte;                  // <-- EEPROM location of the TzDirectory (-1 = none ... the ring is found by a scan)
+        int legacyFound;                    // <-- EEPROM location of the last legacy TzBlock seen by search() (-1 = none)
+        uint32_t bytesWritten;              // <-- EEPROM bytes written since begin() (unchanged bytes are not rewritten)
+        uint32_t rangesWritten;             // <-- Runs of consecutive changed bytes written since begin()
+        #ifndef TZCFG_NO_METRICS
+        TzMetrics* metrics;                 // <-- Receives the EEPROM counters & timers (NULL = none)
+        #endif
+        TzJournal();
+        int recordSize(void);               // <-- Bytes per record (header & TzRecord)
+        int size(void);                     // <-- Bytes used by the ring
+        int address(uint8_t slot);          // <-- EEPROM location of a slot
+        int directoryAddress(void);         // <-- EEPROM location of the TzDirectory
+        int lastBase(void);                 // <-- Highest usable EEPROM location for the ring
+        bool claimable(int base, int keep, int keepLength);    // <-- Returns true when a ring at 'base' would overwrite no other data
+        void locate(int base);              // <-- Moves the ring (the next write starts a new ring at 'base')
+        int find(void);                     // <-- Locates the ring (TzDirectory first, else a scan) & its newest valid record
+        int search(void);                   // <-- Scans EEPROM for a record (rings written before the TzDirectory) & a legacy TzBlock
+        void select(void);                  // <-- Selects the ring's newest valid record
+        bool readDirectory(void);           // <-- Reads the ring's location from the TzDirectory
+        void writeDirectory(void);          // <-- Records the ring's location in the TzDirectory
+        bool valid(uint8_t slot, uint32_t& sequence);   // <-- Checks a slot's header & CRC
+        bool load(TzBlock& blk, TzSchedule& sched);     // <-- Reads the newest record
+        void write(TzBlock& blk, TzSchedule& sched);    // <-- Appends a record to the ring
+        void erase(void);                   // <-- Erases every slot in the ring
+        void update(int location, const void* data, int length);   // <-- Writes only the bytes that differ from EEPROM
+        static uint16_t crc16(uint16_t crc, uint8_t b);
+
+        friend class TzSet;
+        friend class TzCfg;
+};
+
+// ------------------------------------------------------------------- TzRule Class
+// A compiled POSIX TZ rule (e.g. "CST6CDT,M3.2.0,M11.1.0"), used to compute DST transitions on the device
+
+struct TzRuleDate {
+    char type;                              // <-- 'M' (Mm.w.d), 'J' (Jn) or 'n' (n)
+    uint8_t month;                          // <-- Mm.w.d month (1-12)
+    uint8_t week;                           // <-- Mm.w.d week (1-5, 5 = last)
+    uint8_t wday;                           // <-- Mm.w.d weekday (0-6, 0 = Sunday)
+    uint16_t day;                           // <-- Jn or n day
+    long time;                              // <-- Local time of the transition (seconds after midnight)
+};
+
+class TzRule {
+    private:
+        bool valid;                         // <-- Set when a rule has been compiled
+        bool hasDst;                        // <-- Set when the rule has DST transitions
+        long stdOffset;                     // <-- Standard offset (seconds EAST of UTC)
+        long dstOffset;                     // <-- DST offset (seconds EAST of UTC)
+        char stdAbbr[6];                    // <-- Standard abbreviation
+        char dstAbbr[6];                    // <-- DST abbreviation
+        TzRuleDate start;                   // <-- Transition to DST
+        TzRuleDate end;                     // <-- Transition to standard time
+        TzRule();
+        int compile(const char* rule);                          // <-- Compiles a POSIX TZ rule
+        time_t next(time_t after, float& offset, char* abbr);   // <-- Returns the first transition after 'after'
+        float offsetAt(time_t t, char* abbr);                   // <-- Returns the offset (hours) in effect at 't'
+        time_t transition(int year, bool toDst);
+        bool parseAbbr(const char*& cp, char* abbr);
+        bool parseTime(const char*& cp, long& seconds);
+        bool parseDate(const char*& cp, TzRuleDate& d);
+
+        friend class TzTimeline;
+        friend class TzSet;
+        friend class TzCfg;
+};
+
+// ------------------------------------------------------------------- TzGpsCache Class
+// Remembers the time zone IDs of recently resolved positions (geohash cells)
+
+class TzGpsCache {
+    private:
+        struct {
+            char signature[8];              // <-- Identifies the TzGpsCache in EEPROM
+            uint8_t bits;                   // <-- Geohash cell precision (bits)
+            uint8_t reserved[3];
+            struct {
+                uint32_t cell;              // <-- Geohash cell
+                uint32_t used;              // <-- Time of the last hit (least recently used is replaced first)
+                uint32_t expires;           // <-- Time when the entry expires (0 = empty)
+                char id[65];                // <-- Time zone ID for the cell
+                uint8_t reserved[3];
+            } entry[tzGpsCacheSize];
+        } data;                             // <-- Cache contents, persisted as is in EEPROM when eepromByte >= 0 (fixed-width fields, no implicit padding)
+        uint32_t hits;                      // <-- Lookups resolved by the cache
+        uint32_t misses;                    // <-- Lookups that were not resolved by the cache
+        int eepromByte;                     // <-- EEPROM location of the cache (-1 = RAM only)
+        TzGpsCache();
+        void clear(uint8_t bits);                                           // <-- Empties the cache & sets the cell precision
+        uint32_t cellOf(float lat, float lng);                              // <-- Returns the geohash cell for a position
+        int find(float lat, float lng, time_t now, char* id, int idSize);   // <-- Returns the cached zone ID for a position
+        void insert(float lat, float lng, time_t now, const char* id);      // <-- Caches the zone ID for a position
+        void load(int sb);                                                  // <-- Sets (and loads) the EEPROM location
+        void save(int slot = -1);                                           // <-- Stores the cache (or only entry 'slot') in EEPROM
+
+        friend class TzCfg;
+};
+
+// ------------------------------------------------------------------- TzTimeline Class
+// A zone's periods of constant offset, used to convert arrays of UTC timestamps to local time
+
+class TzTimeline {
+    private:
+        time_t start[tzScheduleSize + 1];   // <-- Start of each period after the first (the transitions, in time order)
+        long offset[tzScheduleSize + 2];    // <-- Offset (seconds EAST of UTC) in each period
+        int count;                          // <-- Number of transitions
+        TzRule* rule;                       // <-- The zone's rule (NULL = none) ... provides periods outside the schedule
+        TzTimeline(TzBlock& blk, TzSchedule& sched, TzRule& rule);
+        void period(time_t t, time_t& from, time_t& to, long& offset);    // <-- Finds the period that contains 't'
+        void convert(const time_t* in, time_t* out, size_t n);            // <-- Converts UTC timestamps to local time
+
+        friend class TzCfg;
+        friend class TzSet;
+};
+
+// ------------------------------------------------------------------- TzSet Class
+// Holds up to tzSetSize additional time zones, and converts between UTC and their local times
+// without changing the device's time settings. TzCfg::maintainLocalTime() refreshes the zones
+// (see TzCfg::setTimezoneSet()).
+
+class TzSet {
+    public:
+        TzSet();
+        int add(char* id);                          // <-- Adds a zone (refreshed from timezonedb or the zone table) ... returns its handle, or -1
+        int addByRule(char* id, char* rule);        // <-- Adds a zone defined by a POSIX TZ rule ... returns its handle, or -1
+        void remove(int zone);                      // <-- Removes a zone (and erases it from EEPROM)
+        bool ready(int zone);                       // <-- Returns true when the zone's settings are known
+        char* getTimezone(int zone);                // <-- Returns the zone's time zone ID
+        long offsetAt(int zone, time_t utc);        // <-- Returns the zone's offset (seconds EAST of UTC) at a UTC time
+        time_t toLocal(int zone, time_t utc);       // <-- Converts a UTC time to the zone's local time
+        time_t toUtc(int zone, time_t local);       // <-- Converts a local time in the zone to UTC
+        void setEepromStartByte(int sb);            // <-- Persists the zones in EEPROM at sb (tzSetSize TzJournal records), restoring any stored there ... rejected over other data
+        void convertBatch(int zone, const time_t* in, time_t* out, size_t n);  // <-- Converts an array of UTC timestamps to the zone's local time
+    private:
+        struct {
+            bool used;                      // <-- Set when the entry holds a zone
+            bool loaded;                    // <-- Set when the zone's settings are known
+            TzBlock blk;                    // <-- Zone settings (the TzSchedule below holds the transitions that follow)
+            TzSchedule sched;
+            TzRule rule;                    // <-- Compiled rule (when sched.rule is set)
+            time_t refreshTime;             // <-- Time of the zone's next refresh
+            uint8_t failures;               // <-- Consecutive failed refreshes (sets the retry backoff)
+            TzJournal journal;              // <-- The zone's EEPROM record (a one-slot TzJournal ... base -1 = RAM only)
+        } zone[tzSetSize];
+        int eepromStartByte;                // <-- EEPROM location of the zones (-1 = RAM only)
+        int claim(char* id);                // <-- Returns a free entry, initialized for 'id', or -1
+        void save(int zone);                // <-- Writes the zone to EEPROM (when persisted)
+
+        friend class TzCfg;
+};
+
 /*  TzBlock will be instantiated as follows:
         tzEeprom  ... will be instantiated as TzCfg::tzEeprom, and represents the TzBlock stored in EEPROM
-        tzWeb ...     will be instantiated in TzCfg::setLocalTime and represents the TzBlock that is built
+        tzWeb ...     will be instantiated as TzCfg::tzWeb and represents the TzBlock that is built
                       from the information provided by an HTTP server.
         Other methods also create TzBlocks for temporary use. 
 */
+// ------------------------------------------------------------------- JsonField
+// Describes a JSON name, and where (and as what type) its value will be stored
+const uint8_t JSON_STRING = 0, JSON_FLOAT = 1, JSON_TIME = 2;   // <-- JsonField value types
+
+struct JsonField {
+    const char* name;                       // <-- JSON name (matched exactly, top level object only)
+    uint8_t type;                           // <-- JSON_STRING, JSON_FLOAT or JSON_TIME
+    void* value;                            // <-- Points to the char[], float or time_t that receives the value
+    int size;                               // <-- sizeof the char[] (JSON_STRING only)
+    bool found;                             // <-- Set when a complete value has been stored
+    bool truncated;                         // <-- Set when the value did not fit (it is stored truncated, and not found)
+};
+
+// ------------------------------------------------------------------- Json Class
+// Provides methods used to encode and decode JSON
+class Json {
+    private:
+        JsonField* fields;                  // <-- Table of fields to be extracted
+        int fieldCount;                     // <-- Number of fields in the table (max 32)
+        JsonField* field;                   // <-- Field that receives the value being decoded (NULL = skip)
+        uint8_t state;                      // <-- Tokenizer state
+        uint8_t depth;                      // <-- Object/array nesting depth
+        uint32_t arrays;                    // <-- One bit per nesting level, set for arrays
+        bool expectKey;                     // <-- Set when the next string is a name
+        bool started;                       // <-- Set when the JSON text's first object or array has opened
+        uint8_t escape;                     // <-- Escape sequence progress (0 = none)
+        uint16_t unicode;                   // <-- \uXXXX code point being decoded
+        uint32_t candidates;                // <-- One bit per field whose name still matches the name being decoded
+        int length;                         // <-- Length of the name or value being decoded
+        bool truncated;                     // <-- Set when a value does not fit its destination
+        char scalar[24];                    // <-- Text of a numeric value being decoded
+        Json();
+        void begin(JsonField* fields, int fieldCount);                              // <-- prepares to decode a JSON text
+        void feed(char c);                                                          // <-- decodes the next character
+        int parse(const char* json, int jsonSize, JsonField* fields, int fieldCount); // <-- decodes a JSON text in a single pass
+        int found(void);                                                            // <-- returns the number of fields found
+        void beginKey(void);
+        void endKey(void);
+        void beginValue(void);
+        void endValue(void);
+        void emit(char c);
+        void emitUnicode(uint16_t u);
+        int hexValue(char c);
+
+        friend class TzCfg;
+        friend class Http;
+        friend class HttpParser;
+};
+
+// ------------------------------------------------------------------- HttpParser Class
+// Parses an HTTP/1.x response incrementally, feeding the body to a Json tokenizer
+const uint8_t HP_STATUS = 0, HP_HEADER = 1, HP_BODY = 2, HP_CHUNK_SIZE = 3, HP_CHUNK_DATA = 4, HP_CHUNK_END = 5, HP_TRAILER = 6, HP_DONE = 7, HP_ERROR = 8;   // <-- HttpParser states
+
+class HttpParser {
+    private:
+        Json* json;                         // <-- Receives the response body (may be NULL)
+        uint8_t state;                      // <-- Parser state (HP_STATUS ... HP_ERROR)
+        int statusCode;                     // <-- HTTP status code from the status line
+        char reason[33];                    // <-- HTTP reason phrase from the status line
+        char line[48];                      // <-- Current status/header line (truncated)
+        int lineLength;                     // <-- Length of the current line
+        bool chunked;                       // <-- Set for "Transfer-Encoding: chunked"
+        bool lengthKnown;                   // <-- Set when a Content-Length header was received
+        bool keepAlive;                     // <-- Set when the server will keep the connection open after the response
+        char validator[48];                 // <-- ETag (or Last-Modified) header of the response ("" = none)
+        long retryAfter;                    // <-- Seconds the server asks the client to wait (Retry-After or X-Ttl header ... 0 = none)
+        const char* binaryType;             // <-- Content-Type of a binary body (NULL = JSON only)
+        bool binary;                        // <-- Set when the response's Content-Type is binaryType (the body is kept in bin[])
+        uint8_t bin[tzBinarySize];          // <-- Binary body
+        int binLength;                      // <-- Binary body length (> tzBinarySize = truncated)
+        long remaining;                     // <-- Body (or chunk) bytes remaining
+        HttpParser();
+        void begin(Json* json, const char* binaryType = NULL);  // <-- Prepares the parser for a new response
+        void feed(char c);                  // <-- Consumes the next response byte
+        void feed(const char* data, int size);  // <-- Consumes a block of response bytes
+        void finish(void);                  // <-- Called when the server closes the connection
+        bool done(void);                    // <-- Returns true when the response is complete
+        bool failed(void);                  // <-- Returns true when the response is malformed or incomplete
+        void endLine(void);
+        bool headerIs(const char* name);
+        char* headerValue(void);
+        void body(char c);
+        int hexValue(char c);
+
+        friend class Http;
+        friend class TzCfg;
+};
+
+
+// ------------------------------------------------------------------- Http Class
+// Handles communication with the HTTP server
+class Http {
+    private:
+        TCPClient client;                   // <-- Stores the TCPClient object used to perform the HTTP POST transaction
+        Json json;                          // <-- Decodes the JSON in the response body as it arrives
+        HttpParser parser;                  // <-- Parses the HTTP response as it arrives
+        bool error;                         // <-- Error flag used while processing HTTP
+        int statusCode;                     // <-- HTTP status code returned
+        unsigned long lastReadMillis;       // <-- Time when the last character was received from the host
+        unsigned long startMillis;          // <-- Time when the POST transaction was sent to the server
+        uint8_t state;                      // <-- Current state of the HTTP transaction (HTTP_IDLE ... HTTP_FAILED)
+        char hostName[33];                  // <-- Host name for the current HTTP transaction
+        char hostPath[193];                 // <-- Host path for the current HTTP transaction
+        char validator[48];                 // <-- Validator sent with the request (If-None-Match / If-Modified-Since ... "" = none)
+        const char* binaryType;             // <-- Binary Content-Type offered in the request's Accept header (NULL = JSON only)
+        int hostPort;                       // <-- Host port for the current HTTP transaction
+        bool open;                          // <-- Set while the TCP connection is open (it is kept alive between transactions)
+        bool reused;                        // <-- Set when the current transaction reuses an open connection
+        unsigned long idleMillis;           // <-- Time when the open connection became idle
+        TzError errorCode;                  // <-- Error code of a failed transaction (TZ_OK = none)
+        #ifndef TZCFG_NO_METRICS
+        TzMetrics* metrics;                 // <-- Receives the transaction's timers & counters (NULL = none)
+        #endif
+        Http();
+        void begin(char* hostName, int hostPort, char* hostPath, JsonField* fields, int fieldCount, const char* validator = NULL, const char* binaryType = NULL);    // <-- Prepares a non-blocking HTTP transaction
+        uint8_t poll(char* statusMsg, int statusMsgSize);           // <-- Advances the HTTP transaction by one step
+        void stop(void);                                            // <-- Abandons the HTTP transaction & closes the connection
+        void closeIdle(void);                                       // <-- Closes an idle connection once httpKeepAlive expires
+        bool complete(char* statusMsg, int statusMsgSize);          // <-- Checks the parsed HTTP response
+        int getJson(char* hostName, int hostPort, char* hostPath, JsonField* fields, int fieldCount, char* errorMsg, int errMsgSize);  // <-- Performs the HTTP processing (blocking)
+        
+        friend class TzCfg;
+};
+
+// Http is instantiated as TzCfg::http, so an HTTP transaction can span several calls to TzCfg::poll()
+
+
+// ------------------------------------------------------------------- TzProvider
+// Describes a time zone server: how its requests are built, and the names of the fields in its JSON
+// responses. TzCfg uses tzProviderTimezonedb & tzProviderIpApi unless setZoneProvider() / setIpProvider()
+// select another (e.g. a fleet's own caching proxy). Paths are expanded by TzCfg::providerPath().
+const uint8_t TZ_FIELD_STATUS = 0, TZ_FIELD_MESSAGE = 1, TZ_FIELD_OFFSET = 2, TZ_FIELD_DST = 3, TZ_FIELD_DST_END = 4, TZ_FIELD_NEXT_ABBR = 5,
+              TZ_FIELD_ZONE = 6, TZ_FIELD_ABBR = 7, TZ_FIELD_SCHEDULE = 8, TZ_FIELD_RULE = 9, TZ_FIELD_IP = 10, TZ_FIELD_COUNT = 11;    // <-- TzProvider::fields indexes
+
+struct TzProvider {
+    const char* name;                       // <-- Prefixes the server's own error messages in the status message
+    const char* host;                       // <-- Server host name (at most 32 characters)
+    int port;                               // <-- Server port
+    const char* path;                       // <-- Path of a lookup by zone ID, or of the IP lookup (%k = API key, %z = zone ID)
+    const char* positionPath;               // <-- Path of a lookup by position (%a = latitude, %o = longitude ... NULL = not supported)
+    const char* timeQuery;                  // <-- Appended to query a later time (%t = UTC seconds ... NULL = one response carries the schedule)
+    const char* okStatus;                   // <-- <status> of a successful response
+    const char* fields[TZ_FIELD_COUNT];     // <-- JSON names of the response fields, by TZ_FIELD_ index ("" = not provided)
+    const char* binaryType;                 // <-- Content-Type of the provider's compact binary response (NULL or omitted = JSON only)
+};
+
+extern const TzProvider tzProviderTimezonedb;   // <-- api.timezonedb.com (the default zone provider)
+extern const TzProvider tzProviderIpApi;        // <-- ip-api.com (the default IP provider)
+
+
 // ------------------------------------------------------------------- TzCfg Class
 // Defines TzCfg core data and references
 class TzCfg {
     private:
         TzBlock tzEeprom;                           // <-- tzBlock object that stores time zone data in EEPROM
         bool tzEepromExists;                        // <-- Indicates if the tzBlock currently exists in EEPROM
-        int eepromStartByte;                        // <-- The starting location of the tzBlock in EEPROM
+        int eepromStartByte;                        // <-- The starting location of the TzJournal (tzBlock records) in EEPROM
+        TzJournal journal;                          // <-- Stores the tzBlock & tzSchedule in EEPROM
         time_t eepromRefreshTime;                   // <-- Specifies when the next tzBlock refresh will take place
         bool particleTimeSet;                       // <-- set false by tzCfg.begin(), and true when settings have been updated.
         char tzdbApiKey[16];                        // <== Stores the API key for timezonedb
@@ -102,66 +618,114 @@ class TzCfg {
         float longitude;                            // <-- Contains the longitude for time zone lookups by position
         char newZoneID[65];                         // <-- Contains the time zone name for time zone lookups by name
         char localIP[16];                           // <-- Contains the local IP address for time zone lookups by IP (format: nnn.nnn.nnn.nnn)
+        char tzdbValidator[48];                     // <-- Validator (ETag / Last-Modified) of the last first-pass response for the device's zone
         int setLocalTime(uint8_t);             	    // <-- Sets the devices local time settings for a specified time zone
         void setEepromRefreshTime();                // <-- Calculates the time when tzCfg will attempt to refresh the TzBlock in EEPROM
+        Http http;                                  // <-- Performs the non-blocking HTTP transactions for time zone lookups
+        TzBlock tzWeb;                              // <-- TzBlock built from the HTTP server's responses during a lookup
+        uint8_t lookupBy;                           // <-- Type of the lookup in progress (BY_ZONEID, BY_POSITION, BY_IP)
+        int queryPass;                              // <-- Pass of the lookup in progress (0 = IP provider, 1 = current settings, 2 = post-transition settings)
+        bool queryComplete;                         // <-- Set when the lookup in progress has all the data it needs
+        bool queryError;                            // <-- Set when the lookup in progress has failed
+        int refreshStatus;                          // <-- TZ_PENDING while a lookup is in progress, else the lookup's result
+        const TzProvider* zoneProvider;             // <-- Server for lookups by zone ID & position (default: tzProviderTimezonedb)
+        const TzProvider* ipProvider;               // <-- Server for lookups by IP (default: tzProviderIpApi)
+        char jsonStatus[16];                        // <-- Provider <status> for the current lookup pass
+        char jsonMessage[65];                       // <-- Provider <message> for the current lookup pass
+        float jsonGmtOffset;                        // <-- Provider <gmtOffset> for the current lookup pass
+        char jsonDst[2];                            // <-- Provider <dst> for the current lookup pass
+        time_t jsonDstEnd;                          // <-- Provider <dstEnd> for the current lookup pass
+        char jsonNextAbbr[6];                       // <-- Provider <nextAbbreviation> for the current lookup pass
+        char jsonSchedule[(tzScheduleSize + 1) * tzScheduleEntryWidth + 1];    // <-- Provider <schedule> ("time,offset,abbr;..." ... first pass only)
+        JsonField jsonFields[TZ_FIELD_RULE + 1];    // <-- Table used to decode the provider's response as it arrives
+        bool zoneLookupReady(void);                 // <-- Returns true when the zone provider can be queried (it has the API key it needs)
+        void providerPath(const char* pattern, char* path, int size);   // <-- Appends a provider path, with its placeholders expanded
+        void providerMessage(const TzProvider* p, const char* message, int length);  // <-- Sets statusMsg to a provider's error message
+        int parseSchedule(const char* text);        // <-- Decodes a provider <schedule> into tzWeb & scheduleWeb
+        int parseBinary(const uint8_t* data, int size); // <-- Decodes a provider's compact binary response into tzWeb & scheduleWeb
+        TzSchedule schedule;                        // <-- Transitions that follow tzEeprom.tranTime (stored in EEPROM after the TzBlock)
+        TzSchedule scheduleWeb;                     // <-- Transitions built from the HTTP server's responses during a lookup
+        bool queryWaiting;                          // <-- Set while the next lookup pass waits out tzdbQueryGap
+        bool lookupBlocking;                        // <-- Set while a setTimezoneBy...() call waits for its lookup (see setLocalTime())
+        void applyLookup(void);                     // <-- Stores & applies a blocking lookup's settings before its TzSchedule is complete
+        unsigned long queryMillis;                  // <-- Time when the current lookup pass was started
+        time_t passTime(void);                      // <-- Returns the transition time queried by the current lookup pass
+        void writeTzEeprom(void);                   // <-- Appends the TzBlock & TzSchedule to the TzJournal
+        int legacyByte;                             // <-- EEPROM location of a legacy TzBlock being moved into the TzJournal (-1 = none)
+        int legacyLength;                           // <-- Bytes of the legacy TzBlock (& TzSchedule) ... the new ring may overwrite them
+        TzRule rule;                                // <-- Compiled schedule.rule (when the zone's POSIX TZ rule is known)
+        void applyRule(TzRule&, TzBlock&, TzSchedule&, time_t);  // <-- Computes a TzBlock's transitions & TzSchedule from a rule
+        int findZoneRule(const char* id, char* rule, int ruleSize); // <-- Searches the built-in zone table (TZCFG_ZONE_TABLE)
+        int findGeoZone(float lat, float lng, char* id, int idSize);  // <-- Searches the geographic index (TZCFG_GEO_INDEX)
+        bool overlapsTzEeprom(int sb, int length);  // <-- Returns true when EEPROM sb ... sb+length-1 overlaps TzCfg's region, TzJournal or legacy TzBlock
+        TzGpsCache gpsCache;                        // <-- Time zone IDs of recently resolved positions
+        TzSet* zones;                               // <-- Additional time zones refreshed by maintainLocalTime() (NULL = none)
+        int lookupZone;                             // <-- TzSet zone being looked up (-1 = the device's zone)
+        void refreshZones(void);                    // <-- Refreshes the TzSet zones that are due
+        void finishZone(void);                      // <-- Stores the result of a TzSet zone lookup
+        void (*refreshCallback)(int);               // <-- Called with the result when a lookup completes
+        void startLocalTime(uint8_t, int zone = -1);    // <-- Starts a non-blocking lookup (advanced by poll()) for the device's zone, or a TzSet zone
+        void startQuery(void);                      // <-- Starts the HTTP query for the current lookup pass
+        void parseQuery(void);                      // <-- Processes the HTTP response for the current lookup pass
+        void parseIpQuery(void);                    // <-- Processes the IP provider's response (pass 0 of a lookup by IP)
+        int finishLocalTime(void);                  // <-- Updates EEPROM & device settings when a lookup ends
+        uint32_t refreshSeed;                       // <-- Hash of the device ID ... spreads a fleet's refreshes and retries
+        uint8_t refreshFailures;                    // <-- Consecutive failed refreshes of the device's zone (sets the retry backoff)
+        time_t rateLimitWait;                       // <-- Seconds the server asked the lookup in progress to wait (0 = not rate limited)
+        time_t refreshJitter(time_t span, uint32_t salt);   // <-- Returns this device's spread (0 ... span-1) for a refresh or retry
+        time_t retryDelay(uint8_t failures);        // <-- Returns the interval before the next retry of a failed refresh
+        time_t batchRefresh(time_t refresh);        // <-- Moves a refresh that falls near a transition to the transition
+        void applyTransitions(time_t now);          // <-- Applies every transition that is due (one EEPROM write)
+        TzError lastError;                          // <-- Result of the last lookup (statusMsg describes it)
+        #ifndef TZCFG_NO_METRICS
+        TzMetrics metrics;                          // <-- Counters & timers (see getMetrics())
+        #endif
 	public:
-        void begin();                               // <-- TzCfg constructor renamed for code placenent flexibility.
+        void begin(int sb = -1);                    // <-- TzCfg constructor renamed for code placenent flexibility (sb: TzCfg's EEPROM region ... see TzCfg.cpp)
         void setApiKey_timezonedb(char*);           // <-- Sets the timezonedb API key (tzdbApiKey)
+        void setZoneProvider(const TzProvider* p);  // <-- Selects the server for lookups by zone ID & position (NULL = timezonedb)
+        void setIpProvider(const TzProvider* p);    // <-- Selects the server for lookups by IP (NULL = ip-api)
         void maintainLocalTime(void);               // <-- Maintains the devices local time settings
+        int poll(void);                             // <-- Advances a pending lookup by one non-blocking step
+        void resume(void);                          // <-- Call after waking from sleep ... catches up missed transitions & refreshes
+        time_t nextDeadline(void);                  // <-- Returns the time when maintainLocalTime() is next needed (sleep until then)
+        uint8_t getRefreshFailures(void);           // <-- Returns the number of consecutive failed refreshes
+        int getRefreshStatus(void);                 // <-- Returns TZ_PENDING, EXIT_SUCCESS or EXIT_FAILURE for the last lookup
+        void setRefreshCallback(void (*)(int));     // <-- Sets a function to be called when a lookup completes
         char* getTimezone(void);                    // <-- Returns the current time zone ID
         char* getTimezoneAbbr(void);                // <-- Returns the current time zone Abbreviation
         int setTimezoneByID(char* id);              // <-- Changes the current time zone ID and device settings
         int setTimezoneByGPS(float,float);          // <-- Sets the timezone based on GPS coordinates
-        int setTimezoneByIP(void);                  // <-- Queries for the IP address & timezoneID, then invokes setZoneByID
+        void setGpsCachePrecision(uint8_t bits);    // <-- Sets the GPS cache's geohash cell precision (clears the cache)
+        void setGpsCacheEepromByte(int sb);         // <-- Persists the GPS cache in EEPROM at location sb (-1 = RAM only)
+        uint32_t getGpsCacheHits(void);             // <-- Returns the number of GPS lookups resolved by the cache
+        uint32_t getGpsCacheMisses(void);           // <-- Returns the number of GPS lookups not resolved by the cache
+        uint32_t getEepromBytesWritten(void);       // <-- Returns the number of EEPROM bytes written since begin()
+        uint32_t getEepromWriteRanges(void);        // <-- Returns the number of EEPROM byte ranges written since begin()
+        void setTimezoneSet(TzSet* zones);          // <-- Has maintainLocalTime() refresh a TzSet's zones (NULL = none)
+        void convertBatch(const time_t* in, time_t* out, size_t n);    // <-- Converts an array of UTC timestamps to local time
+        int setTimezoneByIP(void);                  // <-- Queries for the IP address & timezoneID, then looks the zone up by ID (as setTimezoneByID)
+        int setTimezoneByRule(char* id, char* rule);// <-- Sets the timezone from a POSIX TZ rule ... no HTTP required
         void setEepromStartByte(int sb);            // <-- Sets the location of the tzBlock in EEPROM
         int setNextTransitionTime(time_t time);     // <-- Allows testers to schedule test DST transitions
 		int setNextRefreshTime(time_t time);		// <-- Allows testers to schedule test EEPROM refreshes
         void transitionNow(void);                   // <-- For testing: Performs a a pending transition instantly 
 		void eraseTzEeprom(void);                   // <-- Overwrites a TzBlock in EEPROM with '0xFF'
 		char* getHttpStatus(void);                  // <-- Returns the HTTP Status Message
+        TzError getLastError(void);                 // <-- Returns the result of the last lookup as an error code (TZ_OK = success)
+        #ifndef TZCFG_NO_METRICS
+        const TzMetrics& getMetrics(void);          // <-- Returns the counters & timers
+        void resetMetrics(void);                    // <-- Zeroes the counters & timers
+        #endif
 		char* getLocalIP(void);                     // <-- Returns the IP address used to set the time zone
         time_t getNextTransitionTime(void);         // <-- Returns the time when the next DST transition will take place
         time_t getNextRefreshTime(void);            // <-- Returns the time when the next EEPROM refresh will take place
 		
     private:
         void updateDeviceSettings(void);            // <-- Updates the device's local time settings
-        int searchForTzEeprom(void);                // <-- Searches EEPROM for the presence of a TzBlock
-};
-
-
-// ------------------------------------------------------------------- Http Class
-// Handles communication with the HTTP server
-class Http {
-    private:
-        TCPClient client;                   // <-- Stores the TCPClient object used to perform the HTTP POST transaction
-        char buffer[768];                   // <-- Buffer where the HTTP server's response is stored
-        bool error;                         // <-- Error flag used while processing HTTP
-        int statusCode;                     // <-- HTTP status code returned
-        unsigned int bufferIndex;           // <-- Index to the buffer defined above
-        unsigned long lastReadMillis;       // <-- Time when the last character was received from the host
-        unsigned long startMillis;          // <-- Time when the POST transaction was sent to the server
-        char* cpJson;
-        Http();
-        int getJson(char* hostName, int hostPort, char* hostPath, char*& jsonStr, uint& jsonSize, char* errorMsg, int errMsgSize);  // <-- Performs the HTTP processing
-        
-        friend class TzCfg;
+        int searchForTzEeprom(void);                // <-- Searches EEPROM for a TzBlock stored without a TzJournal (legacy layout)
 };
 
-// Http is instantiated in TzCfg.cpp --- 
-
-
-// ------------------------------------------------------------------- Json Class
-// Provides methods used to encode and decode JSON
-class Json {
-    private:
-        Json();
-        void fix(char* json, int jsonSize);                     // <-- prepares JSON for parsing
-        int get(float& n, char* json, char* name);              // <-- Gets a floating-point value for the associated JSON name
-        int get(time_t& n, char* json, char* name);             // <-- Gets a time_t value for the associated JSON name
-        int get(char* ca, int caSize, char* json, char* name);  // <-- Gets a character array for the associated JSON name
-
-        friend class TzCfg;
-};
 
 #endif
 
@@ -0,0 +1,66 @@
+#include "TzCfg.h"
+#ifdef TZCFG_GEO_INDEX
+#include "TzGeo.h"
+#endif
+
+/*      Library: TzCfg
+        Module: TzGeo.cpp resolves GPS coordinates to a time zone ID using the
+        geographic index (src/TzGeo.h, generated by tools/TzGeoGen.py).
+
+        The index is only compiled when TZCFG_GEO_INDEX is defined (see TzCfg.h).
+        The coordinates select one grid cell. Most cells lie inside a single zone
+        and resolve immediately; the others list the polygons that overlap them,
+        and a point-in-polygon test (even-odd rule, so holes are honored) is
+        performed on those polygons whose bounding box contains the point.
+*/
+
+// ---------------------------------------------------------------------------- findGeoZone()
+// Copies the time zone ID for the specified coordinates into 'id'
+//      Returns EXIT_SUCCESS if the coordinates are covered by the index, else EXIT_FAILURE
+int TzCfg::findGeoZone(float lat, float lng, char* id, int idSize) {
+#ifdef TZCFG_GEO_INDEX
+    if ((lat < -90) || (lat > 90) || (lng < -180) || (lng > 180)) return EXIT_FAILURE;
+    int row = (int)((lat + 90) / TZ_GEO_CELL);
+    int col = (int)((lng + 180) / TZ_GEO_CELL);
+    if (row >= TZ_GEO_ROWS) row = TZ_GEO_ROWS - 1;
+    if (col >= TZ_GEO_COLS) col = TZ_GEO_COLS - 1;
+    uint16_t cell = tzGeoCells[(row * TZ_GEO_COLS) + col];
+    int zone = -1;
+    if (cell == 0xFFFF) {
+        return EXIT_FAILURE;
+    } else if (cell & 0x8000) {
+        zone = cell & 0x7FFF;
+    } else {
+        // quantize the point the same way the vertices were quantized
+        float flat = lat * (32767.0f / 90.0f);
+        float flng = lng * (32767.0f / 180.0f);
+        long qlat = (long)(flat + ((flat < 0) ? -0.5f : 0.5f));
+        long qlng = (long)(flng + ((flng < 0) ? -0.5f : 0.5f));
+        const uint16_t* cp = &tzGeoCellPolys[cell];
+        for (int i = 1; (i <= cp[0]) && (zone < 0); i++) {
+            const int16_t* poly = &tzGeoPolys[cp[i] * 7];
+            if ((qlat < poly[3]) || (qlng < poly[4]) || (qlat > poly[5]) || (qlng > poly[6])) continue;
+            bool in = false;
+            for (int r = poly[1]; r < poly[1] + poly[2]; r++) {
+                const int16_t* v = &tzGeoVertices[tzGeoRings[r * 2] * 2];
+                int count = tzGeoRings[(r * 2) + 1];
+                for (int a = 0, b = count - 1; a < count; b = a++) {
+                    long ya = v[a * 2], xa = v[(a * 2) + 1];
+                    long yb = v[b * 2], xb = v[(b * 2) + 1];
+                    if (((ya > qlat) != (yb > qlat)) && (qlng < ((xb - xa) * (qlat - ya) / (float)(yb - ya)) + xa)) {
+                        in = !in;
+                    }
+                }
+            }
+            if (in) zone = poly[0];
+        }
+        if (zone < 0) return EXIT_FAILURE;
+    }
+    strncpy(id, &tzGeoZones[tzGeoZoneIDs[zone]], idSize);
+    id[idSize - 1] = '\0';
+    TZ_LOG_CFG(TZ_LEVEL_DEBUG, "Geo index: %.4f, %.4f = %s", lat, lng, id);
+    return EXIT_SUCCESS;
+#else
+    return EXIT_FAILURE;
+#endif
+}
@@ -0,0 +1,126 @@
+#include "TzCfg.h"
+
+/*      Library: TzCfg
+        Module: TzGpsCache.cpp remembers the time zones of recently resolved positions.
+
+        Positions are reduced to geohash cells (latitude and longitude bits
+        interleaved, 'bits' bits in all). A position that falls in a cached cell
+        resolves to the cached zone ID with no network traffic, so a mobile
+        device only queries when it enters a cell it has not seen recently.
+        Entries expire after tzGpsCacheTtl seconds and are replaced least
+        recently used first.
+
+        The cache lives in RAM, and is optionally persisted in EEPROM
+        (see TzCfg::setGpsCacheEepromByte()). An insert stores only the
+        entry it replaced (each entry carries its own expiry and LRU time),
+        so a miss costs one entry of EEPROM wear, not the whole cache. The
+        stored image has fixed-width fields (times as uint32_t UTC seconds)
+        and explicit padding, so its layout does not depend on the compiler.
+*/
+
+// ---------------------------- Class Constructor ---------------------------------
+
+TzGpsCache::TzGpsCache(void) {
+    this->hits = 0;
+    this->misses = 0;
+    this->eepromByte = -1;
+    clear(tzGpsCacheBits);
+}
+
+// ------------------------------------------------------------------ clear()
+// Empties the cache, and sets the cell precision (even number of bits, 2 to 32)
+void TzGpsCache::clear(uint8_t bits) {
+    memset(&this->data, 0, sizeof(this->data));
+    strncpy(this->data.signature, TZ_GPS_CACHE_SIGNATURE, sizeof(this->data.signature));
+    if (bits < 2) bits = 2;
+    if (bits > 32) bits = 32;
+    this->data.bits = bits & ~1;
+}
+
+// ------------------------------------------------------------------ cellOf()
+// Returns the geohash cell that contains the specified position
+uint32_t TzGpsCache::cellOf(float lat, float lng) {
+    float latLo = -90, latHi = 90, lngLo = -180, lngHi = 180;
+    uint32_t cell = 0;
+    for (int i = 0; i < this->data.bits; i++) {
+        float mid;
+        cell <<= 1;
+        if ((i & 1) == 0) {
+            mid = (lngLo + lngHi) / 2;
+            if (lng >= mid) { cell |= 1; lngLo = mid; } else { lngHi = mid; }
+        } else {
+            mid = (latLo + latHi) / 2;
+            if (lat >= mid) { cell |= 1; latLo = mid; } else { latHi = mid; }
+        }
+    }
+    return cell;
+}
+
+// ------------------------------------------------------------------ find()
+// Copies the cached zone ID for the position into 'id'
+//      Returns EXIT_SUCCESS on a hit, else EXIT_FAILURE
+int TzGpsCache::find(float lat, float lng, time_t now, char* id, int idSize) {
+    uint32_t cell = cellOf(lat, lng);
+    for (int i = 0; i < tzGpsCacheSize; i++) {
+        if (((time_t)this->data.entry[i].expires > now) && (this->data.entry[i].cell == cell)) {
+            this->data.entry[i].used = (uint32_t)now;
+            strncpy(id, this->data.entry[i].id, idSize);
+            id[idSize - 1] = '\0';
+            this->hits++;
+            return EXIT_SUCCESS;
+        }
+    }
+    this->misses++;
+    return EXIT_FAILURE;
+}
+
+// ------------------------------------------------------------------ insert()
+// Caches the zone ID for the position's cell ... in the entry that already holds the cell, else the
+// first expired (or empty) entry, else the least recently used entry
+void TzGpsCache::insert(float lat, float lng, time_t now, const char* id) {
+    uint32_t cell = cellOf(lat, lng);
+    int slot = -1;
+    for (int i = 0; (i < tzGpsCacheSize) && (slot < 0); i++) {
+        if ((this->data.entry[i].expires != 0) && (this->data.entry[i].cell == cell)) slot = i;
+    }
+    for (int i = 0; (i < tzGpsCacheSize) && (slot < 0); i++) {
+        if ((time_t)this->data.entry[i].expires <= now) slot = i;
+    }
+    if (slot < 0) {
+        slot = 0;
+        for (int i = 1; i < tzGpsCacheSize; i++) {
+            if (this->data.entry[i].used < this->data.entry[slot].used) slot = i;
+        }
+    }
+    this->data.entry[slot].cell = cell;
+    this->data.entry[slot].used = (uint32_t)now;
+    this->data.entry[slot].expires = (uint32_t)(now + tzGpsCacheTtl);
+    strncpy(this->data.entry[slot].id, id, sizeof(this->data.entry[slot].id));
+    this->data.entry[slot].id[sizeof(this->data.entry[slot].id) - 1] = '\0';
+    save(slot);
+}
+
+// ------------------------------------------------------------------ load()
+// Persists the cache at EEPROM location 'sb' (-1 = RAM only), loading any cache already stored there
+void TzGpsCache::load(int sb) {
+    this->eepromByte = sb;
+    if (sb < 0) return;
+    uint8_t bits = this->data.bits;
+    EEPROM.get(sb, this->data);
+    if ((strcmp(this->data.signature, TZ_GPS_CACHE_SIGNATURE) != 0) || (this->data.bits != bits)) {
+        clear(bits);
+        save();
+    }
+}
+
+// ------------------------------------------------------------------ save()
+// Stores the whole cache in EEPROM, or only entry 'slot' (>= 0)
+void TzGpsCache::save(int slot) {
+    if (this->eepromByte < 0) return;
+    if (slot < 0) {
+        EEPROM.put(this->eepromByte, this->data);
+    } else {
+        int offset = (int)((uint8_t*)&this->data.entry[slot] - (uint8_t*)&this->data);
+        EEPROM.put(this->eepromByte + offset, this->data.entry[slot]);
+    }
+}
@@ -0,0 +1,350 @@
+#include "TzCfg.h"
+#include <stddef.h>
+
+/*      Library: TzCfg
+        Module: TzJournal.cpp stores the TzBlock & TzSchedule in EEPROM as a
+        log-structured ring of records.
+
+        Each record is a TzJournalHeader followed by a TzRecord (the packed
+        TzBlock and TzSchedule). An update never overwrites the current record ... it is
+        written to the next slot in the ring with the next sequence number,
+        so EEPROM writes are spread across tzJournalSlots slots, and a write
+        interrupted by a power failure (detected by its CRC) leaves the
+        previous record in place.
+
+        The TzDirectory records the location of the ring, so begin() reads the
+        directory and the tzJournalSlots slots ... regardless of EEPROM size.
+        It is only kept when the application gives TzCfg a region of its own
+        (begin(sb): the directory at sb, then the ring ... tzEepromSize bytes);
+        otherwise, or when the directory is missing (a ring or TzBlock written
+        by an earlier version of the library), EEPROM is scanned once, for
+        both the ring and a legacy TzBlock. The valid
+        record with the highest sequence number is current. Every record header
+        also records the location of the ring, so finding any record locates
+        the whole ring.
+
+        A ring is only started where it overwrites nothing but erased bytes
+        (0xFF), its own records, and the legacy TzBlock it replaces (see
+        claimable()) ... the ring is larger than the 128-byte TzBlock, and the
+        bytes after a TzBlock may hold the application's data.
+
+        Records are written with update(), which compares each byte with the
+        image already in EEPROM and rewrites only the bytes that changed. A
+        slot usually held the same zone a few updates ago, so the zone ID and
+        the rule are not rewritten, and the record is packed against the image
+        it overwrites (TzRecord::pack()), so the transitions still scheduled
+        stay where they are. Once every slot holds the schedule, a transition
+        rewrites ~6 bytes: the header's sequence number and CRC, the mask of
+        the transition entries, and the current offset and abbreviation.
+*/
+
+// ---------------------------- Class Constructor ---------------------------------
+
+TzJournal::TzJournal(void) {
+    this->base = -1;
+    this->slot = 0;
+    this->sequence = 0;
+    this->foundViaDirectory = false;
+    this->slots = tzJournalSlots;
+    this->ownsDirectoryEntry = true;
+    this->directoryByte = -1;
+    this->legacyFound = -1;
+    this->bytesWritten = 0;
+    this->rangesWritten = 0;
+    TZ_METRIC(this->metrics = NULL);
+}
+
+// ------------------------------------------------------------------ recordSize()
+int TzJournal::recordSize(void) {
+    return sizeof(TzJournalHeader) + tzRecordSize;
+}
+
+// ------------------------------------------------------------------ size()
+int TzJournal::size(void) {
+    return this->slots * recordSize();
+}
+
+// ------------------------------------------------------------------ address()
+int TzJournal::address(uint8_t slot) {
+    return this->base + (slot * recordSize());
+}
+
+// ------------------------------------------------------------------ directoryAddress()
+int TzJournal::directoryAddress(void) {
+    return this->directoryByte;
+}
+
+// ------------------------------------------------------------------ lastBase()
+int TzJournal::lastBase(void) {
+    return EEPROM.length() - size();
+}
+
+// ------------------------------------------------------------------ claimable()
+// Returns true when a ring at 'base' fits in EEPROM, and every byte it covers is erased (0xFF),
+// in a slot that already belongs to the ring, or in the range [keep, keep + keepLength)
+bool TzJournal::claimable(int base, int keep, int keepLength) {
+    if ((base < 0) || (base > lastBase())) return false;
+    for (uint8_t i = 0; i < this->slots; i++) {
+        int location = base + (i * recordSize());
+        TzJournalHeader h;
+        EEPROM.get(location, h);
+        if ((memcmp(h.signature, TZ_JOURNAL_SIGNATURE, sizeof(h.signature)) == 0) && (h.base == base) && (h.slots == this->slots)) continue;
+        for (int b = location; b < location + recordSize(); b++) {
+            if ((EEPROM.read(b) != 0xFF) && ((b < keep) || (b >= keep + keepLength))) {
+                TZ_LOG_EEPROM(TZ_LEVEL_ERROR, "EEPROM location %d is in use ... no TzJournal @ %d", b, base);
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+// ------------------------------------------------------------------ locate()
+void TzJournal::locate(int base) {
+    if (base != this->base) {
+        this->base = base;
+        this->foundViaDirectory = false;
+    }
+    this->sequence = 0;
+    this->slot = 0;
+}
+
+// ------------------------------------------------------------------ find()
+// Locates the ring, then selects its newest valid record
+//      Returns EXIT_SUCCESS when a valid record is found, else EXIT_FAILURE
+int TzJournal::find(void) {
+    TZ_METRIC(unsigned long start = micros());
+    this->sequence = 0;
+    this->foundViaDirectory = readDirectory();
+    if ( !this->foundViaDirectory) {
+        int found = search();
+        TZ_METRIC(if (this->metrics != NULL) this->metrics->eepromReadMicros += micros() - start);
+        if (found == EXIT_FAILURE) return EXIT_FAILURE;
+        TZ_METRIC(start = micros());
+    }
+    select();
+    TZ_METRIC(if (this->metrics != NULL) this->metrics->eepromReadMicros += micros() - start);
+    TZ_LOG_EEPROM(TZ_LEVEL_INFO, "Found @ Location %d (%s), newest record: slot %d, sequence %lu",
+        this->base, this->foundViaDirectory ? "directory" : "scan", this->slot, (unsigned long)this->sequence);
+    if (this->sequence == 0) return EXIT_FAILURE;
+    if ( !this->foundViaDirectory) writeDirectory();
+    return EXIT_SUCCESS;
+}
+
+// ------------------------------------------------------------------ search()
+// Scans EEPROM for a TzJournal record written before the TzDirectory existed. The same pass notes
+// the last TzBlock stored without a TzJournal (legacyFound) ... so EEPROM is read once when neither is found.
+//      Returns EXIT_SUCCESS when the ring is located, else EXIT_FAILURE
+int TzJournal::search(void) {
+    // A small buffer is used to minimize memory usage ... consecutive reads overlap by a signature.
+    char buffer[128];
+    const int signature = sizeof(TZ_SIGNATURE) - 1;    // <-- the longer of the two signatures
+    int length = EEPROM.length();
+    // A record can start anywhere from zero to (EEPROM storage size - record size), a TzBlock (and its TzSchedule) a little before
+    int endUsableRange = length - recordSize();
+    int legacyEnd = length - (int)(sizeof(TzBlock) + sizeof(TzSchedule));
+    int rangeIndex = 0;
+    this->base = -1;
+    this->sequence = 0;
+    this->legacyFound = -1;
+    if (length < (int)sizeof(buffer)) return EXIT_FAILURE;
+    while ((this->base < 0) && !(rangeIndex > endUsableRange)) {
+        int window = (rangeIndex < length - (int)sizeof(buffer)) ? rangeIndex : length - (int)sizeof(buffer);
+        EEPROM.get(window, buffer);
+        TZ_METRIC(if (this->metrics != NULL) this->metrics->eepromReads++);
+        // both signatures start with '#' ... memchr() skips to the candidates
+        int last = (int)sizeof(buffer) - signature;
+        int i = rangeIndex - window;
+        while (i <= last) {
+            const char* cp = (const char*)memchr(&buffer[i], TZ_SIGNATURE[0], last + 1 - i);
+            i = (cp == NULL) ? last + 1 : cp - buffer;
+            if ((cp == NULL) || (memcmp(cp, TZ_JOURNAL_SIGNATURE, sizeof(TZ_JOURNAL_SIGNATURE)) == 0)
+             || (memcmp(cp, TZ_SIGNATURE, signature) == 0)) break;
+            i++;
+        }
+        int location = window + i;
+        if (i > last) {
+            rangeIndex = location;
+            continue;
+        }
+        rangeIndex = location + 1;
+        if (memcmp(&buffer[i], TZ_SIGNATURE, signature) == 0) {
+            if ( !(location > legacyEnd)) {
+                this->legacyFound = location;
+                TZ_LOG_EEPROM(TZ_LEVEL_INFO, "TzBlock found @ Location %d", location);
+            }
+            continue;
+        }
+        // the header locates the ring ... provided it is consistent with where it was found
+        TzJournalHeader h;
+        EEPROM.get(location, h);
+        if ((h.slots == tzJournalSlots) && (h.base >= 0) && !(h.base > lastBase())
+         && (location >= h.base) && (((location - h.base) % recordSize()) == 0)) {
+            this->base = h.base;
+        }
+    }
+    return (this->base < 0) ? EXIT_FAILURE : EXIT_SUCCESS;
+}
+
+// ------------------------------------------------------------------ select()
+void TzJournal::select(void) {
+    this->sequence = 0;
+    this->slot = 0;
+    for (uint8_t i = 0; i < this->slots; i++) {
+        uint32_t seq;
+        if (valid(i, seq) && (seq > this->sequence)) {
+            this->sequence = seq;
+            this->slot = i;
+        }
+    }
+}
+
+// ------------------------------------------------------------------ readDirectory()
+// Returns true (and sets the ring's location) when the TzDirectory is valid
+bool TzJournal::readDirectory(void) {
+    TzDirectory d;
+    if (this->directoryByte < 0) return false;
+    EEPROM.get(directoryAddress(), d);
+    TZ_METRIC(if (this->metrics != NULL) this->metrics->eepromReads++);
+    if ((memcmp(d.signature, TZ_DIRECTORY_SIGNATURE, sizeof(d.signature)) != 0) || (d.version != tzDirectoryVersion)
+     || (d.slots != tzJournalSlots) || (d.length != size()) || (d.offset < 0) || (d.offset > lastBase())) return false;
+    uint16_t crc = 0xFFFF;
+    for (unsigned int i = 0; i < offsetof(TzDirectory, crc); i++) crc = crc16(crc, ((uint8_t*)&d)[i]);
+    if (crc != d.crc) return false;
+    this->base = d.offset;
+    return true;
+}
+
+// ------------------------------------------------------------------ writeDirectory()
+void TzJournal::writeDirectory(void) {
+    TzDirectory d;
+    if (this->directoryByte < 0) return;
+    memcpy(d.signature, TZ_DIRECTORY_SIGNATURE, sizeof(d.signature));
+    d.version = tzDirectoryVersion;
+    d.slots = tzJournalSlots;
+    d.offset = this->base;
+    d.length = size();
+    d.reserved[0] = d.reserved[1] = 0xFF;
+    d.crc = 0xFFFF;
+    for (unsigned int i = 0; i < offsetof(TzDirectory, crc); i++) d.crc = crc16(d.crc, ((uint8_t*)&d)[i]);
+    update(directoryAddress(), &d, sizeof(d));
+    this->foundViaDirectory = true;
+}
+
+// ------------------------------------------------------------------ valid()
+// Returns true when the slot holds a complete record (returning its sequence number)
+bool TzJournal::valid(uint8_t slot, uint32_t& sequence) {
+    TzJournalHeader h;
+    int location = address(slot);
+    EEPROM.get(location, h);
+    TZ_METRIC(if (this->metrics != NULL) this->metrics->eepromReads++);
+    if ((memcmp(h.signature, TZ_JOURNAL_SIGNATURE, sizeof(h.signature)) != 0)
+     || (h.base != this->base) || (h.slots != this->slots) || (h.format != tzRecordFormat) || (h.sequence == 0)) return false;
+    uint16_t crc = 0xFFFF;
+    for (int i = offsetof(TzJournalHeader, sequence); i < recordSize(); i++) {
+        crc = crc16(crc, EEPROM.read(location + i));
+    }
+    sequence = h.sequence;
+    return (crc == h.crc);
+}
+
+// ------------------------------------------------------------------ load()
+// Reads the newest record ... returns false if its TzRecord is malformed
+bool TzJournal::load(TzBlock& blk, TzSchedule& sched) {
+    TzRecord rec;
+    TZ_METRIC(unsigned long start = micros());
+    EEPROM.get(address(this->slot) + sizeof(TzJournalHeader), rec.data);
+    TZ_METRIC(
+        if (this->metrics != NULL) {
+            this->metrics->eepromReads++;
+            this->metrics->eepromReadMicros += micros() - start;
+        }
+    )
+    return rec.unpack(blk, sched);
+}
+
+// ------------------------------------------------------------------ write()
+// Writes the TzBlock & TzSchedule to the slot after the newest record.
+// The header (and its CRC) is written last, so the record only becomes valid once it is complete.
+void TzJournal::write(TzBlock& blk, TzSchedule& sched) {
+    if (this->base < 0) return;
+    TZ_METRIC(unsigned long start = micros());
+    TzJournalHeader h;
+    TzRecord rec, prior;
+    uint8_t next = (this->sequence == 0) ? 0 : (this->slot + 1) % this->slots;
+    int location = address(next);
+    EEPROM.get(location + sizeof(TzJournalHeader), prior.data);
+    rec.pack(blk, sched, &prior);
+    memcpy(h.signature, TZ_JOURNAL_SIGNATURE, sizeof(h.signature));
+    h.sequence = this->sequence + 1;
+    h.base = this->base;
+    h.slots = this->slots;
+    h.format = tzRecordFormat;
+    h.crc = 0xFFFF;
+    for (unsigned int i = offsetof(TzJournalHeader, sequence); i < sizeof(h); i++) h.crc = crc16(h.crc, ((uint8_t*)&h)[i]);
+    for (unsigned int i = 0; i < sizeof(rec.data); i++) h.crc = crc16(h.crc, rec.data[i]);
+    // A slot the ring has not used yet is claimed first (a header with sequence 0 is never valid),
+    // so the bytes of an interrupted first write are still recognized as the ring's own
+    TzJournalHeader claim;
+    EEPROM.get(location, claim);
+    if ((memcmp(claim.signature, h.signature, sizeof(h.signature)) != 0) || (claim.base != h.base) || (claim.slots != h.slots)) {
+        claim = h;
+        claim.sequence = 0;
+        update(location, &claim, sizeof(claim));
+    }
+    update(location + sizeof(TzJournalHeader), rec.data, sizeof(rec.data));
+    update(location, &h, sizeof(h));
+    if (this->ownsDirectoryEntry && !this->foundViaDirectory) writeDirectory();
+    this->slot = next;
+    this->sequence = h.sequence;
+    TZ_METRIC(
+        if (this->metrics != NULL) {
+            this->metrics->eepromWrites++;
+            this->metrics->eepromWriteMicros += micros() - start;
+        }
+    )
+    TZ_LOG_EEPROM(TZ_LEVEL_INFO, "Record %lu written to slot %d (EEPROM location %d), %lu bytes written since begin()",
+        (unsigned long)this->sequence, next, location, (unsigned long)this->bytesWritten);
+}
+
+// ------------------------------------------------------------------ erase()
+void TzJournal::erase(void) {
+    if (this->base < 0) return;
+    uint8_t erased[16];
+    memset(erased, 0xFF, sizeof(erased));
+    for (int i = 0; i < size(); i += sizeof(erased)) {
+        update(this->base + i, erased, ((size() - i) < (int)sizeof(erased)) ? (size() - i) : sizeof(erased));
+    }
+    this->sequence = 0;
+    this->slot = 0;
+}
+
+// ------------------------------------------------------------------ update()
+// Writes the bytes that differ from the EEPROM image at 'location' ... unchanged bytes are skipped
+void TzJournal::update(int location, const void* data, int length) {
+    const uint8_t* bytes = (const uint8_t*)data;
+    bool dirty = false;
+    for (int i = 0; i < length; i++) {
+        if (EEPROM.read(location + i) != bytes[i]) {
+            EEPROM.write(location + i, bytes[i]);
+            this->bytesWritten++;
+            TZ_METRIC(if (this->metrics != NULL) this->metrics->eepromBytesWritten++);
+            if ( !dirty) this->rangesWritten++;
+            dirty = true;
+        } else {
+            dirty = false;
+        }
+    }
+}
+
+// ------------------------------------------------------------------ crc16()
+// CRC-16/CCITT, a nibble at a time (a 32-byte table ... begin() checks every slot of the ring)
+uint16_t TzJournal::crc16(uint16_t crc, uint8_t b) {
+    static const uint16_t nibble[16] = {
+        0x0000, 0x1021, 0x2042, 0x3063, 0x4084, 0x50A5, 0x60C6, 0x70E7,
+        0x8108, 0x9129, 0xA14A, 0xB16B, 0xC18C, 0xD1AD, 0xE1CE, 0xF1EF
+    };
+    crc = (uint16_t)((crc << 4) ^ nibble[(crc >> 12) ^ (b >> 4)]);
+    crc = (uint16_t)((crc << 4) ^ nibble[(crc >> 12) ^ (b & 0x0F)]);
+    return crc;
+}
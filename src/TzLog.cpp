@@ -0,0 +1,64 @@
+#include "TzCfg.h"
+#include <stdarg.h>
+
+/*      Library: TzCfg
+        Module: TzLog.cpp buffers the library's log messages.
+
+        Each module logs through its own macro (TZ_LOG_CFG, TZ_LOG_HTTP,
+        TZ_LOG_EEPROM) and level (tzLogCfg, tzLogHttp, tzLogEeprom). The
+        level test is a compile-time constant, so a message above its
+        module's level, its format string and its arguments are removed
+        by the compiler.
+
+        A message that is logged is formatted into a ring buffer (string
+        arguments may not outlive the call), and written to Serial by
+        flush(), which TzCfg calls when no lookup is in progress. Logging
+        therefore never blocks on Serial inside an HTTP transaction. When
+        the buffer is full, messages are dropped (and counted) rather than
+        waiting for it to drain.
+*/
+
+uint32_t TzLog::dropped = 0;
+
+#if TZCFG_LOG_LEVEL > TZ_LEVEL_NONE
+char TzLog::ring[tzLogBufferSize];
+unsigned int TzLog::head = 0;
+unsigned int TzLog::tail = 0;
+#endif
+
+// ------------------------------------------------------------------ write()
+// Formats "tag>\tmessage\r\n" into the ring buffer
+void TzLog::write(const char* tag, const char* format, ...) {
+    #if TZCFG_LOG_LEVEL > TZ_LEVEL_NONE
+        char line[tzLogLineSize];
+        int n = snprintf(line, sizeof(line) - 2, "%s>\t", tag);
+        va_list args;
+        va_start(args, format);
+        vsnprintf(line + n, sizeof(line) - 2 - n, format, args);
+        va_end(args);
+        n = strlen(line);
+        line[n++] = '\r';
+        line[n++] = '\n';
+        unsigned int used = (head + tzLogBufferSize - tail) % tzLogBufferSize;
+        if ((unsigned int)n > (tzLogBufferSize - 1 - used)) {
+            dropped++;
+            return;
+        }
+        for (int i = 0; i < n; i++) {
+            ring[head] = line[i];
+            head = (head + 1) % tzLogBufferSize;
+        }
+    #endif
+}
+
+// ------------------------------------------------------------------ flush()
+// Writes the buffered messages to Serial
+void TzLog::flush(void) {
+    #if TZCFG_LOG_LEVEL > TZ_LEVEL_NONE
+        while (tail != head) {
+            unsigned int end = (head > tail) ? head : tzLogBufferSize;   // <-- one contiguous run at a time
+            Serial.write((const uint8_t*)&ring[tail], end - tail);
+            tail = end % tzLogBufferSize;
+        }
+    #endif
+}
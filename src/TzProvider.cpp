@@ -0,0 +1,256 @@
+#include "TzCfg.h"
+
+/*      Library: TzCfg
+        Module: TzProvider.cpp describes the time zone servers TzCfg can query.
+
+        A TzProvider is a table: the server's host, the paths of its lookups
+        (with placeholders for the API key, zone ID, position and time) and
+        the JSON names of the fields TzCfg reads from its responses. The
+        lookup code works from the table alone, so a server with the same
+        kind of response ... e.g. a fleet's caching proxy in front of
+        timezonedb ... needs a table, not code.
+
+        A provider without a timeQuery answers a lookup in one response. Its
+        <schedule> lists the next transition and those after it as
+        "time,offset,abbr;time,offset,abbr;..." (UTC seconds, offsets in
+        seconds), or its <rule> gives the zone's POSIX TZ rule. jsonSchedule
+        holds tzScheduleSize + 1 entries of the longest form; a <schedule>
+        (or <rule>) that does not fit fails the lookup.
+
+        A provider with a binaryType is offered that Content-Type in the
+        first request's Accept header. It may answer with a compact binary
+        body instead of JSON (typically 40 ... 80 bytes, against ~400), which
+        parseBinary() decodes straight into tzWeb & scheduleWeb. Integers
+        are big-endian, and a string is a length byte followed by that many
+        characters (no terminator):
+
+            u8      format version (tzBinaryVersion)
+            u8      flags: 1 = error, 2 = DST in effect, 4 = rule follows
+            ... error: string message (nothing else follows)
+            i16     current UTC offset (minutes)
+            string  zone ID
+            u8      abbreviation count (1 ... 8), then the abbreviations (strings)
+            u8      current abbreviation (index)
+            ... rule: string POSIX TZ rule (nothing else follows)
+            u8      transition count (0 ... tzScheduleSize + 1), then for each:
+              u32     time (UTC seconds)
+              i16     post-transition UTC offset (minutes)
+              u8      post-transition abbreviation (index)
+
+        Every read is bounds checked against the body, every string against
+        its destination, and every index against the abbreviation count.
+*/
+
+const uint8_t TZ_BIN_ERROR = 1, TZ_BIN_DST = 2, TZ_BIN_RULE = 4;   // <-- binary response flags
+const uint8_t tzBinaryAbbrs = 8;    // <-- Most abbreviations in a binary response
+
+const TzProvider tzProviderTimezonedb = {
+    "timezonedb", "api.timezonedb.com", 80,
+    "/v2/get-time-zone?key=%k&format=json&by=zone&zone=%z",
+    "/v2/get-time-zone?key=%k&format=json&by=position&lat=%a&lng=%o",
+    "&time=%t",
+    "OK",
+    { "status", "message", "gmtOffset", "dst", "dstEnd", "nextAbbreviation", "zoneName", "abbreviation", "", "", "" },
+    NULL
+};
+
+const TzProvider tzProviderIpApi = {
+    "ip-api", "ip-api.com", 80,
+    "/json?fields=status,message,timezone,offset,query",   // <-- only the fields TzCfg uses
+    NULL,
+    NULL,
+    "success",
+    { "status", "message", "offset", "", "", "", "timezone", "", "", "", "query" },
+    NULL
+};
+
+// ---------------------------------------------------------------------------- setZoneProvider()
+// Selects the server for lookups by zone ID & position (NULL = timezonedb)
+void TzCfg::setZoneProvider(const TzProvider* p) {
+    this->zoneProvider = (p != NULL) ? p : &tzProviderTimezonedb;
+    this->tzdbValidator[0] = '\0';  // <-- it belongs to the previous server's response
+}
+
+// ---------------------------------------------------------------------------- setIpProvider()
+// Selects the server for lookups by IP (NULL = ip-api)
+void TzCfg::setIpProvider(const TzProvider* p) {
+    this->ipProvider = (p != NULL) ? p : &tzProviderIpApi;
+}
+
+// ---------------------------------------------------------------------------- zoneLookupReady()
+// Returns true when the zone provider can be queried ... it has the API key its paths need
+bool TzCfg::zoneLookupReady(void) {
+    return (this->tzdbApiKey[0] != '\0') || (strstr(this->zoneProvider->path, "%k") == NULL);
+}
+
+// ---------------------------------------------------------------------------- providerPath()
+// Appends 'pattern' to 'path', replacing %k (API key), %z (zone ID), %a (latitude),
+// %o (longitude) and %t (the time queried by the current lookup pass)
+void TzCfg::providerPath(const char* pattern, char* path, int size) {
+    int n = strlen(path);
+    for (const char* p = pattern; (*p != '\0') && (n < size - 1); p++) {
+        const char* value = NULL;
+        String number;
+        if ((p[0] == '%') && (p[1] != '\0')) {
+            switch (p[1]) {
+                case 'k': value = this->tzdbApiKey; break;
+                case 'z': value = this->newZoneID; break;
+                case 'a': number = String(this->latitude); value = number.c_str(); break;
+                case 'o': number = String(this->longitude); value = number.c_str(); break;
+                case 't': number = String(passTime()); value = number.c_str(); break;
+            }
+        }
+        if (value != NULL) {
+            strncpy(path + n, value, size - n - 1);
+            path[size - 1] = '\0';
+            n = strlen(path);
+            p++;
+        } else {
+            path[n++] = *p;
+            path[n] = '\0';
+        }
+    }
+}
+
+// ---------------------------------------------------------------------------- providerMessage()
+// Sets the status message to a provider's own error message, "(name) message", truncated to fit
+void TzCfg::providerMessage(const TzProvider* p, const char* message, int length) {
+    int room = (int)sizeof(this->statusMsg) - (int)strlen(p->name) - 4;    // <-- "(", ") " & the terminator
+    if (length > room) length = (room > 0) ? room : 0;
+    snprintf(this->statusMsg, sizeof(this->statusMsg), "(%s) %.*s", p->name, length, message);
+}
+
+// ---------------------------------------------------------------------------- parseSchedule()
+// Decodes a provider <schedule> ("time,offset,abbr;...") into the next transition (tzWeb) and
+// the transitions after it (scheduleWeb)
+//      Returns EXIT_SUCCESS, or EXIT_FAILURE if an entry is malformed or out of order, or there are
+//      more entries than tzScheduleSize + 1 (as parseBinary() does ... a schedule is never cut short silently)
+int TzCfg::parseSchedule(const char* text) {
+    const char* p = text;
+    time_t last = 0;
+    int n = 0;
+    this->tzWeb.tranTime = 0;
+    this->scheduleWeb.count = 0;
+    while (*p != '\0') {
+        if (n > tzScheduleSize) {
+            TZ_LOG_CFG(TZ_LEVEL_ERROR, "<schedule> holds more than %d transitions", tzScheduleSize + 1);
+            return EXIT_FAILURE;
+        }
+        char* end;
+        time_t time = strtol(p, &end, 10);
+        if ((end == p) || (*end != ',') || (time <= last)) return EXIT_FAILURE;
+        p = end + 1;
+        long offset = strtol(p, &end, 10);
+        if ((end == p) || (*end != ',')) return EXIT_FAILURE;
+        p = end + 1;
+        int length = strcspn(p, ";");
+        if ((length == 0) || (length > 5)) return EXIT_FAILURE;
+        char* abbr = (n == 0) ? this->tzWeb.tranAbbr : this->scheduleWeb.tran[n - 1].abbr;
+        memcpy(abbr, p, length);
+        abbr[length] = '\0';
+        if (n == 0) {
+            this->tzWeb.tranTime = time;
+            this->tzWeb.tranOffset = (float)offset / 3600;
+        } else {
+            this->scheduleWeb.tran[n - 1].time = time;
+            this->scheduleWeb.tran[n - 1].offset = (float)offset / 3600;
+            this->scheduleWeb.count = n;
+        }
+        last = time;
+        n++;
+        p += length;
+        if (*p == ';') p++;
+    }
+    return EXIT_SUCCESS;
+}
+
+// ---------------------------------------------------------------------------- binRead()
+// Reads a big-endian integer of 'bytes' bytes at 'p' ... returns false if it would read past 'end'
+static bool binRead(const uint8_t*& p, const uint8_t* end, int bytes, uint32_t& value) {
+    if ((end - p) < bytes) return false;
+    value = 0;
+    while (bytes-- > 0) value = (value << 8) | *p++;
+    return true;
+}
+
+// ---------------------------------------------------------------------------- binString()
+// Locates the string at 'p' (in place) ... returns false if it would read past 'end'
+static bool binString(const uint8_t*& p, const uint8_t* end, const uint8_t*& text, int& length) {
+    if (p >= end) return false;
+    length = *p++;
+    if ((end - p) < length) return false;
+    text = p;
+    p += length;
+    return true;
+}
+
+// ---------------------------------------------------------------------------- binCopy()
+// Copies a located string into 'out' ... returns false if it does not fit
+static bool binCopy(const uint8_t* text, int length, char* out, int size) {
+    if (length >= size) return false;
+    memcpy(out, text, length);
+    out[length] = '\0';
+    return true;
+}
+
+// ---------------------------------------------------------------------------- parseBinary()
+// Decodes a provider's compact binary response (layout above) into tzWeb & scheduleWeb
+//      Returns EXIT_SUCCESS, or EXIT_FAILURE if the response reports an error or is malformed
+int TzCfg::parseBinary(const uint8_t* data, int size) {
+    const uint8_t* p = data;
+    const uint8_t* end = data + size;
+    const uint8_t* text;
+    const uint8_t* abbr[tzBinaryAbbrs];
+    uint8_t abbrLength[tzBinaryAbbrs];
+    int length;
+    uint32_t version, flags, value, count, index;
+    if ( !binRead(p, end, 1, version) || (version != tzBinaryVersion) || !binRead(p, end, 1, flags)) return EXIT_FAILURE;
+    if (flags & TZ_BIN_ERROR) {
+        if ( !binString(p, end, text, length)) return EXIT_FAILURE;
+        providerMessage(this->zoneProvider, (const char*)text, length);
+        this->lastError = TZ_E_TZDB_FAIL;
+        return EXIT_FAILURE;
+    }
+    if ( !binRead(p, end, 2, value)) return EXIT_FAILURE;
+    this->tzWeb.curOffset = (float)(int16_t)value / 60;
+    if ( !binString(p, end, text, length) || !binCopy(text, length, this->tzWeb.id, sizeof(this->tzWeb.id))) return EXIT_FAILURE;
+    if ( !binRead(p, end, 1, count) || (count == 0) || (count > tzBinaryAbbrs)) return EXIT_FAILURE;
+    for (uint32_t i = 0; i < count; i++) {
+        if ( !binString(p, end, abbr[i], length) || (length >= (int)sizeof(this->tzWeb.curAbbr))) return EXIT_FAILURE;
+        abbrLength[i] = length;
+    }
+    uint32_t abbrs = count;
+    if ( !binRead(p, end, 1, index) || (index >= abbrs)) return EXIT_FAILURE;
+    binCopy(abbr[index], abbrLength[index], this->tzWeb.curAbbr, sizeof(this->tzWeb.curAbbr));
+    if (flags & TZ_BIN_RULE) {
+        TzRule r;
+        if ( !binString(p, end, text, length) || !binCopy(text, length, this->scheduleWeb.rule, sizeof(this->scheduleWeb.rule))
+          || (r.compile(this->scheduleWeb.rule) != EXIT_SUCCESS)) return EXIT_FAILURE;
+        applyRule(r, this->tzWeb, this->scheduleWeb, Time.now());
+        return EXIT_SUCCESS;
+    }
+    if ( !binRead(p, end, 1, count) || (count > (uint32_t)tzScheduleSize + 1)) return EXIT_FAILURE;
+    this->tzWeb.tranTime = 0;
+    this->scheduleWeb.count = 0;
+    time_t last = 0;
+    for (uint32_t i = 0; i < count; i++) {
+        uint32_t time;
+        if ( !binRead(p, end, 4, time) || !binRead(p, end, 2, value) || !binRead(p, end, 1, index)
+          || (index >= abbrs) || ((time_t)time <= last)) return EXIT_FAILURE;
+        float offset = (float)(int16_t)value / 60;
+        if (i == 0) {
+            this->tzWeb.tranTime = time;
+            this->tzWeb.tranOffset = offset;
+            binCopy(abbr[index], abbrLength[index], this->tzWeb.tranAbbr, sizeof(this->tzWeb.tranAbbr));
+        } else {
+            this->scheduleWeb.tran[i - 1].time = time;
+            this->scheduleWeb.tran[i - 1].offset = offset;
+            binCopy(abbr[index], abbrLength[index], this->scheduleWeb.tran[i - 1].abbr, sizeof(this->scheduleWeb.tran[i - 1].abbr));
+            this->scheduleWeb.count = i;
+        }
+        last = time;
+    }
+    // the standard offset is the current offset, or (during DST) the offset after the next transition
+    this->tzWeb.stdOffset = ((flags & TZ_BIN_DST) && (count > 0)) ? this->tzWeb.tranOffset : this->tzWeb.curOffset;
+    return EXIT_SUCCESS;
+}
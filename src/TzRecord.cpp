@@ -0,0 +1,204 @@
+#include "TzCfg.h"
+
+/*      Library: TzCfg
+        Module: TzRecord.cpp packs a TzBlock & its TzSchedule into the format
+        that TzCfg stores in EEPROM (tzRecordFormat 1).
+
+        The layout does not depend upon the compiler: integers are little-endian,
+        there is no padding, offsets are whole minutes (int16), and strings are
+        length-prefixed and zero-filled.
+
+            Bytes   Field
+              65    zone ID (length + 64 bytes)
+               2    standard offset (minutes)
+               2    current offset (minutes)
+               6    current abbreviation (length + 5 bytes)
+               1    transition mask (bit i set = entry i holds a transition)
+              48    POSIX TZ rule (length + 47 bytes)
+              12    each of (tzScheduleSize + 1) transition entries:
+                        time (4), offset (2, minutes), abbreviation (length + 5 bytes)
+
+        The entries hold the next transition and the TzSchedule in no particular
+        order (the earliest is the next transition). pack() places them in time
+        order, so two records holding the same settings are byte-for-byte
+        identical ... unless it is given the image it will overwrite: then each
+        transition keeps the entry that already holds it, and a new one takes
+        the free entry that differs least. A transition leaves the record
+        without shifting the others, so a record rewrites only the offsets,
+        abbreviation and mask that changed, and the entries of transitions
+        added since the slot was last written.
+
+        A record is 208 bytes, against the 128-byte TzBlock struct that the
+        first versions stored; the rule and the schedule keep transitions
+        rolling for ~3 years without a query and let a refresh stop after one
+        query. The wear benchmark (test/TzJournalBench.cpp) measures both
+        layouts over ten years of America/Chicago. The ring writes more bytes
+        in all: ~970 against ~270 for the TzBlock rewritten in place (~16
+        bytes per record against ~6 once the ring is full, and the first
+        records fill erased slots). It is the trade made for the wear that
+        limits EEPROM life, which is per cell: the writes are spread over
+        the slots, so the busiest byte is written 10 times against 21.
+*/
+
+// ---------------------------- Class Constructor ---------------------------------
+
+TzRecord::TzRecord(void) {
+    memset(this->data, 0, sizeof(this->data));
+    this->position = 0;
+}
+
+// ------------------------------------------------------------------ pack()
+// Packs the settings ... in the entries of 'prior' (the image to be overwritten) when it is given
+void TzRecord::pack(const TzBlock& blk, const TzSchedule& sched, const TzRecord* prior) {
+    memset(this->data, 0, sizeof(this->data));
+    this->position = 0;
+    putString(blk.id, sizeof(blk.id));
+    putInt((uint16_t)tzMinutes(blk.stdOffset), 2);
+    putInt((uint16_t)tzMinutes(blk.curOffset), 2);
+    putString(blk.curAbbr, sizeof(blk.curAbbr));
+    int maskByte = this->position++;
+    putString(sched.rule, sizeof(sched.rule));
+    // the next transition, then the schedule, in the first entries
+    int n = 0;
+    if (blk.tranTime != 0) {
+        putEntry(blk.tranTime, blk.tranOffset, blk.tranAbbr);
+        n++;
+        for (int i = 0; i < sched.count; i++, n++) putEntry(sched.tran[i].time, sched.tran[i].offset, sched.tran[i].abbr);
+    }
+    this->data[maskByte] = (1 << n) - 1;
+    if (prior == NULL) return;
+    // each transition moves to the entry of 'prior' that already holds it, else to the free entry that differs least
+    uint8_t entries[tzScheduleSize + 1][tzRecordEntrySize];
+    int to[tzScheduleSize + 1];
+    bool taken[tzScheduleSize + 1];
+    memcpy(entries, &this->data[tzRecordEntries], sizeof(entries));
+    memset(&this->data[tzRecordEntries], 0, sizeof(entries));
+    for (int j = 0; j <= tzScheduleSize; j++) taken[j] = false;
+    for (int i = 0; i < n; i++) {
+        to[i] = -1;
+        for (int j = 0; (j <= tzScheduleSize) && (to[i] < 0); j++) {
+            if ( !taken[j] && (memcmp(entries[i], prior->entry(j), tzRecordEntrySize) == 0)) to[i] = j;
+        }
+        if (to[i] >= 0) taken[to[i]] = true;
+    }
+    for (int i = 0; i < n; i++) {
+        if (to[i] >= 0) continue;
+        int least = tzRecordEntrySize + 1;
+        for (int j = 0; j <= tzScheduleSize; j++) {
+            if (taken[j]) continue;
+            int d = 0;
+            for (int b = 0; b < tzRecordEntrySize; b++) d += (entries[i][b] != prior->entry(j)[b]);
+            if (d < least) {
+                least = d;
+                to[i] = j;
+            }
+        }
+        taken[to[i]] = true;
+    }
+    this->data[maskByte] = 0;
+    for (int i = 0; i < n; i++) {
+        memcpy(&this->data[tzRecordEntries + (to[i] * tzRecordEntrySize)], entries[i], tzRecordEntrySize);
+        this->data[maskByte] |= 1 << to[i];
+    }
+    // a free entry keeps the bytes already in EEPROM ... the mask says it is unused
+    for (int j = 0; j <= tzScheduleSize; j++) {
+        if ( !taken[j]) memcpy(&this->data[tzRecordEntries + (j * tzRecordEntrySize)], prior->entry(j), tzRecordEntrySize);
+    }
+}
+
+// ------------------------------------------------------------------ unpack()
+// Returns false if the image is malformed (the TzBlock & TzSchedule are then undefined)
+bool TzRecord::unpack(TzBlock& blk, TzSchedule& sched) {
+    blk = TzBlock();
+    sched = TzSchedule();
+    this->position = 0;
+    if ( !getString(blk.id, sizeof(blk.id))) return false;
+    blk.stdOffset = (float)(int16_t)getInt(2) / 60;
+    blk.curOffset = (float)(int16_t)getInt(2) / 60;
+    if ( !getString(blk.curAbbr, sizeof(blk.curAbbr))) return false;
+    uint32_t mask = getInt(1);
+    if ((mask >> (tzScheduleSize + 1)) != 0) return false;
+    if ( !getString(sched.rule, sizeof(sched.rule))) return false;
+    // the entries are read in time order: the earliest is the next transition
+    time_t last = 0;
+    while (mask != 0) {
+        int earliest = -1;
+        time_t time = 0;
+        for (int j = 0; j <= tzScheduleSize; j++) {
+            if ( !(mask & (1 << j))) continue;
+            this->position = tzRecordEntries + (j * tzRecordEntrySize);
+            time_t t = (time_t)getInt(4);
+            if ((earliest < 0) || (t < time)) {
+                earliest = j;
+                time = t;
+            }
+        }
+        if ( !(time > last)) return false;      // <-- a zero or repeated time
+        last = time;
+        mask &= ~(1 << earliest);
+        this->position = tzRecordEntries + (earliest * tzRecordEntrySize) + 4;
+        if (blk.tranTime == 0) {
+            blk.tranTime = time;
+            blk.tranOffset = (float)(int16_t)getInt(2) / 60;
+            if ( !getString(blk.tranAbbr, sizeof(blk.tranAbbr))) return false;
+        } else {
+            sched.tran[sched.count].time = time;
+            sched.tran[sched.count].offset = (float)(int16_t)getInt(2) / 60;
+            if ( !getString(sched.tran[sched.count].abbr, sizeof(sched.tran[sched.count].abbr))) return false;
+            sched.count++;
+        }
+    }
+    return true;
+}
+
+// -----------------------------  Private Methods --------------------------------
+
+// ------------------------------------------------------------------ putInt()
+// Stores the low 'bytes' bytes of value, least significant byte first
+void TzRecord::putInt(uint32_t value, int bytes) {
+    for (int i = 0; i < bytes; i++) {
+        this->data[this->position++] = (uint8_t)(value >> (8 * i));
+    }
+}
+
+// ------------------------------------------------------------------ putEntry()
+// Stores a transition entry: time, offset & abbreviation
+void TzRecord::putEntry(time_t time, float offset, const char* abbr) {
+    putInt((uint32_t)time, 4);
+    putInt((uint16_t)tzMinutes(offset), 2);
+    putString(abbr, tzRecordEntrySize - 6);
+}
+
+// ------------------------------------------------------------------ entry()
+const uint8_t* TzRecord::entry(int j) const {
+    return &this->data[tzRecordEntries + (j * tzRecordEntrySize)];
+}
+
+// ------------------------------------------------------------------ getInt()
+uint32_t TzRecord::getInt(int bytes) {
+    uint32_t value = 0;
+    for (int i = 0; i < bytes; i++) {
+        value |= (uint32_t)this->data[this->position++] << (8 * i);
+    }
+    return value;
+}
+
+// ------------------------------------------------------------------ putString()
+// Stores a string in a 'size' byte field: its length, then up to (size - 1) characters
+void TzRecord::putString(const char* str, int size) {
+    int length = strnlen(str, size - 1);
+    this->data[this->position] = length;
+    memcpy(&this->data[this->position + 1], str, length);
+    this->position += size;
+}
+
+// ------------------------------------------------------------------ getString()
+// Reads a 'size' byte field into str (which holds 'size' bytes) ... returns false if the length is invalid
+bool TzRecord::getString(char* str, int size) {
+    int length = this->data[this->position];
+    if (length > size - 1) return false;
+    memcpy(str, &this->data[this->position + 1], length);
+    str[length] = '\0';
+    this->position += size;
+    return true;
+}
@@ -0,0 +1,236 @@
+#include "TzCfg.h"
+
+/*      Library: TzCfg
+        Module: TzRule.cpp compiles a POSIX TZ rule (e.g. "CST6CDT,M3.2.0,M11.1.0")
+        and computes the rule's transitions on the device.
+
+        A rule is compiled once into a small, allocation-free TzRule. After that,
+        the transitions for any year are found with O(1) integer arithmetic, so
+        a zone with a known rule needs no timezonedb queries to schedule its
+        DST transitions.
+
+        Supported rule syntax (POSIX, with the RFC 8536 extensions):
+            std offset [dst [offset] [,start[/time],end[/time]]]
+            std, dst ... 3+ letters, or <...> quoted (e.g. <+0530>)
+            offset ..... [+|-]hh[:mm[:ss]] ... POSIX offsets are WEST of UTC
+            start, end . Mm.w.d (month, week 1-5 (5 = last), weekday 0-6 (0 = Sunday))
+                         Jn (day 1-365, never counting February 29)
+                         n  (day 0-365, counting February 29)
+            time ....... [+|-]hh[:mm[:ss]] local time, default 02:00:00 (hours may be -167 to 167)
+*/
+
+// ---------------------------- Date Arithmetic -----------------------------------
+
+// Days from 1970-01-01 to the start of 'year'
+static constexpr long daysToYear(int year) {
+    return ((long)(year - 1) * 365) + ((year - 1) / 4) - ((year - 1) / 100) + ((year - 1) / 400) - 719162L;
+}
+
+// Returns true if 'year' is a leap year
+static constexpr bool leapYear(int year) {
+    return ((year % 4) == 0) && (((year % 100) != 0) || ((year % 400) == 0));
+}
+
+// Returns the year that contains the UTC time 't'
+static int yearOf(time_t t) {
+    long days = (long)(t / 86400) - ((t % 86400) < 0 ? 1 : 0);
+    int year = 1970 + (int)(days / 366);    // <-- never later than the actual year
+    while (daysToYear(year + 1) <= days) year++;
+    return year;
+}
+
+// ---------------------------- Class Constructor ---------------------------------
+
+TzRule::TzRule(void) {
+    this->valid = false;
+    this->hasDst = false;
+    this->stdOffset = 0;
+    this->dstOffset = 0;
+    strcpy(this->stdAbbr, "UTC");
+    this->dstAbbr[0] = '\0';
+}
+
+/* -------------------------------------------------------------------------- compile()
+
+    Compile a POSIX TZ rule string
+    Returns EXIT_SUCCESS, or EXIT_FAILURE if the rule can not be parsed.
+*/
+int TzRule::compile(const char* rule) {
+    const char* cp = rule;
+    long seconds;
+    *this = TzRule();
+    if ((cp == NULL) || !parseAbbr(cp, this->stdAbbr) || !parseTime(cp, seconds)) {
+        return EXIT_FAILURE;
+    }
+    this->stdOffset = -seconds;
+    if (*cp != '\0') {
+        if ( !parseAbbr(cp, this->dstAbbr)) return EXIT_FAILURE;
+        this->dstOffset = this->stdOffset + 3600;
+        if ((*cp != ',') && (*cp != '\0')) {
+            if ( !parseTime(cp, seconds)) return EXIT_FAILURE;
+            this->dstOffset = -seconds;
+        }
+        if (*cp == '\0') {
+            // no rules specified ... use the US rules
+            cp = ",M3.2.0,M11.1.0";
+        }
+        if ((*cp++ != ',') || !parseDate(cp, this->start) || (*cp++ != ',') || !parseDate(cp, this->end) || (*cp != '\0')) {
+            return EXIT_FAILURE;
+        }
+        this->hasDst = true;
+    }
+    this->valid = true;
+    TZ_LOG_CFG(TZ_LEVEL_DEBUG, "Rule compiled: %s (std %s %ld, dst %s %ld)", rule, this->stdAbbr, (long)this->stdOffset, this->dstAbbr, (long)this->dstOffset);
+    return EXIT_SUCCESS;
+}
+
+/* -------------------------------------------------------------------------- next()
+
+    Find the first transition after 'after'
+    Returns the transition's UTC time (0 if the rule has no transitions), and sets
+    'offset' (hours) and 'abbr' (char[6]) to the post-transition settings.
+*/
+time_t TzRule::next(time_t after, float& offset, char* abbr) {
+    if ( !this->valid || !this->hasDst) return 0;
+    int year = yearOf(after);
+    // the next transition is one of the four transitions in this year and the next
+    for (int y = year; y <= year + 1; y++) {
+        time_t toDst = transition(y, true);
+        time_t toStd = transition(y, false);
+        time_t first = (toDst < toStd) ? toDst : toStd;
+        time_t second = (toDst < toStd) ? toStd : toDst;
+        time_t t = (first > after) ? first : ((second > after) ? second : 0);
+        if (t != 0) {
+            bool dst = (t == toDst);
+            offset = (float)(dst ? this->dstOffset : this->stdOffset) / 3600;
+            strncpy(abbr, dst ? this->dstAbbr : this->stdAbbr, sizeof(this->stdAbbr));
+            return t;
+        }
+    }
+    return 0;
+}
+
+/* -------------------------------------------------------------------------- offsetAt()
+
+    Find the settings in effect at UTC time 't'
+    Returns the offset (hours) and sets 'abbr' (char[6]) to the abbreviation.
+*/
+float TzRule::offsetAt(time_t t, char* abbr) {
+    bool dst = false;
+    if (this->valid && this->hasDst) {
+        int year = yearOf(t);
+        time_t toDst = transition(year, true);
+        time_t toStd = transition(year, false);
+        // northern hemisphere: DST between toDst and toStd ... southern: DST outside toStd to toDst
+        dst = (toDst < toStd) ? ((t >= toDst) && (t < toStd)) : ((t >= toDst) || (t < toStd));
+    }
+    strncpy(abbr, dst ? this->dstAbbr : this->stdAbbr, sizeof(this->stdAbbr));
+    return (float)(dst ? this->dstOffset : this->stdOffset) / 3600;
+}
+
+// -----------------------------  Private Methods --------------------------------
+
+// ------------------------------------------------------------------ transition()
+// Returns the UTC time of the transition to DST (toDst = true) or to standard time in 'year'
+time_t TzRule::transition(int year, bool toDst) {
+    TzRuleDate& d = toDst ? this->start : this->end;
+    long day = daysToYear(year);
+    switch (d.type) {
+        case 'J':
+            // Jn ... February 29 is never counted
+            day += d.day - 1;
+            if (leapYear(year) && (d.day >= 60)) day++;
+            break;
+        case 'M': {
+            static const uint8_t monthDays[12] = {31,28,31,30,31,30,31,31,30,31,30,31};
+            for (int m = 1; m < d.month; m++) day += monthDays[m - 1] + (((m == 2) && leapYear(year)) ? 1 : 0);
+            int length = monthDays[d.month - 1] + (((d.month == 2) && leapYear(year)) ? 1 : 0);
+            int wday = (int)((day + 4) % 7);                    // <-- 1970-01-01 was a Thursday
+            int mday = ((d.wday - wday + 7) % 7) + ((d.week - 1) * 7);
+            if (mday >= length) mday -= 7;                      // <-- week 5 means "last"
+            day += mday;
+            break;
+        }
+        default:
+            // n ... zero-based, February 29 is counted
+            day += d.day;
+    }
+    // the rule's time is local time before the transition
+    return (time_t)day * 86400 + d.time - (toDst ? this->stdOffset : this->dstOffset);
+}
+
+// ------------------------------------------------------------------ parseAbbr()
+// Parses a zone abbreviation: 3+ letters, or <...>
+bool TzRule::parseAbbr(const char*& cp, char* abbr) {
+    int n = 0;
+    if (*cp == '<') {
+        cp++;
+        while ((*cp != '>') && (*cp != '\0')) {
+            if (n < 5) abbr[n++] = *cp;
+            cp++;
+        }
+        if (*cp++ != '>') return false;
+    } else {
+        while (((*cp >= 'A') && (*cp <= 'Z')) || ((*cp >= 'a') && (*cp <= 'z'))) {
+            if (n < 5) abbr[n++] = *cp;
+            cp++;
+        }
+        if (n < 3) return false;
+    }
+    abbr[n] = '\0';
+    return true;
+}
+
+// ------------------------------------------------------------------ parseTime()
+// Parses [+|-]hh[:mm[:ss]] into seconds
+bool TzRule::parseTime(const char*& cp, long& seconds) {
+    int sign = 1;
+    long parts[3] = {0, 0, 0};
+    if ((*cp == '+') || (*cp == '-')) {
+        if (*cp == '-') sign = -1;
+        cp++;
+    }
+    if ((*cp < '0') || (*cp > '9')) return false;
+    for (int i = 0; i < 3; i++) {
+        while ((*cp >= '0') && (*cp <= '9')) parts[i] = (parts[i] * 10) + (*cp++ - '0');
+        if ((i == 2) || (*cp != ':')) break;
+        cp++;
+    }
+    if ((parts[0] > 167) || (parts[1] > 59) || (parts[2] > 59)) return false;
+    seconds = sign * ((parts[0] * 3600) + (parts[1] * 60) + parts[2]);
+    return true;
+}
+
+// ------------------------------------------------------------------ parseDate()
+// Parses Mm.w.d, Jn or n, followed by an optional /time
+bool TzRule::parseDate(const char*& cp, TzRuleDate& d) {
+    long v[3] = {0, 0, 0};
+    d.type = *cp;
+    if ((*cp == 'M') || (*cp == 'J')) cp++;
+    for (int i = 0; i < ((d.type == 'M') ? 3 : 1); i++) {
+        if ((*cp < '0') || (*cp > '9')) return false;
+        while ((*cp >= '0') && (*cp <= '9')) v[i] = (v[i] * 10) + (*cp++ - '0');
+        if ((d.type == 'M') && (i < 2) && (*cp++ != '.')) return false;
+    }
+    if (d.type == 'M') {
+        if ((v[0] < 1) || (v[0] > 12) || (v[1] < 1) || (v[1] > 5) || (v[2] > 6)) return false;
+        d.month = v[0];
+        d.week = v[1];
+        d.wday = v[2];
+    } else if (d.type == 'J') {
+        if ((v[0] < 1) || (v[0] > 365)) return false;
+        d.day = v[0];
+    } else {
+        if (v[0] > 365) return false;
+        d.type = 'n';
+        d.day = v[0];
+    }
+    d.time = 7200;
+    if (*cp == '/') {
+        cp++;
+        long seconds;
+        if ( !parseTime(cp, seconds)) return false;
+        d.time = seconds;
+    }
+    return true;
+}
@@ -0,0 +1,175 @@
+#include "TzCfg.h"
+
+/*      Library: TzCfg
+        Module: TzSet.cpp holds additional time zones (for example, the sites that
+        a gateway collects readings from), and converts between UTC and their
+        local times.
+
+        Conversions use each zone's own settings ... the device's time settings
+        (Time.zone(), DST) are never changed. A zone defined by a POSIX TZ rule
+        converts any time exactly. Otherwise, the zone's current offset, next
+        transition and TzSchedule cover the next few years (earlier times use
+        the current offset).
+
+        TzCfg::maintainLocalTime() refreshes the zones (see TzCfg::refreshZones()),
+        and setEepromStartByte() persists them in EEPROM, so conversions are
+        available after a reset before any network access.
+*/
+
+// ---------------------------- Class Constructor ---------------------------------
+
+TzSet::TzSet(void) {
+    this->eepromStartByte = -1;
+    for (int i = 0; i < tzSetSize; i++) {
+        this->zone[i].used = false;
+        this->zone[i].loaded = false;
+        this->zone[i].refreshTime = 0;
+        this->zone[i].failures = 0;
+        this->zone[i].journal.slots = 1;
+        this->zone[i].journal.ownsDirectoryEntry = false;
+    }
+}
+
+// ------------------------------------------------------------------ add()
+// Adds a zone ... its settings are obtained by the next TzCfg::maintainLocalTime()
+int TzSet::add(char* id) {
+    return claim(id);
+}
+
+// ------------------------------------------------------------------ addByRule()
+// Adds a zone defined by a POSIX TZ rule ... its settings are available immediately
+int TzSet::addByRule(char* id, char* rule) {
+    TzRule r;
+    if ((strlen(rule) >= sizeof(this->zone[0].sched.rule)) || (r.compile(rule) != EXIT_SUCCESS)) return -1;
+    int z = claim(id);
+    if (z < 0) return -1;
+    this->zone[z].rule = r;
+    this->zone[z].loaded = true;    // <-- the rule converts any time ... the next refresh fills in the zone's TzBlock
+    strcpy(this->zone[z].sched.rule, rule);
+    return z;
+}
+
+// ------------------------------------------------------------------ remove()
+void TzSet::remove(int zone) {
+    if ((zone < 0) || (zone >= tzSetSize) || !this->zone[zone].used) return;
+    this->zone[zone].used = false;
+    this->zone[zone].loaded = false;
+    this->zone[zone].journal.erase();
+}
+
+// ------------------------------------------------------------------ ready()
+bool TzSet::ready(int zone) {
+    return (zone >= 0) && (zone < tzSetSize) && this->zone[zone].loaded;
+}
+
+// ------------------------------------------------------------------ getTimezone()
+char* TzSet::getTimezone(int zone) {
+    if ((zone < 0) || (zone >= tzSetSize) || !this->zone[zone].used) return (char*)"";
+    return this->zone[zone].blk.id;
+}
+
+// ------------------------------------------------------------------ offsetAt()
+// Returns the zone's offset (seconds EAST of UTC) in effect at 'utc' ... 0 if the zone is not ready
+long TzSet::offsetAt(int zone, time_t utc) {
+    if ( !ready(zone)) return 0;
+    if (this->zone[zone].rule.valid) {
+        char abbr[6];
+        return (long)tzMinutes(this->zone[zone].rule.offsetAt(utc, abbr)) * 60;
+    }
+    TzBlock& blk = this->zone[zone].blk;
+    TzSchedule& sched = this->zone[zone].sched;
+    if ((blk.tranTime == 0) || (utc < blk.tranTime)) return (long)tzMinutes(blk.curOffset) * 60;
+    float offset = blk.tranOffset;
+    for (int i = 0; (i < sched.count) && !(utc < sched.tran[i].time); i++) {
+        offset = sched.tran[i].offset;
+    }
+    return (long)tzMinutes(offset) * 60;
+}
+
+// ------------------------------------------------------------------ toLocal()
+time_t TzSet::toLocal(int zone, time_t utc) {
+    return utc + offsetAt(zone, utc);
+}
+
+// ------------------------------------------------------------------ toUtc()
+// Converts a local time to UTC. A local time that is skipped (or repeated) by a transition
+// is converted using the offset in effect before (or after) the transition.
+time_t TzSet::toUtc(int zone, time_t local) {
+    time_t guess = local - offsetAt(zone, local);
+    return local - offsetAt(zone, guess);
+}
+
+// ------------------------------------------------------------------ convertBatch()
+// Converts n UTC timestamps to the zone's local time ('in' and 'out' may be the same array)
+void TzSet::convertBatch(int zone, const time_t* in, time_t* out, size_t n) {
+    if ( !ready(zone)) {
+        memmove(out, in, n * sizeof(time_t));
+        return;
+    }
+    TzTimeline timeline(this->zone[zone].blk, this->zone[zone].sched, this->zone[zone].rule);
+    timeline.convert(in, out, n);
+}
+
+// ------------------------------------------------------------------ setEepromStartByte()
+// Persists the zones in EEPROM, starting at sb. Zones already stored there are restored
+// (with the same handles), and are refreshed by the next TzCfg::maintainLocalTime().
+// The location is rejected if it would overwrite other data (see TzJournal::claimable()).
+void TzSet::setEepromStartByte(int sb) {
+    int recordSize = this->zone[0].journal.recordSize();
+    int length = tzSetSize * recordSize;
+    if ((sb < 0) || (sb > (int)EEPROM.length() - length)) {
+        TZ_LOG_CFG(TZ_LEVEL_ERROR, "TzSet: EEPROM %d ... %d out of range", sb, sb + length - 1);
+        return;
+    }
+    for (int i = 0; i < tzSetSize; i++) {
+        // the zones' own records (at sb, or where the set is now) may be overwritten
+        if ( !this->zone[i].journal.claimable(sb + (i * recordSize), this->eepromStartByte, (this->eepromStartByte < 0) ? 0 : length)) {
+            TZ_LOG_CFG(TZ_LEVEL_ERROR, "TzSet: EEPROM %d ... %d holds other data: zones not stored", sb, sb + length - 1);
+            return;
+        }
+    }
+    this->eepromStartByte = sb;
+    for (int i = 0; i < tzSetSize; i++) {
+        TzJournal& journal = this->zone[i].journal;
+        journal.locate(sb + (i * recordSize));
+        if (this->zone[i].used) {
+            save(i);
+            continue;
+        }
+        journal.select();
+        if ((journal.sequence > 0) && journal.load(this->zone[i].blk, this->zone[i].sched)) {
+            this->zone[i].used = true;
+            this->zone[i].loaded = true;
+            this->zone[i].refreshTime = 0;
+            this->zone[i].rule = TzRule();
+            if (this->zone[i].sched.rule[0] != '\0') this->zone[i].rule.compile(this->zone[i].sched.rule);
+        }
+    }
+}
+
+// -----------------------------  Private Methods --------------------------------
+
+// ------------------------------------------------------------------ claim()
+int TzSet::claim(char* id) {
+    for (int i = 0; i < tzSetSize; i++) {
+        if ( !this->zone[i].used) {
+            this->zone[i].used = true;
+            this->zone[i].loaded = false;
+            this->zone[i].blk = TzBlock();
+            strncpy(this->zone[i].blk.id, id, sizeof(this->zone[i].blk.id));
+            this->zone[i].blk.id[sizeof(this->zone[i].blk.id) - 1] = '\0';
+            this->zone[i].sched = TzSchedule();
+            this->zone[i].rule = TzRule();
+            this->zone[i].refreshTime = 0;     // <-- refreshed by the next TzCfg::maintainLocalTime()
+            this->zone[i].failures = 0;
+            return i;
+        }
+    }
+    return -1;
+}
+
+// ------------------------------------------------------------------ save()
+void TzSet::save(int zone) {
+    if ((this->eepromStartByte < 0) || !this->zone[zone].loaded) return;
+    this->zone[zone].journal.write(this->zone[zone].blk, this->zone[zone].sched);
+}
@@ -0,0 +1,147 @@
+#include "TzCfg.h"
+#include <limits>
+#include <algorithm>
+#include <type_traits>
+
+/*      Library: TzCfg
+        Module: TzTimeline.cpp converts arrays of UTC timestamps (e.g. a log of
+        readings) to local time.
+
+        A zone's settings are arranged as periods of constant offset: the current
+        period, then one per transition (TzBlock::tranTime and the TzSchedule).
+        A period is only looked up (a binary search of the transitions) when a
+        timestamp falls outside the last period found. The input is taken a
+        block (tzTimelineBlock timestamps) at a time: a block in time order
+        (the usual case for a log) is binary searched for the end of the run
+        within the period, and the offset is added to the run in a plain
+        counted loop. The order check and the addition both vectorize. A
+        block that is not in time order is converted one timestamp at a time.
+
+        When the zone has a rule, the rule provides the periods before the
+        current one and beyond the schedule. Otherwise earlier timestamps use
+        the current offset, and later ones the offset after the last
+        scheduled transition.
+*/
+
+// ---------------------------- Class Constructor ---------------------------------
+
+TzTimeline::TzTimeline(TzBlock& blk, TzSchedule& sched, TzRule& rule) {
+    this->rule = rule.valid ? &rule : NULL;
+    this->count = 0;
+    this->offset[0] = (long)tzMinutes(blk.curOffset) * 60;
+    if (blk.tranTime > 0) {
+        this->start[0] = blk.tranTime;
+        this->offset[1] = (long)tzMinutes(blk.tranOffset) * 60;
+        this->count = 1;
+        for (int i = 0; i < sched.count; i++) {
+            this->start[this->count] = sched.tran[i].time;
+            this->offset[this->count + 1] = (long)tzMinutes(sched.tran[i].offset) * 60;
+            this->count++;
+        }
+    }
+}
+
+// ------------------------------------------------------------------ period()
+// Finds the period [from, to) that contains 't', and its offset
+void TzTimeline::period(time_t t, time_t& from, time_t& to, long& offset) {
+    from = std::numeric_limits<time_t>::min();
+    to = std::numeric_limits<time_t>::max();
+    bool outside = (this->count == 0) || (t < this->start[0]) || !(t < this->start[this->count - 1]);
+    if ((this->rule != NULL) && outside) {
+        // the rule's transitions surround 't' ... the previous one is within the last year
+        char abbr[6];
+        float hours;
+        offset = (long)tzMinutes(this->rule->offsetAt(t, abbr)) * 60;
+        time_t next = this->rule->next(t, hours, abbr);
+        if (next > 0) to = next;
+        for (time_t p = this->rule->next(t - (366L * 86400), hours, abbr); (p > 0) && !(p > t); p = this->rule->next(p, hours, abbr)) {
+            from = p;
+        }
+        return;
+    }
+    // binary search for the number of transitions at or before 't'
+    int lo = 0, hi = this->count;
+    while (lo < hi) {
+        int mid = (lo + hi) / 2;
+        if (this->start[mid] <= t) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    if (lo > 0) from = this->start[lo - 1];
+    if (lo < this->count) to = this->start[lo];
+    offset = this->offset[lo];
+}
+
+/*  The loops below work on tzTimelineLanes timestamps at a time. An inner loop with a fixed trip count is
+    vectorized even where a loop of unknown length is not (GCC's -O2), and the scalar loop that follows
+    handles the remainder. */
+const size_t tzTimelineLanes = 4;
+
+// ------------------------------------------------------------------ inOrder()
+// Returns true if n timestamps are in time order. The differences are taken unsigned and their sign bits
+// OR'ed (64-bit compares do not vectorize on every target), which holds for timestamps less than half the
+// range of time_t apart
+static bool inOrder(const time_t* in, size_t n) {
+    typedef std::make_unsigned<time_t>::type utime_t;
+    utime_t descending[tzTimelineLanes] = { 0 };
+    size_t k = 1;
+    for (; (k + tzTimelineLanes) <= n; k += tzTimelineLanes) {
+        for (size_t j = 0; j < tzTimelineLanes; j++) descending[j] |= (utime_t)in[k + j] - (utime_t)in[k + j - 1];
+    }
+    for (; k < n; k++) descending[0] |= (utime_t)in[k] - (utime_t)in[k - 1];
+    for (size_t j = 1; j < tzTimelineLanes; j++) descending[0] |= descending[j];
+    return ((descending[0] >> ((sizeof(utime_t) * 8) - 1)) == 0);
+}
+
+// ------------------------------------------------------------------ shift()
+// Adds 'offset' to n timestamps in place
+static void shift(time_t* t, size_t n, long offset) {
+    size_t k = 0;
+    for (; (k + tzTimelineLanes) <= n; k += tzTimelineLanes) {
+        for (size_t j = 0; j < tzTimelineLanes; j++) t[k + j] += offset;
+    }
+    for (; k < n; k++) t[k] += offset;
+}
+
+// ------------------------------------------------------------------ shift()
+// Adds 'offset' to n timestamps from 'in', storing them in 'out' (the arrays do not overlap)
+static void shift(const time_t* __restrict in, time_t* __restrict out, size_t n, long offset) {
+    size_t k = 0;
+    for (; (k + tzTimelineLanes) <= n; k += tzTimelineLanes) {
+        for (size_t j = 0; j < tzTimelineLanes; j++) out[k + j] = in[k + j] + offset;
+    }
+    for (; k < n; k++) out[k] = in[k] + offset;
+}
+
+// ------------------------------------------------------------------ convert()
+// Converts n UTC timestamps to local time ('in' and 'out' may be the same array)
+void TzTimeline::convert(const time_t* in, time_t* out, size_t n) {
+    time_t from = 0, to = 0;    // <-- an empty period, so the first timestamp looks up its period
+    long offset = 0;
+    size_t i = 0, sorted = 0;   // <-- in[i] ... in[sorted - 1] are known to be in time order
+    while (i < n) {
+        if ((in[i] < from) || !(in[i] < to)) period(in[i], from, to, offset);
+        if ( !(i < sorted)) {
+            size_t last = ((n - i) > tzTimelineBlock) ? i + tzTimelineBlock : n;
+            if ( !inOrder(in + i, last - i)) {
+                // not in time order ... the block is converted one timestamp at a time
+                for (; i < last; i++) {
+                    if ((in[i] < from) || !(in[i] < to)) period(in[i], from, to, offset);
+                    out[i] = in[i] + offset;
+                }
+                continue;
+            }
+            sorted = last;
+        }
+        // the run in this period ends at the first timestamp not before 'to'
+        size_t end = std::lower_bound(in + i, in + sorted, to) - in;
+        if (in == out) {
+            shift(out + i, end - i, offset);
+        } else {
+            shift(in + i, out + i, end - i, offset);
+        }
+        i = end;
+    }
+}
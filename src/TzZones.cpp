@@ -0,0 +1,62 @@
+#include "TzCfg.h"
+#ifdef TZCFG_ZONE_TABLE
+#include "TzZones.h"
+#endif
+
+/*      Library: TzCfg
+        Module: TzZones.cpp searches the built-in zone table (src/TzZones.h, generated
+        by tools/TzZoneGen.py) for a zone's POSIX TZ rule.
+
+        The table is only compiled when TZCFG_ZONE_TABLE is defined (see TzCfg.h).
+        Zone IDs are sorted and prefix compressed. Every TZ_ZONE_RESTART'th ID is
+        stored in full, so the search is a binary search over those IDs followed
+        by a short linear decode of one block ... a few microseconds per lookup.
+*/
+
+// ---------------------------------------------------------------------------- findZoneRule()
+// Copies the POSIX TZ rule for zone 'id' from the built-in zone table into 'rule'
+//      Returns EXIT_SUCCESS if the zone was found, else EXIT_FAILURE
+int TzCfg::findZoneRule(const char* id, char* rule, int ruleSize) {
+#ifdef TZCFG_ZONE_TABLE
+    const int blocks = sizeof(tzZoneRestarts) / sizeof(tzZoneRestarts[0]);
+    int idLength = strlen(id);
+    // binary search for the last block whose first (full) ID is <= id
+    int lo = 0, hi = blocks - 1, block = -1;
+    while (lo <= hi) {
+        int mid = (lo + hi) / 2;
+        const uint8_t* entry = &tzZoneNames[tzZoneRestarts[mid]];
+        int length = entry[1];
+        int cmp = memcmp(entry + 2, id, (length < idLength) ? length : idLength);
+        if (cmp == 0) cmp = length - idLength;
+        if (cmp <= 0) {
+            block = mid;
+            lo = mid + 1;
+        } else {
+            hi = mid - 1;
+        }
+    }
+    if (block < 0) return EXIT_FAILURE;
+    // decode the block's IDs until id is found (or passed)
+    char name[65];
+    const uint8_t* entry = &tzZoneNames[tzZoneRestarts[block]];
+    int entries = TZ_ZONE_COUNT - (block * TZ_ZONE_RESTART);
+    if (entries > TZ_ZONE_RESTART) entries = TZ_ZONE_RESTART;
+    for (int i = 0; i < entries; i++) {
+        int shared = entry[0];
+        int length = entry[1];
+        memcpy(name + shared, entry + 2, length);
+        name[shared + length] = '\0';
+        int cmp = strcmp(name, id);
+        if (cmp == 0) {
+            const uint8_t* cp = entry + 2 + length;
+            strncpy(rule, &tzZoneRules[(cp[0] << 8) | cp[1]], ruleSize);
+            rule[ruleSize - 1] = '\0';
+            TZ_LOG_CFG(TZ_LEVEL_DEBUG, "Zone table (tzdata %s): %s = %s", TZ_ZONE_VERSION, id, rule);
+            return EXIT_SUCCESS;
+        }
+        if (cmp > 0) break;
+        entry += 2 + length + 2;
+    }
+#endif
+    return EXIT_FAILURE;
+}
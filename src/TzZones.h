@@ -0,0 +1,518 @@
+#ifndef __TZZONES_H_
+#define __TZZONES_H_
+/*  Library: TzCfg
+    Module: TzZones.h is GENERATED by tools/TzZoneGen.py ... do not edit.
+    tzdata version: 2025b, zones: 597, rules: 94
+*/
+
+const char TZ_ZONE_VERSION[] = "2025b";
+const uint16_t TZ_ZONE_COUNT = 597;
+const uint8_t TZ_ZONE_RESTART = 16;
+
+const char tzZoneRules[] =
+    "GMT0\0"
+    "EAT-3\0"
+    "CET-1\0"
+    "WAT-1\0"
+    "CAT-2\0"
+    "EET-2EEST,M4.5.5/0,M10.5.4/24\0"
+    "<+01>-1\0"
+    "CET-1CEST,M3.5.0,M10.5.0/3\0"
+    "SAST-2\0"
+    "EET-2\0"
+    "HST10HDT,M3.2.0,M11.1.0\0"
+    "AKST9AKDT,M3.2.0,M11.1.0\0"
+    "AST4\0"
+    "<-03>3\0"
+    "EST5\0"
+    "CST6\0"
+    "<-04>4\0"
+    "<-05>5\0"
+    "MST7MDT,M3.2.0,M11.1.0\0"
+    "CST6CDT,M3.2.0,M11.1.0\0"
+    "MST7\0"
+    "EST5EDT,M3.2.0,M11.1.0\0"
+    "PST8PDT,M3.2.0,M11.1.0\0"
+    "AST4ADT,M3.2.0,M11.1.0\0"
+    "<-02>2<-01>,M3.5.0/-1,M10.5.0/0\0"
+    "CST5CDT,M3.2.0/0,M11.1.0/1\0"
+    "<-03>3<-02>,M3.2.0,M11.1.0\0"
+    "<-02>2\0"
+    "<-04>4<-03>,M9.1.6/24,M4.1.6/24\0"
+    "NST3:30NDT,M3.2.0,M11.1.0\0"
+    "<+08>-8\0"
+    "<+07>-7\0"
+    "<+10>-10\0"
+    "AEST-10AEDT,M10.1.0,M4.1.0/3\0"
+    "<+05>-5\0"
+    "NZST-12NZDT,M9.5.0,M4.1.0/3\0"
+    "<+03>-3\0"
+    "<+00>0<+02>-2,M3.5.0/1,M10.5.0/3\0"
+    "<+12>-12\0"
+    "<+04>-4\0"
+    "EET-2EEST,M3.5.0/0,M10.5.0/0\0"
+    "<+06>-6\0"
+    "IST-5:30\0"
+    "<+09>-9\0"
+    "CST-8\0"
+    "<+0530>-5:30\0"
+    "EET-2EEST,M3.5.0/3,M10.5.0/4\0"
+    "EET-2EEST,M3.4.4/50,M10.4.4/50\0"
+    "HKT-8\0"
+    "WIB-7\0"
+    "WIT-9\0"
+    "IST-2IDT,M3.4.4/26,M10.5.0\0"
+    "<+0430>-4:30\0"
+    "PKT-5\0"
+    "<+0545>-5:45\0"
+    "<+11>-11\0"
+    "WITA-8\0"
+    "PST-8\0"
+    "KST-9\0"
+    "<+0630>-6:30\0"
+    "<+0330>-3:30\0"
+    "JST-9\0"
+    "<-01>1<+00>,M3.5.0/0,M10.5.0/1\0"
+    "WET0WEST,M3.5.0/1,M10.5.0\0"
+    "<-01>1\0"
+    "ACST-9:30ACDT,M10.1.0,M4.1.0/3\0"
+    "AEST-10\0"
+    "ACST-9:30\0"
+    "<+0845>-8:45\0"
+    "<+1030>-10:30<+11>-11,M10.1.0,M4.1.0\0"
+    "AWST-8\0"
+    "<-06>6<-05>,M9.1.6/22,M4.1.6/22\0"
+    "IST-1GMT0,M10.5.0,M3.5.0/1\0"
+    "<-10>10\0"
+    "<-11>11\0"
+    "<-12>12\0"
+    "<-06>6\0"
+    "<-07>7\0"
+    "<-08>8\0"
+    "<-09>9\0"
+    "<+13>-13\0"
+    "<+14>-14\0"
+    "<+02>-2\0"
+    "UTC0\0"
+    "GMT0BST,M3.5.0/1,M10.5.0\0"
+    "EET-2EEST,M3.5.0,M10.5.0/3\0"
+    "MSK-3\0"
+    "HST10\0"
+    "MET-1MEST,M3.5.0,M10.5.0/3\0"
+    "<+1245>-12:45<+1345>,M9.5.0/2:45,M4.1.0/3:45\0"
+    "ChST-10\0"
+    "<-0930>9:30\0"
+    "SST11\0"
+    "<+11>-11<+12>,M10.1.0,M4.1.0/3\0";
+
+const uint8_t tzZoneNames[6438] = {
+    0x00, 0x0E, 0x41, 0x66, 0x72, 0x69, 0x63, 0x61, 0x2F, 0x41, 0x62, 0x69, 0x64, 0x6A, 0x61, 0x6E,
+    0x00, 0x00, 0x08, 0x04, 0x63, 0x63, 0x72, 0x61, 0x00, 0x00, 0x08, 0x0A, 0x64, 0x64, 0x69, 0x73,
+    0x5F, 0x41, 0x62, 0x61, 0x62, 0x61, 0x00, 0x05, 0x08, 0x06, 0x6C, 0x67, 0x69, 0x65, 0x72, 0x73,
+    0x00, 0x0B, 0x08, 0x05, 0x73, 0x6D, 0x61, 0x72, 0x61, 0x00, 0x05, 0x0A, 0x03, 0x65, 0x72, 0x61,
+    0x00, 0x05, 0x07, 0x06, 0x42, 0x61, 0x6D, 0x61, 0x6B, 0x6F, 0x00, 0x00, 0x09, 0x04, 0x6E, 0x67,
+    0x75, 0x69, 0x00, 0x11, 0x0A, 0x03, 0x6A, 0x75, 0x6C, 0x00, 0x00, 0x08, 0x05, 0x69, 0x73, 0x73,
+    0x61, 0x75, 0x00, 0x00, 0x08, 0x07, 0x6C, 0x61, 0x6E, 0x74, 0x79, 0x72, 0x65, 0x00, 0x17, 0x08,
+    0x0A, 0x72, 0x61, 0x7A, 0x7A, 0x61, 0x76, 0x69, 0x6C, 0x6C, 0x65, 0x00, 0x11, 0x08, 0x08, 0x75,
+    0x6A, 0x75, 0x6D, 0x62, 0x75, 0x72, 0x61, 0x00, 0x17, 0x07, 0x05, 0x43, 0x61, 0x69, 0x72, 0x6F,
+    0x00, 0x1D, 0x09, 0x08, 0x73, 0x61, 0x62, 0x6C, 0x61, 0x6E, 0x63, 0x61, 0x00, 0x3B, 0x08, 0x04,
+    0x65, 0x75, 0x74, 0x61, 0x00, 0x43, 0x00, 0x0E, 0x41, 0x66, 0x72, 0x69, 0x63, 0x61, 0x2F, 0x43,
+    0x6F, 0x6E, 0x61, 0x6B, 0x72, 0x79, 0x00, 0x00, 0x07, 0x05, 0x44, 0x61, 0x6B, 0x61, 0x72, 0x00,
+    0x00, 0x09, 0x0B, 0x72, 0x5F, 0x65, 0x73, 0x5F, 0x53, 0x61, 0x6C, 0x61, 0x61, 0x6D, 0x00, 0x05,
+    0x08, 0x07, 0x6A, 0x69, 0x62, 0x6F, 0x75, 0x74, 0x69, 0x00, 0x05, 0x08, 0x05, 0x6F, 0x75, 0x61,
+    0x6C, 0x61, 0x00, 0x11, 0x07, 0x08, 0x45, 0x6C, 0x5F, 0x41, 0x61, 0x69, 0x75, 0x6E, 0x00, 0x3B,
+    0x07, 0x08, 0x46, 0x72, 0x65, 0x65, 0x74, 0x6F, 0x77, 0x6E, 0x00, 0x00, 0x07, 0x08, 0x47, 0x61,
+    0x62, 0x6F, 0x72, 0x6F, 0x6E, 0x65, 0x00, 0x17, 0x07, 0x06, 0x48, 0x61, 0x72, 0x61, 0x72, 0x65,
+    0x00, 0x17, 0x07, 0x0C, 0x4A, 0x6F, 0x68, 0x61, 0x6E, 0x6E, 0x65, 0x73, 0x62, 0x75, 0x72, 0x67,
+    0x00, 0x5E, 0x08, 0x03, 0x75, 0x62, 0x61, 0x00, 0x17, 0x07, 0x07, 0x4B, 0x61, 0x6D, 0x70, 0x61,
+    0x6C, 0x61, 0x00, 0x05, 0x08, 0x07, 0x68, 0x61, 0x72, 0x74, 0x6F, 0x75, 0x6D, 0x00, 0x17, 0x08,
+    0x05, 0x69, 0x67, 0x61, 0x6C, 0x69, 0x00, 0x17, 0x09, 0x06, 0x6E, 0x73, 0x68, 0x61, 0x73, 0x61,
+    0x00, 0x11, 0x07, 0x05, 0x4C, 0x61, 0x67, 0x6F, 0x73, 0x00, 0x11, 0x00, 0x11, 0x41, 0x66, 0x72,
+    0x69, 0x63, 0x61, 0x2F, 0x4C, 0x69, 0x62, 0x72, 0x65, 0x76, 0x69, 0x6C, 0x6C, 0x65, 0x00, 0x11,
+    0x08, 0x03, 0x6F, 0x6D, 0x65, 0x00, 0x00, 0x08, 0x05, 0x75, 0x61, 0x6E, 0x64, 0x61, 0x00, 0x11,
+    0x09, 0x08, 0x62, 0x75, 0x6D, 0x62, 0x61, 0x73, 0x68, 0x69, 0x00, 0x17, 0x09, 0x04, 0x73, 0x61,
+    0x6B, 0x61, 0x00, 0x17, 0x07, 0x06, 0x4D, 0x61, 0x6C, 0x61, 0x62, 0x6F, 0x00, 0x11, 0x09, 0x04,
+    0x70, 0x75, 0x74, 0x6F, 0x00, 0x17, 0x09, 0x04, 0x73, 0x65, 0x72, 0x75, 0x00, 0x5E, 0x08, 0x06,
+    0x62, 0x61, 0x62, 0x61, 0x6E, 0x65, 0x00, 0x5E, 0x08, 0x08, 0x6F, 0x67, 0x61, 0x64, 0x69, 0x73,
+    0x68, 0x75, 0x00, 0x05, 0x09, 0x06, 0x6E, 0x72, 0x6F, 0x76, 0x69, 0x61, 0x00, 0x00, 0x07, 0x07,
+    0x4E, 0x61, 0x69, 0x72, 0x6F, 0x62, 0x69, 0x00, 0x05, 0x08, 0x07, 0x64, 0x6A, 0x61, 0x6D, 0x65,
+    0x6E, 0x61, 0x00, 0x11, 0x08, 0x05, 0x69, 0x61, 0x6D, 0x65, 0x79, 0x00, 0x11, 0x08, 0x09, 0x6F,
+    0x75, 0x61, 0x6B, 0x63, 0x68, 0x6F, 0x74, 0x74, 0x00, 0x00, 0x07, 0x0B, 0x4F, 0x75, 0x61, 0x67,
+    0x61, 0x64, 0x6F, 0x75, 0x67, 0x6F, 0x75, 0x00, 0x00, 0x00, 0x11, 0x41, 0x66, 0x72, 0x69, 0x63,
+    0x61, 0x2F, 0x50, 0x6F, 0x72, 0x74, 0x6F, 0x2D, 0x4E, 0x6F, 0x76, 0x6F, 0x00, 0x11, 0x07, 0x08,
+    0x53, 0x61, 0x6F, 0x5F, 0x54, 0x6F, 0x6D, 0x65, 0x00, 0x00, 0x07, 0x08, 0x54, 0x69, 0x6D, 0x62,
+    0x75, 0x6B, 0x74, 0x75, 0x00, 0x00, 0x08, 0x06, 0x72, 0x69, 0x70, 0x6F, 0x6C, 0x69, 0x00, 0x65,
+    0x08, 0x04, 0x75, 0x6E, 0x69, 0x73, 0x00, 0x0B, 0x07, 0x08, 0x57, 0x69, 0x6E, 0x64, 0x68, 0x6F,
+    0x65, 0x6B, 0x00, 0x17, 0x01, 0x0B, 0x6D, 0x65, 0x72, 0x69, 0x63, 0x61, 0x2F, 0x41, 0x64, 0x61,
+    0x6B, 0x00, 0x6B, 0x09, 0x08, 0x6E, 0x63, 0x68, 0x6F, 0x72, 0x61, 0x67, 0x65, 0x00, 0x83, 0x0A,
+    0x06, 0x67, 0x75, 0x69, 0x6C, 0x6C, 0x61, 0x00, 0x9C, 0x0A, 0x05, 0x74, 0x69, 0x67, 0x75, 0x61,
+    0x00, 0x9C, 0x09, 0x08, 0x72, 0x61, 0x67, 0x75, 0x61, 0x69, 0x6E, 0x61, 0x00, 0xA1, 0x0A, 0x14,
+    0x67, 0x65, 0x6E, 0x74, 0x69, 0x6E, 0x61, 0x2F, 0x42, 0x75, 0x65, 0x6E, 0x6F, 0x73, 0x5F, 0x41,
+    0x69, 0x72, 0x65, 0x73, 0x00, 0xA1, 0x12, 0x09, 0x43, 0x61, 0x74, 0x61, 0x6D, 0x61, 0x72, 0x63,
+    0x61, 0x00, 0xA1, 0x13, 0x0D, 0x6F, 0x6D, 0x6F, 0x64, 0x52, 0x69, 0x76, 0x61, 0x64, 0x61, 0x76,
+    0x69, 0x61, 0x00, 0xA1, 0x14, 0x05, 0x72, 0x64, 0x6F, 0x62, 0x61, 0x00, 0xA1, 0x12, 0x05, 0x4A,
+    0x75, 0x6A, 0x75, 0x79, 0x00, 0xA1, 0x00, 0x1A, 0x41, 0x6D, 0x65, 0x72, 0x69, 0x63, 0x61, 0x2F,
+    0x41, 0x72, 0x67, 0x65, 0x6E, 0x74, 0x69, 0x6E, 0x61, 0x2F, 0x4C, 0x61, 0x5F, 0x52, 0x69, 0x6F,
+    0x6A, 0x61, 0x00, 0xA1, 0x12, 0x07, 0x4D, 0x65, 0x6E, 0x64, 0x6F, 0x7A, 0x61, 0x00, 0xA1, 0x12,
+    0x0C, 0x52, 0x69, 0x6F, 0x5F, 0x47, 0x61, 0x6C, 0x6C, 0x65, 0x67, 0x6F, 0x73, 0x00, 0xA1, 0x12,
+    0x05, 0x53, 0x61, 0x6C, 0x74, 0x61, 0x00, 0xA1, 0x14, 0x06, 0x6E, 0x5F, 0x4A, 0x75, 0x61, 0x6E,
+    0x00, 0xA1, 0x16, 0x04, 0x4C, 0x75, 0x69, 0x73, 0x00, 0xA1, 0x12, 0x07, 0x54, 0x75, 0x63, 0x75,
+    0x6D, 0x61, 0x6E, 0x00, 0xA1, 0x12, 0x07, 0x55, 0x73, 0x68, 0x75, 0x61, 0x69, 0x61, 0x00, 0xA1,
+    0x0A, 0x03, 0x75, 0x62, 0x61, 0x00, 0x9C, 0x09, 0x07, 0x73, 0x75, 0x6E, 0x63, 0x69, 0x6F, 0x6E,
+    0x00, 0xA1, 0x09, 0x07, 0x74, 0x69, 0x6B, 0x6F, 0x6B, 0x61, 0x6E, 0x00, 0xA8, 0x0A, 0x02, 0x6B,
+    0x61, 0x00, 0x6B, 0x08, 0x05, 0x42, 0x61, 0x68, 0x69, 0x61, 0x00, 0xA1, 0x0D, 0x09, 0x5F, 0x42,
+    0x61, 0x6E, 0x64, 0x65, 0x72, 0x61, 0x73, 0x00, 0xAD, 0x0A, 0x06, 0x72, 0x62, 0x61, 0x64, 0x6F,
+    0x73, 0x00, 0x9C, 0x09, 0x04, 0x65, 0x6C, 0x65, 0x6D, 0x00, 0xA1, 0x00, 0x0E, 0x41, 0x6D, 0x65,
+    0x72, 0x69, 0x63, 0x61, 0x2F, 0x42, 0x65, 0x6C, 0x69, 0x7A, 0x65, 0x00, 0xAD, 0x09, 0x0B, 0x6C,
+    0x61, 0x6E, 0x63, 0x2D, 0x53, 0x61, 0x62, 0x6C, 0x6F, 0x6E, 0x00, 0x9C, 0x09, 0x08, 0x6F, 0x61,
+    0x5F, 0x56, 0x69, 0x73, 0x74, 0x61, 0x00, 0xB2, 0x0A, 0x04, 0x67, 0x6F, 0x74, 0x61, 0x00, 0xB9,
+    0x0A, 0x03, 0x69, 0x73, 0x65, 0x00, 0xC0, 0x09, 0x0B, 0x75, 0x65, 0x6E, 0x6F, 0x73, 0x5F, 0x41,
+    0x69, 0x72, 0x65, 0x73, 0x00, 0xA1, 0x08, 0x0D, 0x43, 0x61, 0x6D, 0x62, 0x72, 0x69, 0x64, 0x67,
+    0x65, 0x5F, 0x42, 0x61, 0x79, 0x00, 0xC0, 0x0B, 0x09, 0x70, 0x6F, 0x5F, 0x47, 0x72, 0x61, 0x6E,
+    0x64, 0x65, 0x00, 0xB2, 0x0A, 0x04, 0x6E, 0x63, 0x75, 0x6E, 0x00, 0xA8, 0x0A, 0x05, 0x72, 0x61,
+    0x63, 0x61, 0x73, 0x00, 0xB2, 0x0A, 0x07, 0x74, 0x61, 0x6D, 0x61, 0x72, 0x63, 0x61, 0x00, 0xA1,
+    0x0A, 0x05, 0x79, 0x65, 0x6E, 0x6E, 0x65, 0x00, 0xA1, 0x0B, 0x03, 0x6D, 0x61, 0x6E, 0x00, 0xA8,
+    0x09, 0x06, 0x68, 0x69, 0x63, 0x61, 0x67, 0x6F, 0x00, 0xD7, 0x0B, 0x06, 0x68, 0x75, 0x61, 0x68,
+    0x75, 0x61, 0x00, 0xAD, 0x09, 0x0C, 0x69, 0x75, 0x64, 0x61, 0x64, 0x5F, 0x4A, 0x75, 0x61, 0x72,
+    0x65, 0x7A, 0x00, 0xC0, 0x00, 0x15, 0x41, 0x6D, 0x65, 0x72, 0x69, 0x63, 0x61, 0x2F, 0x43, 0x6F,
+    0x72, 0x61, 0x6C, 0x5F, 0x48, 0x61, 0x72, 0x62, 0x6F, 0x75, 0x72, 0x00, 0xA8, 0x0B, 0x04, 0x64,
+    0x6F, 0x62, 0x61, 0x00, 0xA1, 0x0A, 0x08, 0x73, 0x74, 0x61, 0x5F, 0x52, 0x69, 0x63, 0x61, 0x00,
+    0xAD, 0x0A, 0x07, 0x79, 0x68, 0x61, 0x69, 0x71, 0x75, 0x65, 0x00, 0xA1, 0x09, 0x06, 0x72, 0x65,
+    0x73, 0x74, 0x6F, 0x6E, 0x00, 0xEE, 0x09, 0x05, 0x75, 0x69, 0x61, 0x62, 0x61, 0x00, 0xB2, 0x0A,
+    0x05, 0x72, 0x61, 0x63, 0x61, 0x6F, 0x00, 0x9C, 0x08, 0x0C, 0x44, 0x61, 0x6E, 0x6D, 0x61, 0x72,
+    0x6B, 0x73, 0x68, 0x61, 0x76, 0x6E, 0x00, 0x00, 0x0A, 0x04, 0x77, 0x73, 0x6F, 0x6E, 0x00, 0xEE,
+    0x0E, 0x06, 0x5F, 0x43, 0x72, 0x65, 0x65, 0x6B, 0x00, 0xEE, 0x09, 0x05, 0x65, 0x6E, 0x76, 0x65,
+    0x72, 0x00, 0xC0, 0x0A, 0x05, 0x74, 0x72, 0x6F, 0x69, 0x74, 0x00, 0xF3, 0x09, 0x07, 0x6F, 0x6D,
+    0x69, 0x6E, 0x69, 0x63, 0x61, 0x00, 0x9C, 0x08, 0x08, 0x45, 0x64, 0x6D, 0x6F, 0x6E, 0x74, 0x6F,
+    0x6E, 0x00, 0xC0, 0x09, 0x07, 0x69, 0x72, 0x75, 0x6E, 0x65, 0x70, 0x65, 0x00, 0xB9, 0x09, 0x0A,
+    0x6C, 0x5F, 0x53, 0x61, 0x6C, 0x76, 0x61, 0x64, 0x6F, 0x72, 0x00, 0xAD, 0x00, 0x10, 0x41, 0x6D,
+    0x65, 0x72, 0x69, 0x63, 0x61, 0x2F, 0x45, 0x6E, 0x73, 0x65, 0x6E, 0x61, 0x64, 0x61, 0x01, 0x0A,
+    0x08, 0x0B, 0x46, 0x6F, 0x72, 0x74, 0x5F, 0x4E, 0x65, 0x6C, 0x73, 0x6F, 0x6E, 0x00, 0xEE, 0x0D,
+    0x05, 0x57, 0x61, 0x79, 0x6E, 0x65, 0x00, 0xF3, 0x0C, 0x05, 0x61, 0x6C, 0x65, 0x7A, 0x61, 0x00,
+    0xA1, 0x08, 0x09, 0x47, 0x6C, 0x61, 0x63, 0x65, 0x5F, 0x42, 0x61, 0x79, 0x01, 0x21, 0x09, 0x06,
+    0x6F, 0x64, 0x74, 0x68, 0x61, 0x62, 0x01, 0x38, 0x0A, 0x07, 0x6F, 0x73, 0x65, 0x5F, 0x42, 0x61,
+    0x79, 0x01, 0x21, 0x09, 0x09, 0x72, 0x61, 0x6E, 0x64, 0x5F, 0x54, 0x75, 0x72, 0x6B, 0x00, 0xF3,
+    0x0A, 0x05, 0x65, 0x6E, 0x61, 0x64, 0x61, 0x00, 0x9C, 0x09, 0x09, 0x75, 0x61, 0x64, 0x65, 0x6C,
+    0x6F, 0x75, 0x70, 0x65, 0x00, 0x9C, 0x0B, 0x06, 0x74, 0x65, 0x6D, 0x61, 0x6C, 0x61, 0x00, 0xAD,
+    0x0B, 0x06, 0x79, 0x61, 0x71, 0x75, 0x69, 0x6C, 0x00, 0xB9, 0x0A, 0x04, 0x79, 0x61, 0x6E, 0x61,
+    0x00, 0xB2, 0x08, 0x07, 0x48, 0x61, 0x6C, 0x69, 0x66, 0x61, 0x78, 0x01, 0x21, 0x0A, 0x04, 0x76,
+    0x61, 0x6E, 0x61, 0x01, 0x58, 0x09, 0x09, 0x65, 0x72, 0x6D, 0x6F, 0x73, 0x69, 0x6C, 0x6C, 0x6F,
+    0x00, 0xEE, 0x00, 0x1C, 0x41, 0x6D, 0x65, 0x72, 0x69, 0x63, 0x61, 0x2F, 0x49, 0x6E, 0x64, 0x69,
+    0x61, 0x6E, 0x61, 0x2F, 0x49, 0x6E, 0x64, 0x69, 0x61, 0x6E, 0x61, 0x70, 0x6F, 0x6C, 0x69, 0x73,
+    0x00, 0xF3, 0x10, 0x04, 0x4B, 0x6E, 0x6F, 0x78, 0x00, 0xD7, 0x10, 0x07, 0x4D, 0x61, 0x72, 0x65,
+    0x6E, 0x67, 0x6F, 0x00, 0xF3, 0x10, 0x0A, 0x50, 0x65, 0x74, 0x65, 0x72, 0x73, 0x62, 0x75, 0x72,
+    0x67, 0x00, 0xF3, 0x10, 0x09, 0x54, 0x65, 0x6C, 0x6C, 0x5F, 0x43, 0x69, 0x74, 0x79, 0x00, 0xD7,
+    0x10, 0x05, 0x56, 0x65, 0x76, 0x61, 0x79, 0x00, 0xF3, 0x11, 0x08, 0x69, 0x6E, 0x63, 0x65, 0x6E,
+    0x6E, 0x65, 0x73, 0x00, 0xF3, 0x10, 0x07, 0x57, 0x69, 0x6E, 0x61, 0x6D, 0x61, 0x63, 0x00, 0xF3,
+    0x0F, 0x05, 0x70, 0x6F, 0x6C, 0x69, 0x73, 0x00, 0xF3, 0x0A, 0x04, 0x75, 0x76, 0x69, 0x6B, 0x00,
+    0xC0, 0x09, 0x06, 0x71, 0x61, 0x6C, 0x75, 0x69, 0x74, 0x00, 0xF3, 0x08, 0x07, 0x4A, 0x61, 0x6D,
+    0x61, 0x69, 0x63, 0x61, 0x00, 0xA8, 0x09, 0x04, 0x75, 0x6A, 0x75, 0x79, 0x00, 0xA1, 0x0A, 0x04,
+    0x6E, 0x65, 0x61, 0x75, 0x00, 0x83, 0x08, 0x13, 0x4B, 0x65, 0x6E, 0x74, 0x75, 0x63, 0x6B, 0x79,
+    0x2F, 0x4C, 0x6F, 0x75, 0x69, 0x73, 0x76, 0x69, 0x6C, 0x6C, 0x65, 0x00, 0xF3, 0x11, 0x0A, 0x4D,
+    0x6F, 0x6E, 0x74, 0x69, 0x63, 0x65, 0x6C, 0x6C, 0x6F, 0x00, 0xF3, 0x00, 0x0F, 0x41, 0x6D, 0x65,
+    0x72, 0x69, 0x63, 0x61, 0x2F, 0x4B, 0x6E, 0x6F, 0x78, 0x5F, 0x49, 0x4E, 0x00, 0xD7, 0x09, 0x09,
+    0x72, 0x61, 0x6C, 0x65, 0x6E, 0x64, 0x69, 0x6A, 0x6B, 0x00, 0x9C, 0x08, 0x06, 0x4C, 0x61, 0x5F,
+    0x50, 0x61, 0x7A, 0x00, 0xB2, 0x09, 0x03, 0x69, 0x6D, 0x61, 0x00, 0xB9, 0x09, 0x0A, 0x6F, 0x73,
+    0x5F, 0x41, 0x6E, 0x67, 0x65, 0x6C, 0x65, 0x73, 0x01, 0x0A, 0x0A, 0x08, 0x75, 0x69, 0x73, 0x76,
+    0x69, 0x6C, 0x6C, 0x65, 0x00, 0xF3, 0x0A, 0x0B, 0x77, 0x65, 0x72, 0x5F, 0x50, 0x72, 0x69, 0x6E,
+    0x63, 0x65, 0x73, 0x00, 0x9C, 0x08, 0x06, 0x4D, 0x61, 0x63, 0x65, 0x69, 0x6F, 0x00, 0xA1, 0x0A,
+    0x05, 0x6E, 0x61, 0x67, 0x75, 0x61, 0x00, 0xAD, 0x0C, 0x02, 0x75, 0x73, 0x00, 0xB2, 0x0A, 0x05,
+    0x72, 0x69, 0x67, 0x6F, 0x74, 0x00, 0x9C, 0x0B, 0x07, 0x74, 0x69, 0x6E, 0x69, 0x71, 0x75, 0x65,
+    0x00, 0x9C, 0x0A, 0x07, 0x74, 0x61, 0x6D, 0x6F, 0x72, 0x6F, 0x73, 0x00, 0xD7, 0x0A, 0x06, 0x7A,
+    0x61, 0x74, 0x6C, 0x61, 0x6E, 0x00, 0xEE, 0x09, 0x06, 0x65, 0x6E, 0x64, 0x6F, 0x7A, 0x61, 0x00,
+    0xA1, 0x0B, 0x06, 0x6F, 0x6D, 0x69, 0x6E, 0x65, 0x65, 0x00, 0xD7, 0x00, 0x0E, 0x41, 0x6D, 0x65,
+    0x72, 0x69, 0x63, 0x61, 0x2F, 0x4D, 0x65, 0x72, 0x69, 0x64, 0x61, 0x00, 0xAD, 0x0A, 0x08, 0x74,
+    0x6C, 0x61, 0x6B, 0x61, 0x74, 0x6C, 0x61, 0x00, 0x83, 0x0A, 0x09, 0x78, 0x69, 0x63, 0x6F, 0x5F,
+    0x43, 0x69, 0x74, 0x79, 0x00, 0xAD, 0x09, 0x07, 0x69, 0x71, 0x75, 0x65, 0x6C, 0x6F, 0x6E, 0x01,
+    0x73, 0x09, 0x06, 0x6F, 0x6E, 0x63, 0x74, 0x6F, 0x6E, 0x01, 0x21, 0x0B, 0x06, 0x74, 0x65, 0x72,
+    0x72, 0x65, 0x79, 0x00, 0xAD, 0x0D, 0x05, 0x76, 0x69, 0x64, 0x65, 0x6F, 0x00, 0xA1, 0x0C, 0x04,
+    0x72, 0x65, 0x61, 0x6C, 0x00, 0xF3, 0x0C, 0x06, 0x73, 0x65, 0x72, 0x72, 0x61, 0x74, 0x00, 0x9C,
+    0x08, 0x06, 0x4E, 0x61, 0x73, 0x73, 0x61, 0x75, 0x00, 0xF3, 0x09, 0x07, 0x65, 0x77, 0x5F, 0x59,
+    0x6F, 0x72, 0x6B, 0x00, 0xF3, 0x09, 0x06, 0x69, 0x70, 0x69, 0x67, 0x6F, 0x6E, 0x00, 0xF3, 0x09,
+    0x03, 0x6F, 0x6D, 0x65, 0x00, 0x83, 0x0A, 0x05, 0x72, 0x6F, 0x6E, 0x68, 0x61, 0x01, 0x8E, 0x0B,
+    0x10, 0x74, 0x68, 0x5F, 0x44, 0x61, 0x6B, 0x6F, 0x74, 0x61, 0x2F, 0x42, 0x65, 0x75, 0x6C, 0x61,
+    0x68, 0x00, 0xD7, 0x15, 0x06, 0x43, 0x65, 0x6E, 0x74, 0x65, 0x72, 0x00, 0xD7, 0x00, 0x1E, 0x41,
+    0x6D, 0x65, 0x72, 0x69, 0x63, 0x61, 0x2F, 0x4E, 0x6F, 0x72, 0x74, 0x68, 0x5F, 0x44, 0x61, 0x6B,
+    0x6F, 0x74, 0x61, 0x2F, 0x4E, 0x65, 0x77, 0x5F, 0x53, 0x61, 0x6C, 0x65, 0x6D, 0x00, 0xD7, 0x09,
+    0x03, 0x75, 0x75, 0x6B, 0x01, 0x38, 0x08, 0x07, 0x4F, 0x6A, 0x69, 0x6E, 0x61, 0x67, 0x61, 0x00,
+    0xD7, 0x08, 0x06, 0x50, 0x61, 0x6E, 0x61, 0x6D, 0x61, 0x00, 0xA8, 0x0B, 0x08, 0x67, 0x6E, 0x69,
+    0x72, 0x74, 0x75, 0x6E, 0x67, 0x00, 0xF3, 0x0A, 0x08, 0x72, 0x61, 0x6D, 0x61, 0x72, 0x69, 0x62,
+    0x6F, 0x00, 0xA1, 0x09, 0x06, 0x68, 0x6F, 0x65, 0x6E, 0x69, 0x78, 0x00, 0xEE, 0x09, 0x0D, 0x6F,
+    0x72, 0x74, 0x2D, 0x61, 0x75, 0x2D, 0x50, 0x72, 0x69, 0x6E, 0x63, 0x65, 0x00, 0xF3, 0x0C, 0x09,
+    0x5F, 0x6F, 0x66, 0x5F, 0x53, 0x70, 0x61, 0x69, 0x6E, 0x00, 0x9C, 0x0C, 0x06, 0x6F, 0x5F, 0x41,
+    0x63, 0x72, 0x65, 0x00, 0xB9, 0x0E, 0x05, 0x56, 0x65, 0x6C, 0x68, 0x6F, 0x00, 0xB2, 0x09, 0x0A,
+    0x75, 0x65, 0x72, 0x74, 0x6F, 0x5F, 0x52, 0x69, 0x63, 0x6F, 0x00, 0x9C, 0x0A, 0x0A, 0x6E, 0x74,
+    0x61, 0x5F, 0x41, 0x72, 0x65, 0x6E, 0x61, 0x73, 0x00, 0xA1, 0x08, 0x0B, 0x52, 0x61, 0x69, 0x6E,
+    0x79, 0x5F, 0x52, 0x69, 0x76, 0x65, 0x72, 0x00, 0xD7, 0x0A, 0x0A, 0x6E, 0x6B, 0x69, 0x6E, 0x5F,
+    0x49, 0x6E, 0x6C, 0x65, 0x74, 0x00, 0xD7, 0x09, 0x05, 0x65, 0x63, 0x69, 0x66, 0x65, 0x00, 0xA1,
+    0x00, 0x0E, 0x41, 0x6D, 0x65, 0x72, 0x69, 0x63, 0x61, 0x2F, 0x52, 0x65, 0x67, 0x69, 0x6E, 0x61,
+    0x00, 0xAD, 0x0A, 0x06, 0x73, 0x6F, 0x6C, 0x75, 0x74, 0x65, 0x00, 0xD7, 0x09, 0x09, 0x69, 0x6F,
+    0x5F, 0x42, 0x72, 0x61, 0x6E, 0x63, 0x6F, 0x00, 0xB9, 0x09, 0x06, 0x6F, 0x73, 0x61, 0x72, 0x69,
+    0x6F, 0x00, 0xA1, 0x08, 0x0C, 0x53, 0x61, 0x6E, 0x74, 0x61, 0x5F, 0x49, 0x73, 0x61, 0x62, 0x65,
+    0x6C, 0x01, 0x0A, 0x0D, 0x03, 0x72, 0x65, 0x6D, 0x00, 0xA1, 0x0C, 0x04, 0x69, 0x61, 0x67, 0x6F,
+    0x01, 0x95, 0x0C, 0x09, 0x6F, 0x5F, 0x44, 0x6F, 0x6D, 0x69, 0x6E, 0x67, 0x6F, 0x00, 0x9C, 0x0A,
+    0x07, 0x6F, 0x5F, 0x50, 0x61, 0x75, 0x6C, 0x6F, 0x00, 0xA1, 0x09, 0x0B, 0x63, 0x6F, 0x72, 0x65,
+    0x73, 0x62, 0x79, 0x73, 0x75, 0x6E, 0x64, 0x01, 0x38, 0x09, 0x07, 0x68, 0x69, 0x70, 0x72, 0x6F,
+    0x63, 0x6B, 0x00, 0xC0, 0x09, 0x04, 0x69, 0x74, 0x6B, 0x61, 0x00, 0x83, 0x09, 0x0C, 0x74, 0x5F,
+    0x42, 0x61, 0x72, 0x74, 0x68, 0x65, 0x6C, 0x65, 0x6D, 0x79, 0x00, 0x9C, 0x0B, 0x05, 0x4A, 0x6F,
+    0x68, 0x6E, 0x73, 0x01, 0xB5, 0x0B, 0x05, 0x4B, 0x69, 0x74, 0x74, 0x73, 0x00, 0x9C, 0x0B, 0x05,
+    0x4C, 0x75, 0x63, 0x69, 0x61, 0x00, 0x9C, 0x00, 0x11, 0x41, 0x6D, 0x65, 0x72, 0x69, 0x63, 0x61,
+    0x2F, 0x53, 0x74, 0x5F, 0x54, 0x68, 0x6F, 0x6D, 0x61, 0x73, 0x00, 0x9C, 0x0B, 0x07, 0x56, 0x69,
+    0x6E, 0x63, 0x65, 0x6E, 0x74, 0x00, 0x9C, 0x09, 0x0C, 0x77, 0x69, 0x66, 0x74, 0x5F, 0x43, 0x75,
+    0x72, 0x72, 0x65, 0x6E, 0x74, 0x00, 0xAD, 0x08, 0x0B, 0x54, 0x65, 0x67, 0x75, 0x63, 0x69, 0x67,
+    0x61, 0x6C, 0x70, 0x61, 0x00, 0xAD, 0x09, 0x04, 0x68, 0x75, 0x6C, 0x65, 0x01, 0x21, 0x0B, 0x08,
+    0x6E, 0x64, 0x65, 0x72, 0x5F, 0x42, 0x61, 0x79, 0x00, 0xF3, 0x09, 0x06, 0x69, 0x6A, 0x75, 0x61,
+    0x6E, 0x61, 0x01, 0x0A, 0x09, 0x06, 0x6F, 0x72, 0x6F, 0x6E, 0x74, 0x6F, 0x00, 0xF3, 0x0B, 0x04,
+    0x74, 0x6F, 0x6C, 0x61, 0x00, 0x9C, 0x08, 0x09, 0x56, 0x61, 0x6E, 0x63, 0x6F, 0x75, 0x76, 0x65,
+    0x72, 0x01, 0x0A, 0x09, 0x05, 0x69, 0x72, 0x67, 0x69, 0x6E, 0x00, 0x9C, 0x08, 0x0A, 0x57, 0x68,
+    0x69, 0x74, 0x65, 0x68, 0x6F, 0x72, 0x73, 0x65, 0x00, 0xEE, 0x09, 0x07, 0x69, 0x6E, 0x6E, 0x69,
+    0x70, 0x65, 0x67, 0x00, 0xD7, 0x08, 0x07, 0x59, 0x61, 0x6B, 0x75, 0x74, 0x61, 0x74, 0x00, 0x83,
+    0x09, 0x0A, 0x65, 0x6C, 0x6C, 0x6F, 0x77, 0x6B, 0x6E, 0x69, 0x66, 0x65, 0x00, 0xC0, 0x01, 0x0F,
+    0x6E, 0x74, 0x61, 0x72, 0x63, 0x74, 0x69, 0x63, 0x61, 0x2F, 0x43, 0x61, 0x73, 0x65, 0x79, 0x01,
+    0xCF, 0x00, 0x10, 0x41, 0x6E, 0x74, 0x61, 0x72, 0x63, 0x74, 0x69, 0x63, 0x61, 0x2F, 0x44, 0x61,
+    0x76, 0x69, 0x73, 0x01, 0xD7, 0x0C, 0x0D, 0x75, 0x6D, 0x6F, 0x6E, 0x74, 0x44, 0x55, 0x72, 0x76,
+    0x69, 0x6C, 0x6C, 0x65, 0x01, 0xDF, 0x0B, 0x09, 0x4D, 0x61, 0x63, 0x71, 0x75, 0x61, 0x72, 0x69,
+    0x65, 0x01, 0xE8, 0x0D, 0x04, 0x77, 0x73, 0x6F, 0x6E, 0x02, 0x05, 0x0C, 0x06, 0x63, 0x4D, 0x75,
+    0x72, 0x64, 0x6F, 0x02, 0x0D, 0x0B, 0x06, 0x50, 0x61, 0x6C, 0x6D, 0x65, 0x72, 0x00, 0xA1, 0x0B,
+    0x07, 0x52, 0x6F, 0x74, 0x68, 0x65, 0x72, 0x61, 0x00, 0xA1, 0x0B, 0x0A, 0x53, 0x6F, 0x75, 0x74,
+    0x68, 0x5F, 0x50, 0x6F, 0x6C, 0x65, 0x02, 0x0D, 0x0C, 0x04, 0x79, 0x6F, 0x77, 0x61, 0x02, 0x29,
+    0x0B, 0x05, 0x54, 0x72, 0x6F, 0x6C, 0x6C, 0x02, 0x31, 0x0B, 0x06, 0x56, 0x6F, 0x73, 0x74, 0x6F,
+    0x6B, 0x02, 0x05, 0x01, 0x12, 0x72, 0x63, 0x74, 0x69, 0x63, 0x2F, 0x4C, 0x6F, 0x6E, 0x67, 0x79,
+    0x65, 0x61, 0x72, 0x62, 0x79, 0x65, 0x6E, 0x00, 0x43, 0x01, 0x08, 0x73, 0x69, 0x61, 0x2F, 0x41,
+    0x64, 0x65, 0x6E, 0x02, 0x29, 0x06, 0x05, 0x6C, 0x6D, 0x61, 0x74, 0x79, 0x02, 0x05, 0x06, 0x04,
+    0x6D, 0x6D, 0x61, 0x6E, 0x02, 0x29, 0x06, 0x05, 0x6E, 0x61, 0x64, 0x79, 0x72, 0x02, 0x52, 0x00,
+    0x0A, 0x41, 0x73, 0x69, 0x61, 0x2F, 0x41, 0x71, 0x74, 0x61, 0x75, 0x02, 0x05, 0x08, 0x03, 0x6F,
+    0x62, 0x65, 0x02, 0x05, 0x06, 0x07, 0x73, 0x68, 0x67, 0x61, 0x62, 0x61, 0x74, 0x02, 0x05, 0x08,
+    0x06, 0x6B, 0x68, 0x61, 0x62, 0x61, 0x64, 0x02, 0x05, 0x06, 0x05, 0x74, 0x79, 0x72, 0x61, 0x75,
+    0x02, 0x05, 0x05, 0x07, 0x42, 0x61, 0x67, 0x68, 0x64, 0x61, 0x64, 0x02, 0x29, 0x07, 0x05, 0x68,
+    0x72, 0x61, 0x69, 0x6E, 0x02, 0x29, 0x07, 0x02, 0x6B, 0x75, 0x02, 0x5B, 0x07, 0x05, 0x6E, 0x67,
+    0x6B, 0x6F, 0x6B, 0x01, 0xD7, 0x07, 0x05, 0x72, 0x6E, 0x61, 0x75, 0x6C, 0x01, 0xD7, 0x06, 0x05,
+    0x65, 0x69, 0x72, 0x75, 0x74, 0x02, 0x63, 0x06, 0x06, 0x69, 0x73, 0x68, 0x6B, 0x65, 0x6B, 0x02,
+    0x80, 0x06, 0x05, 0x72, 0x75, 0x6E, 0x65, 0x69, 0x01, 0xCF, 0x05, 0x08, 0x43, 0x61, 0x6C, 0x63,
+    0x75, 0x74, 0x74, 0x61, 0x02, 0x88, 0x06, 0x04, 0x68, 0x69, 0x74, 0x61, 0x02, 0x91, 0x07, 0x08,
+    0x6F, 0x69, 0x62, 0x61, 0x6C, 0x73, 0x61, 0x6E, 0x01, 0xCF, 0x00, 0x0E, 0x41, 0x73, 0x69, 0x61,
+    0x2F, 0x43, 0x68, 0x6F, 0x6E, 0x67, 0x71, 0x69, 0x6E, 0x67, 0x02, 0x99, 0x07, 0x07, 0x75, 0x6E,
+    0x67, 0x6B, 0x69, 0x6E, 0x67, 0x02, 0x99, 0x06, 0x06, 0x6F, 0x6C, 0x6F, 0x6D, 0x62, 0x6F, 0x02,
+    0x9F, 0x05, 0x05, 0x44, 0x61, 0x63, 0x63, 0x61, 0x02, 0x80, 0x07, 0x06, 0x6D, 0x61, 0x73, 0x63,
+    0x75, 0x73, 0x02, 0x29, 0x06, 0x04, 0x68, 0x61, 0x6B, 0x61, 0x02, 0x80, 0x06, 0x03, 0x69, 0x6C,
+    0x69, 0x02, 0x91, 0x06, 0x04, 0x75, 0x62, 0x61, 0x69, 0x02, 0x5B, 0x07, 0x06, 0x73, 0x68, 0x61,
+    0x6E, 0x62, 0x65, 0x02, 0x05, 0x05, 0x09, 0x46, 0x61, 0x6D, 0x61, 0x67, 0x75, 0x73, 0x74, 0x61,
+    0x02, 0xAC, 0x05, 0x04, 0x47, 0x61, 0x7A, 0x61, 0x02, 0xC9, 0x05, 0x06, 0x48, 0x61, 0x72, 0x62,
+    0x69, 0x6E, 0x02, 0x99, 0x06, 0x05, 0x65, 0x62, 0x72, 0x6F, 0x6E, 0x02, 0xC9, 0x06, 0x0A, 0x6F,
+    0x5F, 0x43, 0x68, 0x69, 0x5F, 0x4D, 0x69, 0x6E, 0x68, 0x01, 0xD7, 0x07, 0x07, 0x6E, 0x67, 0x5F,
+    0x4B, 0x6F, 0x6E, 0x67, 0x02, 0xE8, 0x07, 0x02, 0x76, 0x64, 0x01, 0xD7, 0x00, 0x0C, 0x41, 0x73,
+    0x69, 0x61, 0x2F, 0x49, 0x72, 0x6B, 0x75, 0x74, 0x73, 0x6B, 0x01, 0xCF, 0x06, 0x07, 0x73, 0x74,
+    0x61, 0x6E, 0x62, 0x75, 0x6C, 0x02, 0x29, 0x05, 0x07, 0x4A, 0x61, 0x6B, 0x61, 0x72, 0x74, 0x61,
+    0x02, 0xEE, 0x07, 0x06, 0x79, 0x61, 0x70, 0x75, 0x72, 0x61, 0x02, 0xF4, 0x06, 0x08, 0x65, 0x72,
+    0x75, 0x73, 0x61, 0x6C, 0x65, 0x6D, 0x02, 0xFA, 0x05, 0x05, 0x4B, 0x61, 0x62, 0x75, 0x6C, 0x03,
+    0x15, 0x07, 0x07, 0x6D, 0x63, 0x68, 0x61, 0x74, 0x6B, 0x61, 0x02, 0x52, 0x07, 0x05, 0x72, 0x61,
+    0x63, 0x68, 0x69, 0x03, 0x22, 0x07, 0x05, 0x73, 0x68, 0x67, 0x61, 0x72, 0x02, 0x80, 0x07, 0x07,
+    0x74, 0x68, 0x6D, 0x61, 0x6E, 0x64, 0x75, 0x03, 0x28, 0x08, 0x05, 0x6D, 0x61, 0x6E, 0x64, 0x75,
+    0x03, 0x28, 0x06, 0x07, 0x68, 0x61, 0x6E, 0x64, 0x79, 0x67, 0x61, 0x02, 0x91, 0x06, 0x06, 0x6F,
+    0x6C, 0x6B, 0x61, 0x74, 0x61, 0x02, 0x88, 0x06, 0x0A, 0x72, 0x61, 0x73, 0x6E, 0x6F, 0x79, 0x61,
+    0x72, 0x73, 0x6B, 0x01, 0xD7, 0x06, 0x0B, 0x75, 0x61, 0x6C, 0x61, 0x5F, 0x4C, 0x75, 0x6D, 0x70,
+    0x75, 0x72, 0x01, 0xCF, 0x07, 0x05, 0x63, 0x68, 0x69, 0x6E, 0x67, 0x01, 0xCF, 0x00, 0x0B, 0x41,
+    0x73, 0x69, 0x61, 0x2F, 0x4B, 0x75, 0x77, 0x61, 0x69, 0x74, 0x02, 0x29, 0x05, 0x05, 0x4D, 0x61,
+    0x63, 0x61, 0x6F, 0x02, 0x99, 0x09, 0x01, 0x75, 0x02, 0x99, 0x07, 0x05, 0x67, 0x61, 0x64, 0x61,
+    0x6E, 0x03, 0x35, 0x07, 0x06, 0x6B, 0x61, 0x73, 0x73, 0x61, 0x72, 0x03, 0x3E, 0x07, 0x04, 0x6E,
+    0x69, 0x6C, 0x61, 0x03, 0x45, 0x06, 0x05, 0x75, 0x73, 0x63, 0x61, 0x74, 0x02, 0x5B, 0x05, 0x07,
+    0x4E, 0x69, 0x63, 0x6F, 0x73, 0x69, 0x61, 0x02, 0xAC, 0x06, 0x0B, 0x6F, 0x76, 0x6F, 0x6B, 0x75,
+    0x7A, 0x6E, 0x65, 0x74, 0x73, 0x6B, 0x01, 0xD7, 0x09, 0x07, 0x73, 0x69, 0x62, 0x69, 0x72, 0x73,
+    0x6B, 0x01, 0xD7, 0x05, 0x04, 0x4F, 0x6D, 0x73, 0x6B, 0x02, 0x80, 0x06, 0x03, 0x72, 0x61, 0x6C,
+    0x02, 0x05, 0x05, 0x0A, 0x50, 0x68, 0x6E, 0x6F, 0x6D, 0x5F, 0x50, 0x65, 0x6E, 0x68, 0x01, 0xD7,
+    0x06, 0x08, 0x6F, 0x6E, 0x74, 0x69, 0x61, 0x6E, 0x61, 0x6B, 0x02, 0xEE, 0x06, 0x08, 0x79, 0x6F,
+    0x6E, 0x67, 0x79, 0x61, 0x6E, 0x67, 0x03, 0x4B, 0x05, 0x05, 0x51, 0x61, 0x74, 0x61, 0x72, 0x02,
+    0x29, 0x00, 0x0D, 0x41, 0x73, 0x69, 0x61, 0x2F, 0x51, 0x6F, 0x73, 0x74, 0x61, 0x6E, 0x61, 0x79,
+    0x02, 0x05, 0x06, 0x08, 0x79, 0x7A, 0x79, 0x6C, 0x6F, 0x72, 0x64, 0x61, 0x02, 0x05, 0x05, 0x07,
+    0x52, 0x61, 0x6E, 0x67, 0x6F, 0x6F, 0x6E, 0x03, 0x51, 0x06, 0x05, 0x69, 0x79, 0x61, 0x64, 0x68,
+    0x02, 0x29, 0x05, 0x06, 0x53, 0x61, 0x69, 0x67, 0x6F, 0x6E, 0x01, 0xD7, 0x07, 0x06, 0x6B, 0x68,
+    0x61, 0x6C, 0x69, 0x6E, 0x03, 0x35, 0x07, 0x07, 0x6D, 0x61, 0x72, 0x6B, 0x61, 0x6E, 0x64, 0x02,
+    0x05, 0x06, 0x04, 0x65, 0x6F, 0x75, 0x6C, 0x03, 0x4B, 0x06, 0x07, 0x68, 0x61, 0x6E, 0x67, 0x68,
+    0x61, 0x69, 0x02, 0x99, 0x06, 0x08, 0x69, 0x6E, 0x67, 0x61, 0x70, 0x6F, 0x72, 0x65, 0x01, 0xCF,
+    0x06, 0x0C, 0x72, 0x65, 0x64, 0x6E, 0x65, 0x6B, 0x6F, 0x6C, 0x79, 0x6D, 0x73, 0x6B, 0x03, 0x35,
+    0x05, 0x06, 0x54, 0x61, 0x69, 0x70, 0x65, 0x69, 0x02, 0x99, 0x07, 0x06, 0x73, 0x68, 0x6B, 0x65,
+    0x6E, 0x74, 0x02, 0x05, 0x06, 0x06, 0x62, 0x69, 0x6C, 0x69, 0x73, 0x69, 0x02, 0x5B, 0x06, 0x05,
+    0x65, 0x68, 0x72, 0x61, 0x6E, 0x03, 0x5E, 0x07, 0x06, 0x6C, 0x5F, 0x41, 0x76, 0x69, 0x76, 0x02,
+    0xFA, 0x00, 0x0B, 0x41, 0x73, 0x69, 0x61, 0x2F, 0x54, 0x68, 0x69, 0x6D, 0x62, 0x75, 0x02, 0x80,
+    0x09, 0x03, 0x70, 0x68, 0x75, 0x02, 0x80, 0x06, 0x04, 0x6F, 0x6B, 0x79, 0x6F, 0x03, 0x6B, 0x07,
+    0x03, 0x6D, 0x73, 0x6B, 0x01, 0xD7, 0x05, 0x0D, 0x55, 0x6A, 0x75, 0x6E, 0x67, 0x5F, 0x50, 0x61,
+    0x6E, 0x64, 0x61, 0x6E, 0x67, 0x03, 0x3E, 0x06, 0x0A, 0x6C, 0x61, 0x61, 0x6E, 0x62, 0x61, 0x61,
+    0x74, 0x61, 0x72, 0x01, 0xCF, 0x08, 0x07, 0x6E, 0x5F, 0x42, 0x61, 0x74, 0x6F, 0x72, 0x01, 0xCF,
+    0x06, 0x05, 0x72, 0x75, 0x6D, 0x71, 0x69, 0x02, 0x80, 0x06, 0x07, 0x73, 0x74, 0x2D, 0x4E, 0x65,
+    0x72, 0x61, 0x01, 0xDF, 0x05, 0x09, 0x56, 0x69, 0x65, 0x6E, 0x74, 0x69, 0x61, 0x6E, 0x65, 0x01,
+    0xD7, 0x06, 0x0A, 0x6C, 0x61, 0x64, 0x69, 0x76, 0x6F, 0x73, 0x74, 0x6F, 0x6B, 0x01, 0xDF, 0x05,
+    0x07, 0x59, 0x61, 0x6B, 0x75, 0x74, 0x73, 0x6B, 0x02, 0x91, 0x07, 0x04, 0x6E, 0x67, 0x6F, 0x6E,
+    0x03, 0x51, 0x06, 0x0C, 0x65, 0x6B, 0x61, 0x74, 0x65, 0x72, 0x69, 0x6E, 0x62, 0x75, 0x72, 0x67,
+    0x02, 0x05, 0x07, 0x05, 0x72, 0x65, 0x76, 0x61, 0x6E, 0x02, 0x5B, 0x01, 0x0E, 0x74, 0x6C, 0x61,
+    0x6E, 0x74, 0x69, 0x63, 0x2F, 0x41, 0x7A, 0x6F, 0x72, 0x65, 0x73, 0x03, 0x71, 0x00, 0x10, 0x41,
+    0x74, 0x6C, 0x61, 0x6E, 0x74, 0x69, 0x63, 0x2F, 0x42, 0x65, 0x72, 0x6D, 0x75, 0x64, 0x61, 0x01,
+    0x21, 0x09, 0x06, 0x43, 0x61, 0x6E, 0x61, 0x72, 0x79, 0x03, 0x90, 0x0B, 0x08, 0x70, 0x65, 0x5F,
+    0x56, 0x65, 0x72, 0x64, 0x65, 0x03, 0xAA, 0x09, 0x06, 0x46, 0x61, 0x65, 0x72, 0x6F, 0x65, 0x03,
+    0x90, 0x0B, 0x03, 0x72, 0x6F, 0x65, 0x03, 0x90, 0x09, 0x09, 0x4A, 0x61, 0x6E, 0x5F, 0x4D, 0x61,
+    0x79, 0x65, 0x6E, 0x00, 0x43, 0x09, 0x07, 0x4D, 0x61, 0x64, 0x65, 0x69, 0x72, 0x61, 0x03, 0x90,
+    0x09, 0x09, 0x52, 0x65, 0x79, 0x6B, 0x6A, 0x61, 0x76, 0x69, 0x6B, 0x00, 0x00, 0x09, 0x0D, 0x53,
+    0x6F, 0x75, 0x74, 0x68, 0x5F, 0x47, 0x65, 0x6F, 0x72, 0x67, 0x69, 0x61, 0x01, 0x8E, 0x0A, 0x08,
+    0x74, 0x5F, 0x48, 0x65, 0x6C, 0x65, 0x6E, 0x61, 0x00, 0x00, 0x0B, 0x05, 0x61, 0x6E, 0x6C, 0x65,
+    0x79, 0x00, 0xA1, 0x01, 0x0C, 0x75, 0x73, 0x74, 0x72, 0x61, 0x6C, 0x69, 0x61, 0x2F, 0x41, 0x43,
+    0x54, 0x01, 0xE8, 0x0B, 0x07, 0x64, 0x65, 0x6C, 0x61, 0x69, 0x64, 0x65, 0x03, 0xB1, 0x0A, 0x08,
+    0x42, 0x72, 0x69, 0x73, 0x62, 0x61, 0x6E, 0x65, 0x03, 0xD0, 0x0C, 0x09, 0x6F, 0x6B, 0x65, 0x6E,
+    0x5F, 0x48, 0x69, 0x6C, 0x6C, 0x03, 0xB1, 0x0A, 0x08, 0x43, 0x61, 0x6E, 0x62, 0x65, 0x72, 0x72,
+    0x61, 0x01, 0xE8, 0x00, 0x10, 0x41, 0x75, 0x73, 0x74, 0x72, 0x61, 0x6C, 0x69, 0x61, 0x2F, 0x43,
+    0x75, 0x72, 0x72, 0x69, 0x65, 0x01, 0xE8, 0x0A, 0x06, 0x44, 0x61, 0x72, 0x77, 0x69, 0x6E, 0x03,
+    0xD8, 0x0A, 0x05, 0x45, 0x75, 0x63, 0x6C, 0x61, 0x03, 0xE2, 0x0A, 0x06, 0x48, 0x6F, 0x62, 0x61,
+    0x72, 0x74, 0x01, 0xE8, 0x0A, 0x03, 0x4C, 0x48, 0x49, 0x03, 0xEF, 0x0B, 0x07, 0x69, 0x6E, 0x64,
+    0x65, 0x6D, 0x61, 0x6E, 0x03, 0xD0, 0x0B, 0x08, 0x6F, 0x72, 0x64, 0x5F, 0x48, 0x6F, 0x77, 0x65,
+    0x03, 0xEF, 0x0A, 0x09, 0x4D, 0x65, 0x6C, 0x62, 0x6F, 0x75, 0x72, 0x6E, 0x65, 0x01, 0xE8, 0x0A,
+    0x03, 0x4E, 0x53, 0x57, 0x01, 0xE8, 0x0B, 0x04, 0x6F, 0x72, 0x74, 0x68, 0x03, 0xD8, 0x0A, 0x05,
+    0x50, 0x65, 0x72, 0x74, 0x68, 0x04, 0x14, 0x0A, 0x0A, 0x51, 0x75, 0x65, 0x65, 0x6E, 0x73, 0x6C,
+    0x61, 0x6E, 0x64, 0x03, 0xD0, 0x0A, 0x05, 0x53, 0x6F, 0x75, 0x74, 0x68, 0x03, 0xB1, 0x0B, 0x05,
+    0x79, 0x64, 0x6E, 0x65, 0x79, 0x01, 0xE8, 0x0A, 0x08, 0x54, 0x61, 0x73, 0x6D, 0x61, 0x6E, 0x69,
+    0x61, 0x01, 0xE8, 0x0A, 0x08, 0x56, 0x69, 0x63, 0x74, 0x6F, 0x72, 0x69, 0x61, 0x01, 0xE8, 0x00,
+    0x0E, 0x41, 0x75, 0x73, 0x74, 0x72, 0x61, 0x6C, 0x69, 0x61, 0x2F, 0x57, 0x65, 0x73, 0x74, 0x04,
+    0x14, 0x0A, 0x0A, 0x59, 0x61, 0x6E, 0x63, 0x6F, 0x77, 0x69, 0x6E, 0x6E, 0x61, 0x03, 0xB1, 0x00,
+    0x0B, 0x42, 0x72, 0x61, 0x7A, 0x69, 0x6C, 0x2F, 0x41, 0x63, 0x72, 0x65, 0x00, 0xB9, 0x07, 0x09,
+    0x44, 0x65, 0x4E, 0x6F, 0x72, 0x6F, 0x6E, 0x68, 0x61, 0x01, 0x8E, 0x07, 0x04, 0x45, 0x61, 0x73,
+    0x74, 0x00, 0xA1, 0x07, 0x04, 0x57, 0x65, 0x73, 0x74, 0x00, 0xB2, 0x00, 0x03, 0x43, 0x45, 0x54,
+    0x00, 0x43, 0x01, 0x06, 0x53, 0x54, 0x36, 0x43, 0x44, 0x54, 0x00, 0xD7, 0x01, 0x0E, 0x61, 0x6E,
+    0x61, 0x64, 0x61, 0x2F, 0x41, 0x74, 0x6C, 0x61, 0x6E, 0x74, 0x69, 0x63, 0x01, 0x21, 0x07, 0x07,
+    0x43, 0x65, 0x6E, 0x74, 0x72, 0x61, 0x6C, 0x00, 0xD7, 0x07, 0x07, 0x45, 0x61, 0x73, 0x74, 0x65,
+    0x72, 0x6E, 0x00, 0xF3, 0x07, 0x08, 0x4D, 0x6F, 0x75, 0x6E, 0x74, 0x61, 0x69, 0x6E, 0x00, 0xC0,
+    0x07, 0x0C, 0x4E, 0x65, 0x77, 0x66, 0x6F, 0x75, 0x6E, 0x64, 0x6C, 0x61, 0x6E, 0x64, 0x01, 0xB5,
+    0x07, 0x07, 0x50, 0x61, 0x63, 0x69, 0x66, 0x69, 0x63, 0x01, 0x0A, 0x07, 0x0C, 0x53, 0x61, 0x73,
+    0x6B, 0x61, 0x74, 0x63, 0x68, 0x65, 0x77, 0x61, 0x6E, 0x00, 0xAD, 0x07, 0x05, 0x59, 0x75, 0x6B,
+    0x6F, 0x6E, 0x00, 0xEE, 0x00, 0x11, 0x43, 0x68, 0x69, 0x6C, 0x65, 0x2F, 0x43, 0x6F, 0x6E, 0x74,
+    0x69, 0x6E, 0x65, 0x6E, 0x74, 0x61, 0x6C, 0x01, 0x95, 0x06, 0x0C, 0x45, 0x61, 0x73, 0x74, 0x65,
+    0x72, 0x49, 0x73, 0x6C, 0x61, 0x6E, 0x64, 0x04, 0x1B, 0x01, 0x03, 0x75, 0x62, 0x61, 0x01, 0x58,
+    0x00, 0x03, 0x45, 0x45, 0x54, 0x02, 0xAC, 0x01, 0x02, 0x53, 0x54, 0x00, 0xA8, 0x03, 0x04, 0x35,
+    0x45, 0x44, 0x54, 0x00, 0xF3, 0x01, 0x04, 0x67, 0x79, 0x70, 0x74, 0x00, 0x1D, 0x01, 0x03, 0x69,
+    0x72, 0x65, 0x04, 0x3B, 0x01, 0x06, 0x74, 0x63, 0x2F, 0x47, 0x4D, 0x54, 0x00, 0x00, 0x07, 0x02,
+    0x2B, 0x30, 0x00, 0x00, 0x08, 0x01, 0x31, 0x03, 0xAA, 0x09, 0x01, 0x30, 0x04, 0x56, 0x09, 0x01,
+    0x31, 0x04, 0x5E, 0x09, 0x01, 0x32, 0x04, 0x66, 0x08, 0x01, 0x32, 0x01, 0x8E, 0x08, 0x01, 0x33,
+    0x00, 0xA1, 0x00, 0x09, 0x45, 0x74, 0x63, 0x2F, 0x47, 0x4D, 0x54, 0x2B, 0x34, 0x00, 0xB2, 0x08,
+    0x01, 0x35, 0x00, 0xB9, 0x08, 0x01, 0x36, 0x04, 0x6E, 0x08, 0x01, 0x37, 0x04, 0x75, 0x08, 0x01,
+    0x38, 0x04, 0x7C, 0x08, 0x01, 0x39, 0x04, 0x83, 0x07, 0x02, 0x2D, 0x30, 0x00, 0x00, 0x08, 0x01,
+    0x31, 0x00, 0x3B, 0x09, 0x01, 0x30, 0x01, 0xDF, 0x09, 0x01, 0x31, 0x03, 0x35, 0x09, 0x01, 0x32,
+    0x02, 0x52, 0x09, 0x01, 0x33, 0x04, 0x8A, 0x09, 0x01, 0x34, 0x04, 0x93, 0x08, 0x01, 0x32, 0x04,
+    0x9C, 0x08, 0x01, 0x33, 0x02, 0x29, 0x08, 0x01, 0x34, 0x02, 0x5B, 0x00, 0x09, 0x45, 0x74, 0x63,
+    0x2F, 0x47, 0x4D, 0x54, 0x2D, 0x35, 0x02, 0x05, 0x08, 0x01, 0x36, 0x02, 0x80, 0x08, 0x01, 0x37,
+    0x01, 0xD7, 0x08, 0x01, 0x38, 0x01, 0xCF, 0x08, 0x01, 0x39, 0x02, 0x91, 0x07, 0x01, 0x30, 0x00,
+    0x00, 0x05, 0x08, 0x72, 0x65, 0x65, 0x6E, 0x77, 0x69, 0x63, 0x68, 0x00, 0x00, 0x04, 0x03, 0x55,
+    0x43, 0x54, 0x04, 0xA4, 0x05, 0x02, 0x54, 0x43, 0x04, 0xA4, 0x05, 0x08, 0x6E, 0x69, 0x76, 0x65,
+    0x72, 0x73, 0x61, 0x6C, 0x04, 0xA4, 0x04, 0x04, 0x5A, 0x75, 0x6C, 0x75, 0x04, 0xA4, 0x01, 0x0F,
+    0x75, 0x72, 0x6F, 0x70, 0x65, 0x2F, 0x41, 0x6D, 0x73, 0x74, 0x65, 0x72, 0x64, 0x61, 0x6D, 0x00,
+    0x43, 0x08, 0x06, 0x6E, 0x64, 0x6F, 0x72, 0x72, 0x61, 0x00, 0x43, 0x08, 0x08, 0x73, 0x74, 0x72,
+    0x61, 0x6B, 0x68, 0x61, 0x6E, 0x02, 0x5B, 0x08, 0x05, 0x74, 0x68, 0x65, 0x6E, 0x73, 0x02, 0xAC,
+    0x07, 0x07, 0x42, 0x65, 0x6C, 0x66, 0x61, 0x73, 0x74, 0x04, 0xA9, 0x00, 0x0F, 0x45, 0x75, 0x72,
+    0x6F, 0x70, 0x65, 0x2F, 0x42, 0x65, 0x6C, 0x67, 0x72, 0x61, 0x64, 0x65, 0x00, 0x43, 0x09, 0x04,
+    0x72, 0x6C, 0x69, 0x6E, 0x00, 0x43, 0x08, 0x09, 0x72, 0x61, 0x74, 0x69, 0x73, 0x6C, 0x61, 0x76,
+    0x61, 0x00, 0x43, 0x09, 0x06, 0x75, 0x73, 0x73, 0x65, 0x6C, 0x73, 0x00, 0x43, 0x08, 0x08, 0x75,
+    0x63, 0x68, 0x61, 0x72, 0x65, 0x73, 0x74, 0x02, 0xAC, 0x09, 0x06, 0x64, 0x61, 0x70, 0x65, 0x73,
+    0x74, 0x00, 0x43, 0x09, 0x06, 0x73, 0x69, 0x6E, 0x67, 0x65, 0x6E, 0x00, 0x43, 0x07, 0x08, 0x43,
+    0x68, 0x69, 0x73, 0x69, 0x6E, 0x61, 0x75, 0x04, 0xC2, 0x08, 0x09, 0x6F, 0x70, 0x65, 0x6E, 0x68,
+    0x61, 0x67, 0x65, 0x6E, 0x00, 0x43, 0x07, 0x06, 0x44, 0x75, 0x62, 0x6C, 0x69, 0x6E, 0x04, 0x3B,
+    0x07, 0x09, 0x47, 0x69, 0x62, 0x72, 0x61, 0x6C, 0x74, 0x61, 0x72, 0x00, 0x43, 0x08, 0x07, 0x75,
+    0x65, 0x72, 0x6E, 0x73, 0x65, 0x79, 0x04, 0xA9, 0x07, 0x08, 0x48, 0x65, 0x6C, 0x73, 0x69, 0x6E,
+    0x6B, 0x69, 0x02, 0xAC, 0x07, 0x0B, 0x49, 0x73, 0x6C, 0x65, 0x5F, 0x6F, 0x66, 0x5F, 0x4D, 0x61,
+    0x6E, 0x04, 0xA9, 0x09, 0x06, 0x74, 0x61, 0x6E, 0x62, 0x75, 0x6C, 0x02, 0x29, 0x07, 0x06, 0x4A,
+    0x65, 0x72, 0x73, 0x65, 0x79, 0x04, 0xA9, 0x00, 0x12, 0x45, 0x75, 0x72, 0x6F, 0x70, 0x65, 0x2F,
+    0x4B, 0x61, 0x6C, 0x69, 0x6E, 0x69, 0x6E, 0x67, 0x72, 0x61, 0x64, 0x00, 0x65, 0x08, 0x03, 0x69,
+    0x65, 0x76, 0x02, 0xAC, 0x09, 0x03, 0x72, 0x6F, 0x76, 0x04, 0xDD, 0x08, 0x03, 0x79, 0x69, 0x76,
+    0x02, 0xAC, 0x07, 0x06, 0x4C, 0x69, 0x73, 0x62, 0x6F, 0x6E, 0x03, 0x90, 0x08, 0x08, 0x6A, 0x75,
+    0x62, 0x6C, 0x6A, 0x61, 0x6E, 0x61, 0x00, 0x43, 0x08, 0x05, 0x6F, 0x6E, 0x64, 0x6F, 0x6E, 0x04,
+    0xA9, 0x08, 0x09, 0x75, 0x78, 0x65, 0x6D, 0x62, 0x6F, 0x75, 0x72, 0x67, 0x00, 0x43, 0x07, 0x06,
+    0x4D, 0x61, 0x64, 0x72, 0x69, 0x64, 0x00, 0x43, 0x09, 0x03, 0x6C, 0x74, 0x61, 0x00, 0x43, 0x09,
+    0x07, 0x72, 0x69, 0x65, 0x68, 0x61, 0x6D, 0x6E, 0x02, 0xAC, 0x08, 0x04, 0x69, 0x6E, 0x73, 0x6B,
+    0x02, 0x29, 0x08, 0x05, 0x6F, 0x6E, 0x61, 0x63, 0x6F, 0x00, 0x43, 0x09, 0x04, 0x73, 0x63, 0x6F,
+    0x77, 0x04, 0xDD, 0x07, 0x07, 0x4E, 0x69, 0x63, 0x6F, 0x73, 0x69, 0x61, 0x02, 0xAC, 0x07, 0x04,
+    0x4F, 0x73, 0x6C, 0x6F, 0x00, 0x43, 0x00, 0x0C, 0x45, 0x75, 0x72, 0x6F, 0x70, 0x65, 0x2F, 0x50,
+    0x61, 0x72, 0x69, 0x73, 0x00, 0x43, 0x08, 0x08, 0x6F, 0x64, 0x67, 0x6F, 0x72, 0x69, 0x63, 0x61,
+    0x00, 0x43, 0x08, 0x05, 0x72, 0x61, 0x67, 0x75, 0x65, 0x00, 0x43, 0x07, 0x04, 0x52, 0x69, 0x67,
+    0x61, 0x02, 0xAC, 0x08, 0x03, 0x6F, 0x6D, 0x65, 0x00, 0x43, 0x07, 0x06, 0x53, 0x61, 0x6D, 0x61,
+    0x72, 0x61, 0x02, 0x5B, 0x09, 0x08, 0x6E, 0x5F, 0x4D, 0x61, 0x72, 0x69, 0x6E, 0x6F, 0x00, 0x43,
+    0x09, 0x06, 0x72, 0x61, 0x6A, 0x65, 0x76, 0x6F, 0x00, 0x43, 0x0B, 0x03, 0x74, 0x6F, 0x76, 0x02,
+    0x5B, 0x08, 0x09, 0x69, 0x6D, 0x66, 0x65, 0x72, 0x6F, 0x70, 0x6F, 0x6C, 0x04, 0xDD, 0x08, 0x05,
+    0x6B, 0x6F, 0x70, 0x6A, 0x65, 0x00, 0x43, 0x08, 0x04, 0x6F, 0x66, 0x69, 0x61, 0x02, 0xAC, 0x08,
+    0x08, 0x74, 0x6F, 0x63, 0x6B, 0x68, 0x6F, 0x6C, 0x6D, 0x00, 0x43, 0x07, 0x07, 0x54, 0x61, 0x6C,
+    0x6C, 0x69, 0x6E, 0x6E, 0x02, 0xAC, 0x08, 0x05, 0x69, 0x72, 0x61, 0x6E, 0x65, 0x00, 0x43, 0x0B,
+    0x04, 0x73, 0x70, 0x6F, 0x6C, 0x04, 0xC2, 0x00, 0x10, 0x45, 0x75, 0x72, 0x6F, 0x70, 0x65, 0x2F,
+    0x55, 0x6C, 0x79, 0x61, 0x6E, 0x6F, 0x76, 0x73, 0x6B, 0x02, 0x5B, 0x08, 0x07, 0x7A, 0x68, 0x67,
+    0x6F, 0x72, 0x6F, 0x64, 0x02, 0xAC, 0x07, 0x05, 0x56, 0x61, 0x64, 0x75, 0x7A, 0x00, 0x43, 0x09,
+    0x05, 0x74, 0x69, 0x63, 0x61, 0x6E, 0x00, 0x43, 0x08, 0x05, 0x69, 0x65, 0x6E, 0x6E, 0x61, 0x00,
+    0x43, 0x09, 0x05, 0x6C, 0x6E, 0x69, 0x75, 0x73, 0x02, 0xAC, 0x08, 0x08, 0x6F, 0x6C, 0x67, 0x6F,
+    0x67, 0x72, 0x61, 0x64, 0x04, 0xDD, 0x07, 0x06, 0x57, 0x61, 0x72, 0x73, 0x61, 0x77, 0x00, 0x43,
+    0x07, 0x06, 0x5A, 0x61, 0x67, 0x72, 0x65, 0x62, 0x00, 0x43, 0x09, 0x08, 0x70, 0x6F, 0x72, 0x6F,
+    0x7A, 0x68, 0x79, 0x65, 0x02, 0xAC, 0x08, 0x05, 0x75, 0x72, 0x69, 0x63, 0x68, 0x00, 0x43, 0x00,
+    0x02, 0x47, 0x42, 0x04, 0xA9, 0x02, 0x05, 0x2D, 0x45, 0x69, 0x72, 0x65, 0x04, 0xA9, 0x01, 0x02,
+    0x4D, 0x54, 0x00, 0x00, 0x03, 0x02, 0x2B, 0x30, 0x00, 0x00, 0x03, 0x02, 0x2D, 0x30, 0x00, 0x00,
+    0x00, 0x04, 0x47, 0x4D, 0x54, 0x30, 0x00, 0x00, 0x01, 0x08, 0x72, 0x65, 0x65, 0x6E, 0x77, 0x69,
+    0x63, 0x68, 0x00, 0x00, 0x00, 0x03, 0x48, 0x53, 0x54, 0x04, 0xE3, 0x01, 0x07, 0x6F, 0x6E, 0x67,
+    0x6B, 0x6F, 0x6E, 0x67, 0x02, 0xE8, 0x00, 0x07, 0x49, 0x63, 0x65, 0x6C, 0x61, 0x6E, 0x64, 0x00,
+    0x00, 0x01, 0x12, 0x6E, 0x64, 0x69, 0x61, 0x6E, 0x2F, 0x41, 0x6E, 0x74, 0x61, 0x6E, 0x61, 0x6E,
+    0x61, 0x72, 0x69, 0x76, 0x6F, 0x00, 0x05, 0x07, 0x06, 0x43, 0x68, 0x61, 0x67, 0x6F, 0x73, 0x02,
+    0x80, 0x09, 0x07, 0x72, 0x69, 0x73, 0x74, 0x6D, 0x61, 0x73, 0x01, 0xD7, 0x08, 0x04, 0x6F, 0x63,
+    0x6F, 0x73, 0x03, 0x51, 0x09, 0x04, 0x6D, 0x6F, 0x72, 0x6F, 0x00, 0x05, 0x07, 0x09, 0x4B, 0x65,
+    0x72, 0x67, 0x75, 0x65, 0x6C, 0x65, 0x6E, 0x02, 0x05, 0x07, 0x04, 0x4D, 0x61, 0x68, 0x65, 0x02,
+    0x5B, 0x09, 0x06, 0x6C, 0x64, 0x69, 0x76, 0x65, 0x73, 0x02, 0x05, 0x09, 0x07, 0x75, 0x72, 0x69,
+    0x74, 0x69, 0x75, 0x73, 0x02, 0x5B, 0x09, 0x05, 0x79, 0x6F, 0x74, 0x74, 0x65, 0x00, 0x05, 0x07,
+    0x07, 0x52, 0x65, 0x75, 0x6E, 0x69, 0x6F, 0x6E, 0x02, 0x5B, 0x00, 0x04, 0x49, 0x72, 0x61, 0x6E,
+    0x03, 0x5E, 0x01, 0x05, 0x73, 0x72, 0x61, 0x65, 0x6C, 0x02, 0xFA, 0x00, 0x07, 0x4A, 0x61, 0x6D,
+    0x61, 0x69, 0x63, 0x61, 0x00, 0xA8, 0x02, 0x03, 0x70, 0x61, 0x6E, 0x03, 0x6B, 0x00, 0x09, 0x4B,
+    0x77, 0x61, 0x6A, 0x61, 0x6C, 0x65, 0x69, 0x6E, 0x02, 0x52, 0x00, 0x05, 0x4C, 0x69, 0x62, 0x79,
+    0x61, 0x00, 0x65, 0x00, 0x03, 0x4D, 0x45, 0x54, 0x04, 0xE9, 0x01, 0x02, 0x53, 0x54, 0x00, 0xEE,
+    0x03, 0x04, 0x37, 0x4D, 0x44, 0x54, 0x00, 0xC0, 0x01, 0x0F, 0x65, 0x78, 0x69, 0x63, 0x6F, 0x2F,
+    0x42, 0x61, 0x6A, 0x61, 0x4E, 0x6F, 0x72, 0x74, 0x65, 0x01, 0x0A, 0x0B, 0x03, 0x53, 0x75, 0x72,
+    0x00, 0xEE, 0x07, 0x07, 0x47, 0x65, 0x6E, 0x65, 0x72, 0x61, 0x6C, 0x00, 0xAD, 0x00, 0x02, 0x4E,
+    0x5A, 0x02, 0x0D, 0x02, 0x05, 0x2D, 0x43, 0x48, 0x41, 0x54, 0x05, 0x04, 0x01, 0x05, 0x61, 0x76,
+    0x61, 0x6A, 0x6F, 0x00, 0xC0, 0x00, 0x03, 0x50, 0x52, 0x43, 0x02, 0x99, 0x00, 0x07, 0x50, 0x53,
+    0x54, 0x38, 0x50, 0x44, 0x54, 0x01, 0x0A, 0x01, 0x0B, 0x61, 0x63, 0x69, 0x66, 0x69, 0x63, 0x2F,
+    0x41, 0x70, 0x69, 0x61, 0x04, 0x8A, 0x09, 0x07, 0x75, 0x63, 0x6B, 0x6C, 0x61, 0x6E, 0x64, 0x02,
+    0x0D, 0x08, 0x0C, 0x42, 0x6F, 0x75, 0x67, 0x61, 0x69, 0x6E, 0x76, 0x69, 0x6C, 0x6C, 0x65, 0x03,
+    0x35, 0x08, 0x07, 0x43, 0x68, 0x61, 0x74, 0x68, 0x61, 0x6D, 0x05, 0x04, 0x0A, 0x03, 0x75, 0x75,
+    0x6B, 0x01, 0xDF, 0x08, 0x06, 0x45, 0x61, 0x73, 0x74, 0x65, 0x72, 0x04, 0x1B, 0x09, 0x04, 0x66,
+    0x61, 0x74, 0x65, 0x03, 0x35, 0x09, 0x08, 0x6E, 0x64, 0x65, 0x72, 0x62, 0x75, 0x72, 0x79, 0x04,
+    0x8A, 0x08, 0x07, 0x46, 0x61, 0x6B, 0x61, 0x6F, 0x66, 0x6F, 0x04, 0x8A, 0x09, 0x03, 0x69, 0x6A,
+    0x69, 0x02, 0x52, 0x09, 0x07, 0x75, 0x6E, 0x61, 0x66, 0x75, 0x74, 0x69, 0x02, 0x52, 0x08, 0x09,
+    0x47, 0x61, 0x6C, 0x61, 0x70, 0x61, 0x67, 0x6F, 0x73, 0x04, 0x6E, 0x0A, 0x05, 0x6D, 0x62, 0x69,
+    0x65, 0x72, 0x04, 0x83, 0x09, 0x0A, 0x75, 0x61, 0x64, 0x61, 0x6C, 0x63, 0x61, 0x6E, 0x61, 0x6C,
+    0x03, 0x35, 0x0B, 0x01, 0x6D, 0x05, 0x31, 0x00, 0x10, 0x50, 0x61, 0x63, 0x69, 0x66, 0x69, 0x63,
+    0x2F, 0x48, 0x6F, 0x6E, 0x6F, 0x6C, 0x75, 0x6C, 0x75, 0x04, 0xE3, 0x08, 0x08, 0x4A, 0x6F, 0x68,
+    0x6E, 0x73, 0x74, 0x6F, 0x6E, 0x04, 0xE3, 0x08, 0x06, 0x4B, 0x61, 0x6E, 0x74, 0x6F, 0x6E, 0x04,
+    0x8A, 0x09, 0x09, 0x69, 0x72, 0x69, 0x74, 0x69, 0x6D, 0x61, 0x74, 0x69, 0x04, 0x93, 0x09, 0x05,
+    0x6F, 0x73, 0x72, 0x61, 0x65, 0x03, 0x35, 0x09, 0x08, 0x77, 0x61, 0x6A, 0x61, 0x6C, 0x65, 0x69,
+    0x6E, 0x02, 0x52, 0x08, 0x06, 0x4D, 0x61, 0x6A, 0x75, 0x72, 0x6F, 0x02, 0x52, 0x0A, 0x07, 0x72,
+    0x71, 0x75, 0x65, 0x73, 0x61, 0x73, 0x05, 0x39, 0x09, 0x05, 0x69, 0x64, 0x77, 0x61, 0x79, 0x05,
+    0x45, 0x08, 0x05, 0x4E, 0x61, 0x75, 0x72, 0x75, 0x02, 0x52, 0x09, 0x03, 0x69, 0x75, 0x65, 0x04,
+    0x5E, 0x09, 0x06, 0x6F, 0x72, 0x66, 0x6F, 0x6C, 0x6B, 0x05, 0x4B, 0x0A, 0x04, 0x75, 0x6D, 0x65,
+    0x61, 0x03, 0x35, 0x08, 0x09, 0x50, 0x61, 0x67, 0x6F, 0x5F, 0x50, 0x61, 0x67, 0x6F, 0x05, 0x45,
+    0x0A, 0x03, 0x6C, 0x61, 0x75, 0x02, 0x91, 0x09, 0x07, 0x69, 0x74, 0x63, 0x61, 0x69, 0x72, 0x6E,
+    0x04, 0x7C, 0x00, 0x0F, 0x50, 0x61, 0x63, 0x69, 0x66, 0x69, 0x63, 0x2F, 0x50, 0x6F, 0x68, 0x6E,
+    0x70, 0x65, 0x69, 0x03, 0x35, 0x0A, 0x04, 0x6E, 0x61, 0x70, 0x65, 0x03, 0x35, 0x0A, 0x0A, 0x72,
+    0x74, 0x5F, 0x4D, 0x6F, 0x72, 0x65, 0x73, 0x62, 0x79, 0x01, 0xDF, 0x08, 0x09, 0x52, 0x61, 0x72,
+    0x6F, 0x74, 0x6F, 0x6E, 0x67, 0x61, 0x04, 0x56, 0x08, 0x06, 0x53, 0x61, 0x69, 0x70, 0x61, 0x6E,
+    0x05, 0x31, 0x0A, 0x03, 0x6D, 0x6F, 0x61, 0x05, 0x45, 0x08, 0x06, 0x54, 0x61, 0x68, 0x69, 0x74,
+    0x69, 0x04, 0x56, 0x0A, 0x04, 0x72, 0x61, 0x77, 0x61, 0x02, 0x52, 0x09, 0x08, 0x6F, 0x6E, 0x67,
+    0x61, 0x74, 0x61, 0x70, 0x75, 0x04, 0x8A, 0x09, 0x03, 0x72, 0x75, 0x6B, 0x01, 0xDF, 0x08, 0x04,
+    0x57, 0x61, 0x6B, 0x65, 0x02, 0x52, 0x0A, 0x04, 0x6C, 0x6C, 0x69, 0x73, 0x02, 0x52, 0x08, 0x03,
+    0x59, 0x61, 0x70, 0x01, 0xDF, 0x01, 0x05, 0x6F, 0x6C, 0x61, 0x6E, 0x64, 0x00, 0x43, 0x02, 0x06,
+    0x72, 0x74, 0x75, 0x67, 0x61, 0x6C, 0x03, 0x90, 0x00, 0x03, 0x52, 0x4F, 0x43, 0x02, 0x99, 0x00,
+    0x03, 0x52, 0x4F, 0x4B, 0x03, 0x4B, 0x00, 0x09, 0x53, 0x69, 0x6E, 0x67, 0x61, 0x70, 0x6F, 0x72,
+    0x65, 0x01, 0xCF, 0x00, 0x06, 0x54, 0x75, 0x72, 0x6B, 0x65, 0x79, 0x02, 0x29, 0x00, 0x03, 0x55,
+    0x43, 0x54, 0x04, 0xA4, 0x01, 0x08, 0x53, 0x2F, 0x41, 0x6C, 0x61, 0x73, 0x6B, 0x61, 0x00, 0x83,
+    0x05, 0x06, 0x65, 0x75, 0x74, 0x69, 0x61, 0x6E, 0x00, 0x6B, 0x04, 0x06, 0x72, 0x69, 0x7A, 0x6F,
+    0x6E, 0x61, 0x00, 0xEE, 0x03, 0x07, 0x43, 0x65, 0x6E, 0x74, 0x72, 0x61, 0x6C, 0x00, 0xD7, 0x03,
+    0x0C, 0x45, 0x61, 0x73, 0x74, 0x2D, 0x49, 0x6E, 0x64, 0x69, 0x61, 0x6E, 0x61, 0x00, 0xF3, 0x07,
+    0x03, 0x65, 0x72, 0x6E, 0x00, 0xF3, 0x03, 0x06, 0x48, 0x61, 0x77, 0x61, 0x69, 0x69, 0x04, 0xE3,
+    0x03, 0x0E, 0x49, 0x6E, 0x64, 0x69, 0x61, 0x6E, 0x61, 0x2D, 0x53, 0x74, 0x61, 0x72, 0x6B, 0x65,
+    0x00, 0xD7, 0x03, 0x08, 0x4D, 0x69, 0x63, 0x68, 0x69, 0x67, 0x61, 0x6E, 0x00, 0xF3, 0x04, 0x07,
+    0x6F, 0x75, 0x6E, 0x74, 0x61, 0x69, 0x6E, 0x00, 0xC0, 0x03, 0x07, 0x50, 0x61, 0x63, 0x69, 0x66,
+    0x69, 0x63, 0x01, 0x0A, 0x03, 0x05, 0x53, 0x61, 0x6D, 0x6F, 0x61, 0x05, 0x45, 0x00, 0x03, 0x55,
+    0x54, 0x43, 0x04, 0xA4, 0x01, 0x08, 0x6E, 0x69, 0x76, 0x65, 0x72, 0x73, 0x61, 0x6C, 0x04, 0xA4,
+    0x00, 0x04, 0x57, 0x2D, 0x53, 0x55, 0x04, 0xDD, 0x01, 0x02, 0x45, 0x54, 0x03, 0x90, 0x00, 0x04,
+    0x5A, 0x75, 0x6C, 0x75, 0x04, 0xA4,
+};
+
+const uint16_t tzZoneRestarts[38] = {
+    0, 166, 347, 521, 726, 907, 1092, 1276, 1458, 1659, 1835, 2013, 2224, 2407, 2609, 2799, 2954, 3116, 3293, 3457, 3633, 3821, 4019, 4191, 4388, 4514, 4603, 4747, 4935, 5094, 5255, 5408, 5578, 5724, 5895, 6066, 6223, 6397
+};
+
+#endif
@@ -0,0 +1,127 @@
+#include "TzTest.h"
+
+/*      Library: TzCfg
+        Host tests: HttpParserTest.cpp covers HttpParser.cpp ... canned
+        responses fed to the parser, checking the headers it keeps, the
+        chunk framing, and the fields Json decodes from a stream split at
+        every point.
+*/
+
+// Feeds a whole response to 'parser'
+static void feedAll(HttpParser& parser, const std::string& response) {
+    parser.begin(NULL);
+    parser.feed(response.data(), (int)response.size());
+}
+
+TZ_TEST(validatorStored) {
+    HttpParser parser;
+    feedAll(parser, "HTTP/1.1 200 OK\r\nETag: \"5f2a-17c9\"\r\nContent-Length: 0\r\n\r\n");
+    TZ_CHECK(parser.done());
+    TZ_CHECK_EQ(strcmp(parser.validator, "\"5f2a-17c9\""), 0);
+    feedAll(parser, "HTTP/1.1 200 OK\r\nLast-Modified: Mon, 01 Jan 2024 00:00:00 GMT\r\nContent-Length: 0\r\n\r\n");
+    TZ_CHECK_EQ(strcmp(parser.validator, "Mon, 01 Jan 2024 00:00:00 GMT"), 0);
+}
+
+// A header line longer than line[] would leave a truncated ETag, which never matches ... none is kept
+TZ_TEST(validatorTooLong) {
+    HttpParser parser;
+    std::string etag = "\"" + std::string(sizeof(parser.line), 'a') + "\"";
+    feedAll(parser, "HTTP/1.1 200 OK\r\nETag: " + etag + "\r\nContent-Length: 0\r\n\r\n");
+    TZ_CHECK(parser.done());
+    TZ_CHECK_EQ(parser.validator[0], '\0');
+    // the longest ETag that fits is kept whole
+    etag = "\"" + std::string(sizeof(parser.line) - 9, 'a') + "\"";
+    feedAll(parser, "HTTP/1.1 200 OK\r\nETag: " + etag + "\r\nContent-Length: 0\r\n\r\n");
+    TZ_CHECK_EQ(strcmp(parser.validator, etag.c_str()), 0);
+    // a Last-Modified header before an over-long ETag is not kept either
+    etag = "\"" + std::string(sizeof(parser.line), 'a') + "\"";
+    feedAll(parser, "HTTP/1.1 200 OK\r\nLast-Modified: Mon, 01 Jan 2024 00:00:00 GMT\r\nETag: " + etag + "\r\nContent-Length: 0\r\n\r\n");
+    TZ_CHECK_EQ(parser.validator[0], '\0');
+}
+
+// A chunk size of more than httpChunkDigits hex digits would overflow 'remaining' on the device
+TZ_TEST(chunkSizeTooLong) {
+    HttpParser parser;
+    std::string head = "HTTP/1.1 200 OK\r\nTransfer-Encoding: chunked\r\n\r\n";
+    feedAll(parser, head + std::string(httpChunkDigits, 'f') + "\r\n");
+    TZ_CHECK_EQ(parser.state, HP_CHUNK_DATA);
+    TZ_CHECK_EQ(parser.remaining, (1L << (4 * httpChunkDigits)) - 1);
+    feedAll(parser, head + std::string(httpChunkDigits + 1, 'f') + "\r\n");
+    TZ_CHECK(parser.failed());
+    feedAll(parser, head + "100000000\r\n");
+    TZ_CHECK(parser.failed());
+    // extensions after the size are not counted
+    feedAll(parser, head + "5;name=0123456789abcdef\r\nhello\r\n0\r\n\r\n");
+    TZ_CHECK(parser.done());
+}
+
+// A chunk-size line without a size is malformed ... not the last chunk
+TZ_TEST(chunkSizeEmpty) {
+    HttpParser parser;
+    std::string head = "HTTP/1.1 200 OK\r\nTransfer-Encoding: chunked\r\n\r\n";
+    feedAll(parser, head + "5\r\nhello\r\n\r\n\r\n");
+    TZ_CHECK(parser.failed());
+    feedAll(parser, head + "5\r\nhello\r\n;name=value\r\n\r\n");
+    TZ_CHECK(parser.failed());
+    feedAll(parser, head + "5\r\nhello\r\n0\r\n\r\n");
+    TZ_CHECK(parser.done());
+}
+
+// A Content-Length that is negative, empty or not a number is malformed
+TZ_TEST(contentLengthMalformed) {
+    HttpParser parser;
+    for (const char* length : { "-1", "", "+5", "5x", "abc" }) {
+        feedAll(parser, std::string("HTTP/1.1 200 OK\r\nContent-Length: ") + length + "\r\n\r\nhello");
+        TZ_CHECK(parser.failed());
+    }
+    feedAll(parser, "HTTP/1.1 200 OK\r\nContent-Length: 5 \r\n\r\nhello");
+    TZ_CHECK(parser.done());
+}
+
+// Frames 'body' as a chunked response, 'chunk' bytes per chunk
+static std::string chunked(const std::string& body, size_t chunk) {
+    std::string response = "HTTP/1.1 200 OK\r\nContent-Type: application/json\r\nTransfer-Encoding: chunked\r\n\r\n";
+    for (size_t at = 0; at < body.size(); at += chunk) {
+        char size[12];
+        snprintf(size, sizeof(size), "%x\r\n", (unsigned)std::min(chunk, body.size() - at));
+        response += size + body.substr(at, chunk) + "\r\n";
+    }
+    return response + "0\r\n\r\n";
+}
+
+// Every split of the stream (between two feed() calls), with chunk boundaries inside every JSON token,
+// decodes the same fields
+TZ_TEST(splitStream) {
+    std::string body = "{\"status\":\"OK\",\"message\":\"\",\"skip\":{\"a\":[1,\"}\"]},"
+                       "\"abbreviation\":\"C\\u0045T\",\"zoneName\":\"Europe\\/Paris\",\"gmtOffset\":3600,\"dstEnd\":1711846799}";
+    for (size_t chunk : { (size_t)1, (size_t)3, (size_t)7, body.size() }) {
+        std::string response = chunked(body, chunk);
+        for (size_t split = 0; split <= response.size(); split++) {
+            char status[8], message[8], abbr[6], zone[33];
+            float offset = 0;
+            time_t dstEnd = 0;
+            JsonField fields[] = {
+                { "status",       JSON_STRING, status,  sizeof(status) },
+                { "message",      JSON_STRING, message, sizeof(message) },
+                { "abbreviation", JSON_STRING, abbr,    sizeof(abbr) },
+                { "zoneName",     JSON_STRING, zone,    sizeof(zone) },
+                { "gmtOffset",    JSON_FLOAT,  &offset, 0 },
+                { "dstEnd",       JSON_TIME,   &dstEnd, 0 }
+            };
+            Json json;
+            json.begin(fields, 6);
+            HttpParser parser;
+            parser.begin(&json);
+            parser.feed(response.data(), (int)split);
+            parser.feed(response.data() + split, (int)(response.size() - split));
+            TZ_CHECK(parser.done());
+            TZ_CHECK_EQ(json.found(), 6);
+            TZ_CHECK_EQ(strcmp(status, "OK"), 0);
+            TZ_CHECK_EQ(message[0], '\0');
+            TZ_CHECK_EQ(strcmp(abbr, "CET"), 0);
+            TZ_CHECK_EQ(strcmp(zone, "Europe/Paris"), 0);
+            TZ_CHECK_EQ(offset, 3600.0f);
+            TZ_CHECK_EQ(dstEnd, (time_t)1711846799);
+        }
+    }
+}
@@ -0,0 +1,168 @@
+#include "TzTest.h"
+
+/*      Library: TzCfg
+        Host tests: HttpTest.cpp covers Http.cpp ... the non-blocking
+        transaction against HostNet's canned responses: latency, fragments,
+        keep-alive reuse, the inactivity timeout and a refused connect.
+*/
+
+static char host[] = "api.timezonedb.com";
+static char path[] = "/v2/get-time-zone?key=TESTKEY&format=json&by=zone&zone=America/Chicago";
+static const char okBody[] = "{\"status\":\"OK\",\"message\":\"\",\"zoneName\":\"America/Chicago\"}";
+
+// Frames a 200 response with Content-Length
+static std::string ok(const std::string& headers = "") {
+    return "HTTP/1.1 200 OK\r\nContent-Type: application/json\r\nContent-Length: " + std::to_string(strlen(okBody)) + "\r\n" + headers + "\r\n" + okBody;
+}
+
+// A transaction driven the way TzCfg::poll() drives it, one step per loop() pass
+struct HttpRun {
+    char status[16];
+    char zone[33];
+    JsonField fields[2] = {
+        { "status",   JSON_STRING, status, sizeof(status) },
+        { "zoneName", JSON_STRING, zone,   sizeof(zone) }
+    };
+    char statusMsg[65];
+    uint8_t state = HTTP_IDLE;
+    int polls = 0;
+    unsigned long longestPoll = 0;         // <-- Most mock-clock milliseconds one poll() call took
+    unsigned long elapsed = 0;
+
+    uint8_t run(Http& http, char* hostName = host) {
+        status[0] = zone[0] = statusMsg[0] = '\0';
+        unsigned long start = millis();
+        http.begin(hostName, 80, path, fields, 2);
+        do {
+            unsigned long call = millis();
+            state = http.poll(statusMsg, sizeof(statusMsg));
+            longestPoll = std::max(longestPoll, millis() - call);
+            polls++;
+            if ((state != HTTP_COMPLETE) && (state != HTTP_FAILED)) delay(1);
+        } while ((state != HTTP_COMPLETE) && (state != HTTP_FAILED));
+        elapsed = millis() - start;
+        return state;
+    }
+};
+
+// Waiting for the server's first byte never blocks a poll() call
+TZ_TEST(httpLatency) {
+    HostNet::latencyMillis = 300;
+    HostNet::script.push_back(ok());
+    Http http;
+    HttpRun t;
+    TZ_CHECK_EQ(t.run(http), HTTP_COMPLETE);
+    TZ_CHECK_EQ(http.statusCode, 200);
+    TZ_CHECK_EQ(strcmp(t.zone, "America/Chicago"), 0);
+    TZ_CHECK(t.elapsed >= 300);
+    TZ_CHECK_EQ(t.longestPoll, 0ul);
+    TZ_CHECK(t.polls > 300);
+}
+
+// A response that arrives a few bytes at a time is parsed as it arrives, httpReadChunk bytes per call at most
+TZ_TEST(httpFragments) {
+    for (size_t fragment : { (size_t)1, (size_t)7, (size_t)httpReadChunk + 1 }) {
+        HostNet::reset();
+        HostNet::fragment = fragment;
+        HostNet::fragmentMillis = 2;
+        HostNet::script.push_back(ok());
+        Http http;
+        HttpRun t;
+        TZ_CHECK_EQ(t.run(http), HTTP_COMPLETE);
+        TZ_CHECK_EQ(strcmp(t.status, "OK"), 0);
+        TZ_CHECK_EQ(strcmp(t.zone, "America/Chicago"), 0);
+        TZ_CHECK(t.polls >= (int)((ok().size() + fragment - 1) / fragment));
+        TZ_CHECK_EQ(t.longestPoll, 0ul);
+    }
+    // the whole response at once still takes a call per httpReadChunk bytes
+    HostNet::reset();
+    std::string padded = ok(std::string("X-Padding: ") + std::string(2 * httpReadChunk, 'p') + "\r\n");
+    HostNet::script.push_back(padded);
+    Http http;
+    HttpRun t;
+    TZ_CHECK_EQ(t.run(http), HTTP_COMPLETE);
+    TZ_CHECK(t.polls >= 2 + (int)(padded.size() / httpReadChunk));
+}
+
+// Back-to-back transactions to one server share a connection; the server closing it, another host, or
+// httpKeepAlive expiring opens a new one
+TZ_TEST(httpKeepAliveReuse) {
+    for (int i = 0; i < 6; i++) HostNet::script.push_back(ok());
+    Http http;
+    HttpRun t;
+    TZ_CHECK_EQ(t.run(http), HTTP_COMPLETE);
+    TZ_CHECK( !http.reused);
+    TZ_CHECK_EQ(t.run(http), HTTP_COMPLETE);
+    TZ_CHECK(http.reused);
+    TZ_CHECK_EQ(HostNet::connects, 1);
+    TZ_CHECK_EQ(HostNet::requests, 2);
+    char other[] = "ip-api.com";
+    TZ_CHECK_EQ(t.run(http, other), HTTP_COMPLETE);
+    TZ_CHECK( !http.reused);
+    TZ_CHECK_EQ(HostNet::connects, 2);
+    delay(httpKeepAlive);
+    TZ_CHECK_EQ(t.run(http, other), HTTP_COMPLETE);
+    TZ_CHECK( !http.reused);
+    TZ_CHECK_EQ(HostNet::connects, 3);
+    HostNet::closeAfterResponse = true;
+    TZ_CHECK_EQ(t.run(http, other), HTTP_COMPLETE);    // <-- reuses the connection, which the server then closes
+    TZ_CHECK(http.reused);
+    TZ_CHECK( !http.open);
+    TZ_CHECK_EQ(t.run(http, other), HTTP_COMPLETE);
+    TZ_CHECK( !http.reused);
+    TZ_CHECK_EQ(HostNet::connects, 4);
+    // "Connection: close" from the server is honored
+    HostNet::closeAfterResponse = false;
+    HostNet::script.push_back(ok("Connection: close\r\n"));
+    TZ_CHECK_EQ(t.run(http, other), HTTP_COMPLETE);
+    TZ_CHECK( !http.open);
+}
+
+// A server that accepts the request but never answers fails after httpTimeout of silence
+TZ_TEST(httpInactivityTimeout) {
+    HostNet::latencyMillis = 60000;
+    HostNet::script.push_back(ok());
+    Http http;
+    HttpRun t;
+    TZ_CHECK_EQ(t.run(http), HTTP_FAILED);
+    TZ_CHECK_EQ(http.errorCode, TZ_E_TIMEOUT);
+    TZ_CHECK_EQ(strncmp(t.statusMsg, "(E668)", 6), 0);
+    TZ_CHECK(t.elapsed > httpTimeout);
+    TZ_CHECK(t.elapsed <= httpTimeout + 2);
+    TZ_CHECK( !http.open);
+    // silence in the middle of a response counts too
+    HostNet::reset();
+    HostNet::fragment = 20;
+    HostNet::fragmentMillis = 60000;
+    HostNet::script.push_back(ok());
+    TZ_CHECK_EQ(t.run(http), HTTP_FAILED);
+    TZ_CHECK_EQ(http.errorCode, TZ_E_TIMEOUT);
+}
+
+TZ_TEST(httpConnectRefused) {
+    HostNet::refuse = true;
+    Http http;
+    HttpRun t;
+    TZ_CHECK_EQ(t.run(http), HTTP_FAILED);
+    TZ_CHECK_EQ(http.errorCode, TZ_E_CONNECT);
+    TZ_CHECK_EQ(strcmp(t.statusMsg, "(E621) Unable to connect to api.timezonedb.com"), 0);
+    TZ_CHECK_EQ(t.polls, 1);
+    TZ_CHECK_EQ(HostNet::requests, 0);
+    // the next transaction connects again
+    HostNet::refuse = false;
+    HostNet::script.push_back(ok());
+    TZ_CHECK_EQ(t.run(http), HTTP_COMPLETE);
+    TZ_CHECK_EQ(HostNet::connects, 2);
+}
+
+// The server closing the connection part way through a framed body fails the transaction
+TZ_TEST(httpTruncated) {
+    std::string response = ok();
+    HostNet::closeAfterResponse = true;
+    HostNet::script.push_back(response.substr(0, response.size() - 10));
+    Http http;
+    HttpRun t;
+    TZ_CHECK_EQ(t.run(http), HTTP_FAILED);
+    TZ_CHECK_EQ(http.errorCode, TZ_E_MALFORMED);
+    TZ_CHECK_EQ(strncmp(t.statusMsg, "(E653)", 6), 0);
+}
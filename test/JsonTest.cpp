@@ -0,0 +1,37 @@
+#include "TzTest.h"
+
+/*      Library: TzCfg
+        Host tests: JsonTest.cpp covers Json.cpp ... how names are matched
+        against the field table.
+*/
+
+// A field without a name (a provider field the server does not provide) never matches an empty JSON name
+TZ_TEST(jsonEmptyName) {
+    char zone[33] = "", other[8] = "";
+    JsonField fields[] = {
+        { "",         JSON_STRING, other, sizeof(other) },
+        { "zoneName", JSON_STRING, zone,  sizeof(zone) }
+    };
+    Json json;
+    const char text[] = "{\"\":\"oops\",\"zoneName\":\"Europe/Paris\"}";
+    TZ_CHECK_EQ(json.parse(text, sizeof(text) - 1, fields, 2), 1);
+    TZ_CHECK( !fields[0].found);
+    TZ_CHECK_EQ(other[0], '\0');
+    TZ_CHECK_EQ(strcmp(zone, "Europe/Paris"), 0);
+}
+
+// A decoded NUL in a name ends the match at the decoded length ... it neither matches a name's terminator
+// nor lets the compare run past it
+TZ_TEST(jsonNulInName) {
+    char status[8] = "";
+    JsonField fields[] = {
+        { "status", JSON_STRING, status, sizeof(status) }
+    };
+    Json json;
+    const char text[] = "{\"status\\u0000\\u0000\\u0000\\u0000\":\"bad\",\"stat\\u0000us\":\"bad\"}";
+    TZ_CHECK_EQ(json.parse(text, sizeof(text) - 1, fields, 1), 0);
+    TZ_CHECK_EQ(status[0], '\0');
+    const char good[] = "{\"stat\\u0075s\":\"OK\"}";
+    TZ_CHECK_EQ(json.parse(good, sizeof(good) - 1, fields, 1), 1);
+    TZ_CHECK_EQ(strcmp(status, "OK"), 0);
+}
@@ -0,0 +1,236 @@
+#include "TzStandIn.h"
+
+/*      Library: TzCfg
+        Host benchmarks: TzCfgBench.cpp measures the library's main paths.
+        Host times (ns, us) are wall-clock on the build machine; "blocked"
+        times are mock-clock milliseconds, i.e. the time the call would
+        hold up loop() on a device (server latency included).
+
+            begin ............... blank & populated 2047- and 4096-byte
+                                  EEPROMs (the record at the end): the
+                                  TzBlock scan of earlier versions, against
+                                  begin() (one scan) and begin(sb) (the
+                                  TzDirectory)
+            jsonParse ........... a timezonedb response body
+            httpGetJson ......... one transaction, 50 ms latency, 64-byte fragments
+            setLocalTime ........ setTimezoneByID(): the blocking call, and the
+                                  schedule fetched after it by maintainLocalTime()
+            maintainLocalTime ... an idle tick (nothing due)
+            convertBatch ........ logs of 256, 16K & 1M timestamps across the
+                                  schedule: in time order, in place, shuffled
+            fleetRefresh ........ 10,000 devices restarting together: peak
+                                  refresh requests per second & minute
+*/
+
+static char chicago[] = "America/Chicago";
+static char testKey[] = "TESTKEY";
+
+// Runs f 'n' times, returning the mean wall-clock nanoseconds per run
+template <typename F> static double timeEach(int n, F f) {
+    double start = TzTest::nanos();
+    for (int i = 0; i < n; i++) f();
+    return (TzTest::nanos() - start) / n;
+}
+
+// Returns the fastest of 'tries' calls of timeEach(n, f) ... for loops short enough that the host's noise dominates
+template <typename F> static double bestEach(int tries, int n, F f) {
+    double best = std::numeric_limits<double>::max();
+    for (int t = 0; t < tries; t++) best = std::min(best, timeEach(n, f));
+    return best;
+}
+
+// Stores America/Chicago's settings (as setTimezoneByID() would), in TzCfg's region at sb (-1 = none),
+// or without a region at 'ring' (-1 = the default location)
+static void storeChicago(int sb = -1, int ring = -1) {
+    TzStandIn::install();
+    TzCfg tz;
+    tz.begin(sb);
+    if (ring >= 0) tz.setEepromStartByte(ring);
+    tz.setApiKey_timezonedb(testKey);
+    tz.setTimezoneByID(chicago);
+    TzStandIn::settle(tz);      // <-- the schedule is fetched after the call returns
+}
+
+TZ_BENCH(beginBench) {
+    const int n = 500;
+    TzCfg tz;
+    for (size_t size : { (size_t)hostEepromSize, (size_t)4096 }) {
+        int late = size - tzEepromSize;     // <-- the record at the end of EEPROM ... the longest scan
+        for (bool stored : { false, true }) {
+            // baseline: begin() of the earlier versions scanned all of EEPROM for a TzBlock
+            EEPROM.resize(size);
+            if (stored) EEPROM.put(late, TzBlock());
+            uint32_t reads = EEPROM.reads;
+            int found = -2;
+            double baseline = bestEach(5, n, [&]() { found = tz.searchForTzEeprom(); });
+            TZ_CHECK_EQ(found, stored ? late : -1);
+            uint32_t baselineReads = (EEPROM.reads - reads) / (5 * n);
+            // begin(): one scan, for the TzJournal (ring at 'late') & a legacy TzBlock
+            EEPROM.resize(size);
+            if (stored) storeChicago(-1, late);
+            reads = EEPROM.reads;
+            double scan = bestEach(5, n, [&]() { tz.begin(); });
+            TZ_CHECK_EQ(tz.tzEepromExists, stored);
+            uint32_t scanReads = (EEPROM.reads - reads) / (5 * n);
+            // begin(sb): TzCfg's region at 'late' ... a blank EEPROM has no TzDirectory, so it is scanned once
+            EEPROM.resize(size);
+            if (stored) storeChicago(late);
+            reads = EEPROM.reads;
+            double directory = bestEach(5, n, [&]() { tz.begin(late); });
+            TZ_CHECK_EQ(tz.tzEepromExists, stored);
+            uint32_t directoryReads = (EEPROM.reads - reads) / (5 * n);
+            TzTest::report("%u-byte EEPROM, %s: baseline %.0f ns (%u bytes read), begin() %.0f ns (%u), begin(%d) %.0f ns (%u)",
+                (unsigned)size, stored ? "populated" : "blank", baseline, (unsigned)baselineReads,
+                scan, (unsigned)scanReads, late, directory, (unsigned)directoryReads);
+        }
+    }
+    EEPROM.resize(hostEepromSize);
+}
+
+TZ_BENCH(jsonParseBench) {
+    std::string response = TzStandIn::serve(std::string("GET /v2/get-time-zone?key=TESTKEY&format=json&by=zone&zone=") + chicago + " HTTP/1.1\r\n\r\n");
+    std::string body = response.substr(response.find("\r\n\r\n") + 4);
+    char status[16], abbr[6];
+    float offset;
+    time_t dstEnd;
+    JsonField fields[] = {
+        { "status",       JSON_STRING, status,  sizeof(status) },
+        { "abbreviation", JSON_STRING, abbr,    sizeof(abbr) },
+        { "gmtOffset",    JSON_FLOAT,  &offset, 0 },
+        { "dstEnd",       JSON_TIME,   &dstEnd, 0 }
+    };
+    Json json;
+    int found = 0;
+    double ns = timeEach(20000, [&]() { found = json.parse(body.c_str(), body.size(), fields, 4); });
+    TZ_CHECK_EQ(found, 4);
+    TzTest::report("Json::parse(), %u-byte body: %.0f ns (%.1f ns/byte)", (unsigned)body.size(), ns, ns / body.size());
+}
+
+TZ_BENCH(httpGetJsonBench) {
+    TzStandIn::install();
+    HostNet::latencyMillis = 50;
+    HostNet::fragment = 64;
+    HostNet::fragmentMillis = 2;
+    char status[16], message[65];
+    JsonField fields[] = {
+        { "status",  JSON_STRING, status,  sizeof(status) },
+        { "message", JSON_STRING, message, sizeof(message) }
+    };
+    char host[] = "api.timezonedb.com";
+    char path[] = "/v2/get-time-zone?key=TESTKEY&format=json&by=zone&zone=America/Chicago";
+    char errorMsg[65];
+    Http http;
+    int code = 0;
+    unsigned long start = millis();
+    double ns = timeEach(1000, [&]() { code = http.getJson(host, 80, path, fields, 2, errorMsg, sizeof(errorMsg)); });
+    TZ_CHECK_EQ(code, 200);
+    TzTest::report("Http::getJson(): %.1f us host, %lu ms blocked, %d connects per 1000", ns / 1000, (millis() - start) / 1000, HostNet::connects);
+}
+
+TZ_BENCH(setLocalTimeBench) {
+    TzStandIn::install();
+    HostNet::latencyMillis = 50;
+    TzCfg tz;
+    tz.begin();
+    tz.setApiKey_timezonedb(testKey);
+    unsigned long start = millis();
+    double ns = timeEach(1, [&]() { tz.setTimezoneByID(chicago); });
+    TZ_CHECK_EQ(tz.getRefreshStatus(), TZ_PENDING);
+    TzTest::report("setTimezoneByID(), new zone: %.0f us host, %lu ms blocked, %d queries, %u EEPROM bytes written",
+        ns / 1000, millis() - start, TzStandIn::queries, (unsigned)tz.getEepromBytesWritten());
+    start = millis();
+    int queries = TzStandIn::queries, ticks = 0;
+    unsigned long longest = 0;
+    while (tz.getRefreshStatus() == TZ_PENDING) {
+        unsigned long tick = millis();
+        tz.maintainLocalTime();
+        longest = std::max(longest, millis() - tick);
+        ticks++;
+        delay(1);
+    }
+    TZ_CHECK_EQ(tz.getRefreshStatus(), EXIT_SUCCESS);
+    TZ_CHECK_EQ(tz.schedule.count, tzScheduleSize);
+    TzTest::report("the schedule, in the background: %lu ms, %d queries over %d ticks (longest tick %lu ms), %u EEPROM bytes written",
+        millis() - start, TzStandIn::queries - queries, ticks, longest, (unsigned)tz.getEepromBytesWritten());
+}
+
+TZ_BENCH(maintainLocalTimeBench) {
+    storeChicago();
+    TzCfg tz;
+    tz.begin();
+    tz.setApiKey_timezonedb(testKey);
+    tz.maintainLocalTime();     // <-- applies the stored settings & schedules the first refresh
+    uint32_t reads = EEPROM.reads, writes = EEPROM.writes;
+    double ns = timeEach(1000000, [&]() { tz.maintainLocalTime(); });
+    TZ_CHECK_EQ(EEPROM.writes, writes);
+    TzTest::report("maintainLocalTime(), idle tick: %.1f ns, %u EEPROM reads", ns, (unsigned)(EEPROM.reads - reads));
+}
+
+TZ_BENCH(convertBatchBench) {
+    storeChicago();
+    TzCfg tz;
+    tz.begin();
+    TZ_CHECK_EQ(tz.schedule.count, tzScheduleSize);
+    time_t span = tz.schedule.tran[tz.schedule.count - 1].time - tzTestEpoch;
+    // logs that fit the cache (a reading every ~4 days, every ~100 minutes) and one that does not (every ~100 s)
+    for (size_t n : { (size_t)256, (size_t)16384, (size_t)1000000 }) {
+        std::vector<time_t> in(n), out(n);
+        for (size_t i = 0; i < n; i++) in[i] = tzTestEpoch + (time_t)((span * (double)i) / n);
+        int runs = (int)(20000000 / n) + 1;
+        double ns = bestEach(5, runs, [&]() { tz.convertBatch(in.data(), out.data(), n); tzKeep(out); });
+        TzTest::report("convertBatch(), %u timestamps in time order over %ld days: %.2f ns/timestamp", (unsigned)n, (long)(span / 86400), ns / n);
+        std::vector<time_t> local = in;
+        ns = bestEach(5, runs, [&]() { local = in; tz.convertBatch(local.data(), local.data(), n); tzKeep(local); });
+        TZ_CHECK(local == out);
+        TzTest::report("    in place (including the copy): %.2f ns/timestamp", ns / n);
+        std::vector<time_t> shuffled = in;
+        for (size_t i = 0; i < n; i++) std::swap(shuffled[i], shuffled[(i * 2654435761u) % n]);
+        ns = bestEach(5, (runs / 10) + 1, [&]() { tz.convertBatch(shuffled.data(), local.data(), n); tzKeep(local); });
+        TzTest::report("    shuffled: %.2f ns/timestamp", ns / n);
+    }
+}
+
+// Returns the most refreshes that fall in any one 'window' seconds
+static int peakRefreshes(std::vector<time_t> times, time_t window) {
+    std::sort(times.begin(), times.end());
+    int peak = 0;
+    for (size_t i = 0, j = 0; i < times.size(); i++) {
+        while (times[i] - times[j] >= window) j++;
+        peak = std::max(peak, (int)(i - j + 1));
+    }
+    return peak;
+}
+
+// 10,000 devices (each with its own device ID) restart together with America/Chicago stored: the first tick
+// applies the stored settings, and the refreshes that follow are spread across the fleet
+TZ_BENCH(fleetRefreshBench) {
+    const int devices = 10000;
+    storeChicago();
+    int requests = HostNet::requests;
+    time_t start = Time.now();
+    std::vector<time_t> first, second;
+    int applied = 0;
+    for (int d = 0; d < devices; d++) {
+        char id[25];
+        snprintf(id, sizeof(id), "e00fce68%016x", d * 2654435761u);
+        System.id = id;
+        HostClock::set(start);
+        Time = TimeClass();
+        TzCfg tz;
+        tz.begin();
+        tz.setApiKey_timezonedb(testKey);
+        tz.maintainLocalTime();
+        if (Time.zone() == -6) applied++;
+        first.push_back(tz.getNextRefreshTime());
+        HostClock::set(tz.getNextRefreshTime());    // <-- the first refresh succeeds, and plans the next
+        tz.setEepromRefreshTime();
+        second.push_back(tz.getNextRefreshTime());
+    }
+    TZ_CHECK_EQ(applied, devices);
+    TZ_CHECK_EQ(HostNet::requests, requests);   // <-- no device queried the server at the restart
+    TZ_CHECK(peakRefreshes(first, 1) <= 8);
+    TzTest::report("%d devices, settings applied on the first tick: %d", devices, applied);
+    TzTest::report("first refresh after the restart: peak %d requests/s, %d requests/min (spread over %ld s)",
+        peakRefreshes(first, 1), peakRefreshes(first, 60), (long)(*std::max_element(first.begin(), first.end()) - start));
+    TzTest::report("the refresh after it: peak %d requests/s, %d requests/min", peakRefreshes(second, 1), peakRefreshes(second, 60));
+}
@@ -0,0 +1,171 @@
+#include "TzStandIn.h"
+
+/*      Library: TzCfg
+        Host tests: TzCfgTest.cpp covers TzCfg.cpp ... lookups against the
+        TzStandIn server, the settings restored from EEPROM after a reset, and
+        the zones set by rule.
+*/
+
+static char chicago[] = "America/Chicago";
+static char testKey[] = "TESTKEY";
+
+TZ_TEST(beginBlankEeprom) {
+    TzCfg tz;
+    tz.begin();
+    TZ_CHECK( !tz.tzEepromExists);
+    TZ_CHECK_EQ(strcmp(tz.getTimezone(), "UTC"), 0);
+    TZ_CHECK_EQ(HostNet::connects, 0);
+    TZ_CHECK_EQ(EEPROM.writes, 0u);
+}
+
+TZ_TEST(setTimezoneByIdChicago) {
+    TzStandIn::install();
+    TzCfg tz;
+    tz.begin();
+    tz.setApiKey_timezonedb(testKey);
+    TZ_CHECK_EQ(tz.setTimezoneByID(chicago), EXIT_SUCCESS);
+    TZ_CHECK_EQ(tz.getLastError(), TZ_OK);
+    TZ_CHECK_EQ(tz.getNextTransitionTime(), (time_t)1710057600);    // <-- 2024-03-10 08:00 UTC
+    TZ_CHECK_EQ(strcmp(tz.getTimezoneAbbr(), "CST"), 0);
+    TzStandIn::settle(tz);
+    TZ_CHECK_EQ(tz.getRefreshStatus(), EXIT_SUCCESS);
+    TZ_CHECK_EQ(tz.schedule.count, tzScheduleSize);
+    TzStandIn::checkZone(tz, chicago);
+}
+
+// The call returns after two queries (the current settings & the next transition) ... the rest of
+// the schedule is fetched in the background, and a reset before it completes keeps the settings
+TZ_TEST(setTimezoneByIdReturnsEarly) {
+    TzStandIn::install();
+    {
+        TzCfg tz;
+        tz.begin();
+        tz.setApiKey_timezonedb(testKey);
+        unsigned long start = millis();
+        TZ_CHECK_EQ(tz.setTimezoneByID(chicago), EXIT_SUCCESS);
+        TZ_CHECK(millis() - start <= tzdbQueryGap + 100);
+        TZ_CHECK_EQ(TzStandIn::queries, 2);
+        TZ_CHECK_EQ(tz.getRefreshStatus(), TZ_PENDING);
+        TZ_CHECK_EQ(tz.schedule.count, 0);
+        TzStandIn::checkZone(tz, chicago);
+    }
+    TzCfg tz;
+    tz.begin();
+    TZ_CHECK(tz.tzEepromExists);
+    TzStandIn::checkZone(tz, chicago);
+    tz.setApiKey_timezonedb(testKey);
+    TZ_CHECK_EQ(tz.setTimezoneByID(chicago), EXIT_SUCCESS);
+    TzStandIn::settle(tz);
+    TZ_CHECK_EQ(TzStandIn::queries, 4 + tzScheduleSize);
+    TZ_CHECK_EQ(tz.schedule.count, tzScheduleSize);
+    TzStandIn::checkZone(tz, chicago);
+}
+
+TZ_TEST(restoredAfterReset) {
+    TzStandIn::install();
+    {
+        TzCfg tz;
+        tz.begin();
+        tz.setApiKey_timezonedb(testKey);
+        TZ_CHECK_EQ(tz.setTimezoneByID(chicago), EXIT_SUCCESS);
+    }
+    int requests = HostNet::requests;
+    TzCfg tz;
+    tz.begin();
+    TZ_CHECK(tz.tzEepromExists);
+    TZ_CHECK_EQ(strcmp(tz.getTimezone(), chicago), 0);
+    TZ_CHECK_EQ(tz.getNextTransitionTime(), (time_t)1710057600);
+    TZ_CHECK_EQ(HostNet::requests, requests);
+}
+
+TZ_TEST(setTimezoneByRuleParis) {
+    TzCfg tz;
+    tz.begin();
+    char id[] = "Europe/Paris";
+    char rule[] = "CET-1CEST,M3.5.0,M10.5.0/3";
+    TZ_CHECK_EQ(tz.setTimezoneByRule(id, rule), EXIT_SUCCESS);
+    TZ_CHECK_EQ(HostNet::connects, 0);
+    TzStandIn::checkZone(tz, id);
+}
+
+TZ_TEST(invalidApiKey) {
+    TzStandIn::install();
+    TzCfg tz;
+    tz.begin();
+    char key[] = "WRONGKEY";
+    tz.setApiKey_timezonedb(key);
+    TZ_CHECK_EQ(tz.setTimezoneByID(chicago), EXIT_FAILURE);
+    TZ_CHECK_EQ(tz.getLastError(), TZ_E_TZDB_FAIL);
+    TZ_CHECK_EQ(strcmp(tz.getHttpStatus(), "(timezonedb) Invalid API key."), 0);
+    TZ_CHECK_EQ(strcmp(tz.getTimezone(), "UTC"), 0);
+}
+
+// After a reset, the first tick applies the stored settings ... the refresh (a network query) is spread
+TZ_TEST(firstTickAppliesStoredSettings) {
+    TzStandIn::install();
+    {
+        TzCfg tz;
+        tz.begin();
+        tz.setApiKey_timezonedb(testKey);
+        TZ_CHECK_EQ(tz.setTimezoneByID(chicago), EXIT_SUCCESS);
+    }
+    Time = TimeClass();
+    int requests = HostNet::requests;
+    TzCfg tz;
+    tz.begin();
+    tz.setApiKey_timezonedb(testKey);
+    tz.maintainLocalTime();
+    TZ_CHECK_EQ(HostNet::requests, requests);
+    TZ_CHECK(tz.getNextRefreshTime() > Time.now());
+    TZ_CHECK(tz.getNextRefreshTime() < Time.now() + tzBlockRetryInterval);
+    TzStandIn::checkZone(tz, chicago);
+}
+
+// A device that sleeps until nextDeadline() and calls resume() on waking, for five years: it wakes at every
+// transition (none is missed or applied late), and its settings are right at every wake
+TZ_TEST(sleepUntilDeadline) {
+    TzStandIn::install();
+    const TzStandInZone* zone = TzStandIn::find(chicago);
+    TzCfg tz;
+    tz.begin();
+    tz.setApiKey_timezonedb(testKey);
+    TZ_CHECK_EQ(tz.setTimezoneByID(chicago), EXIT_SUCCESS);
+    TzStandIn::settle(tz);
+    time_t end = Time.now() + (5L * 365 * 86400);
+    time_t transition = TzStandIn::nextTransition(zone, Time.now());
+    int wakes = 0, transitions = 0;
+    while (Time.now() < end) {
+        time_t deadline = tz.nextDeadline();
+        TZ_CHECK(deadline > Time.now());
+        TZ_CHECK( !(deadline > transition));     // <-- never sleeps through a transition
+        HostClock::set(deadline);
+        wakes++;
+        tz.resume();
+        TzStandIn::settle(tz);
+        if (deadline == transition) {
+            transitions++;
+            transition = TzStandIn::nextTransition(zone, Time.now());
+        }
+        TzStandIn::checkZone(tz, chicago);
+    }
+    TZ_CHECK_EQ(transitions, 10);
+    TZ_CHECK(wakes < 150);      // <-- the transitions & a refresh every ~3 weeks
+}
+
+// A device that sleeps far past its deadline catches up on every missed transition in one EEPROM write
+TZ_TEST(sleepPastTransitions) {
+    TzStandIn::install();
+    TzCfg tz;
+    tz.begin();
+    tz.setApiKey_timezonedb(testKey);
+    TZ_CHECK_EQ(tz.setTimezoneByID(chicago), EXIT_SUCCESS);
+    TzStandIn::settle(tz);
+    tz.setApiKey_timezonedb((char*)"");     // <-- no refresh on waking ... the stored schedule alone
+    time_t next = tz.schedule.tran[3].time;
+    HostClock::set(tz.schedule.tran[2].time + 3600);      // <-- four transitions later
+    uint32_t records = tz.metrics.eepromWrites;
+    tz.resume();
+    TZ_CHECK_EQ(tz.metrics.eepromWrites - records, 1u);
+    TZ_CHECK_EQ(tz.getNextTransitionTime(), next);
+    TzStandIn::checkZone(tz, chicago);
+}
@@ -0,0 +1,88 @@
+#include "TzTest.h"
+#include "TzGeo.h"
+#include <math.h>
+
+/*      Library: TzCfg
+        Host benchmarks: TzGeoBench.cpp measures findGeoZone() on the index
+        test/Makefile generates (tools/TzGeoGen.py) from the synthetic
+        boundaries of TzGeoFixture.py: lookups per second inside the
+        fixture and across the globe, the share resolved by the grid cell
+        alone, agreement with the exact boundaries, and the flash the index
+        takes.
+*/
+
+// Longitude of the border to the west of column k in TzGeoFixture.py (the outer borders are straight)
+static double fixtureBorder(int k, double lat) {
+    double wave = ((k == 0) || (k == 5)) ? 0 : 1.5 * sin((0.7 * lat) + k);
+    return -60 + (8 * k) + wave;
+}
+
+// Copies the zone TzGeoFixture.py puts 'lat', 'lng' in to 'id'
+//      Returns false outside the fixture
+static bool fixtureZone(double lat, double lng, char* id, size_t idSize) {
+    if ((lat < 0) || !(lat < 40) || (lng < fixtureBorder(0, lat)) || !(lng < fixtureBorder(5, lat))) return false;
+    if ((((lat - 15) * (lat - 15)) + ((lng + 48) * (lng + 48))) < 4) {
+        snprintf(id, idSize, "Fixture/Enclave");
+        return true;
+    }
+    int col = 0;
+    while ((col < 4) && !(lng < fixtureBorder(col + 1, lat))) col++;
+    snprintf(id, idSize, "Fixture/Zone%d%d", (int)(lat / 10), col);
+    return true;
+}
+
+// 'n' points spread over lat0..lat1, lng0..lng1 (the same ones each run)
+static std::vector<std::pair<float, float>> points(size_t n, float lat0, float lat1, float lng0, float lng1) {
+    std::vector<std::pair<float, float>> p(n);
+    uint32_t seed = 12345;
+    auto next = [&]() { seed = (seed * 1664525u) + 1013904223u; return (seed >> 8) / 16777216.0f; };
+    for (auto& pt : p) {
+        pt.first = lat0 + ((lat1 - lat0) * next());
+        pt.second = lng0 + ((lng1 - lng0) * next());
+    }
+    return p;
+}
+
+// Returns the fastest of 5 passes over 'p', in lookups per second; 'found' counts the covered points
+static double lookupRate(TzCfg& tz, const std::vector<std::pair<float, float>>& p, size_t& found) {
+    double best = std::numeric_limits<double>::max();
+    char id[33];
+    for (int t = 0; t < 5; t++) {
+        found = 0;
+        double start = TzTest::nanos();
+        for (auto& pt : p) found += (tz.findGeoZone(pt.first, pt.second, id, sizeof(id)) == EXIT_SUCCESS);
+        best = std::min(best, TzTest::nanos() - start);
+        tzKeep(id);
+    }
+    return p.size() / (best / 1e9);
+}
+
+TZ_BENCH(geoLookupBench) {
+    TzCfg tz;
+    size_t flash = sizeof(tzGeoZones) + sizeof(tzGeoZoneIDs) + sizeof(tzGeoCells) + sizeof(tzGeoCellPolys) +
+                   sizeof(tzGeoPolys) + sizeof(tzGeoRings) + sizeof(tzGeoVertices);
+    TzTest::report("index: %u zones, %u vertices, %.0f-degree cells: %u bytes flash (%u in the grid), no RAM",
+        (unsigned)(sizeof(tzGeoZoneIDs) / sizeof(tzGeoZoneIDs[0])), (unsigned)(sizeof(tzGeoVertices) / 4), TZ_GEO_CELL,
+        (unsigned)flash, (unsigned)sizeof(tzGeoCells));
+    // inside the fixture, only points within the tolerance of a border may miss (a sliver between two
+    // simplified borders) or resolve to the neighboring zone
+    std::vector<std::pair<float, float>> inside = points(100000, 0, 40, -60, -20);
+    int agree = 0, pure = 0;
+    for (auto& pt : inside) {
+        char id[33], exact[33];
+        bool covered = fixtureZone(pt.first, pt.second, exact, sizeof(exact));
+        agree += (tz.findGeoZone(pt.first, pt.second, id, sizeof(id)) == EXIT_SUCCESS) && covered && (strcmp(id, exact) == 0);
+        uint16_t cell = tzGeoCells[((int)((pt.first + 90) / TZ_GEO_CELL) * TZ_GEO_COLS) + (int)((pt.second + 180) / TZ_GEO_CELL)];
+        pure += ((cell & 0x8000) && (cell != 0xFFFF));
+    }
+    TZ_CHECK(agree > (int)(inside.size() * 0.995));
+    size_t found;
+    double rate = lookupRate(tz, inside, found);
+    TZ_CHECK( !(found < (size_t)agree));
+    TzTest::report("inside the fixture: %.2f M lookups/s (%.0f ns), %.1f%% resolved by the cell alone, %.2f%% covered, %.2f%% agree with the exact boundaries",
+        rate / 1e6, 1e9 / rate, (100.0 * pure) / inside.size(), (100.0 * found) / inside.size(), (100.0 * agree) / inside.size());
+    // across the globe, nearly every point falls in an empty cell
+    std::vector<std::pair<float, float>> globe = points(100000, -90, 90, -180, 180);
+    rate = lookupRate(tz, globe, found);
+    TzTest::report("across the globe: %.2f M lookups/s (%.0f ns), %.1f%% covered", rate / 1e6, 1e9 / rate, (100.0 * found) / globe.size());
+}
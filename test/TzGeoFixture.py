@@ -0,0 +1,74 @@
+#!/usr/bin/env python3
+"""
+    Library: TzCfg
+    Host tests: TzGeoFixture.py writes a synthetic GeoJSON FeatureCollection
+    of time zone boundaries, from which test/Makefile generates the
+    geographic index (tools/TzGeoGen.py) that TzGeoBench.cpp measures.
+
+    The fixture covers lat 0 to 40, lng -60 to -20 (open ocean, so the
+    positions used by the other tests fall outside it). It is divided into
+    4 bands of latitude and 5 columns, whose borders wave in longitude
+    (1.5 degree sine waves, a vertex every 0.05 degrees), giving 20 zones
+    "Fixture/Zone<row><column>". Zone 11 has a hole: a circular enclave,
+    "Fixture/Enclave" (radius 2 degrees, centered on 15, -48).
+
+    fixtureZone() in TzGeoBench.cpp computes the same geometry exactly,
+    and must be kept in step with this file.
+
+    Usage:
+        python3 TzGeoFixture.py fixture.json
+"""
+
+import json
+import math
+import sys
+
+ROWS, COLS = 4, 5
+LAT0, LNG0 = 0.0, -60.0
+ROW_HEIGHT, COL_WIDTH = 10.0, 8.0
+STEP = 0.05
+ENCLAVE = (15.0, -48.0, 2.0)    # lat, lng, radius
+
+
+def border(k, lat):
+    # longitude of the border to the west of column k (the outer borders are straight)
+    wave = 0.0 if k in (0, COLS) else 1.5 * math.sin((0.7 * lat) + k)
+    return LNG0 + (k * COL_WIDTH) + wave
+
+
+def zone_ring(r, c):
+    lat0, lat1 = LAT0 + (r * ROW_HEIGHT), LAT0 + ((r + 1) * ROW_HEIGHT)
+    steps = int(round((lat1 - lat0) / STEP))
+    lats = [lat0 + (i * STEP) for i in range(steps + 1)]
+    east = [[border(c + 1, lat), lat] for lat in lats]              # northward
+    west = [[border(c, lat), lat] for lat in reversed(lats)]        # southward
+    ring = east + west
+    return ring + [ring[0]]
+
+
+def circle(lat, lng, radius, points=720):
+    ring = [[lng + (radius * math.cos(2 * math.pi * i / points)), lat + (radius * math.sin(2 * math.pi * i / points))]
+            for i in range(points)]
+    return ring + [ring[0]]
+
+
+def main():
+    if len(sys.argv) != 2:
+        sys.exit("usage: TzGeoFixture.py fixture.json")
+    enclave = circle(*ENCLAVE)
+    features = []
+    for r in range(ROWS):
+        for c in range(COLS):
+            rings = [zone_ring(r, c)]
+            if (r, c) == (1, 1):
+                rings.append(enclave)
+            features.append({"type": "Feature", "properties": {"tzid": "Fixture/Zone%d%d" % (r, c)},
+                             "geometry": {"type": "Polygon", "coordinates": rings}})
+    features.append({"type": "Feature", "properties": {"tzid": "Fixture/Enclave"},
+                     "geometry": {"type": "Polygon", "coordinates": [enclave]}})
+    with open(sys.argv[1], "w") as out:
+        json.dump({"type": "FeatureCollection", "features": features}, out)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,77 @@
+#include "TzTest.h"
+
+/*      Library: TzCfg
+        Host tests: TzGpsCacheTest.cpp covers TzGpsCache.cpp ... the cache
+        persisted in EEPROM (its layout & location), the bytes each insert
+        writes, and the entry an insert replaces.
+*/
+
+const int cacheByte = 1024;
+
+// An insert writes only the entry it replaced ... the rest of the cache is not rewritten
+TZ_TEST(gpsCacheInsertWritesOneEntry) {
+    TzGpsCache cache;
+    cache.load(cacheByte);
+    TZ_CHECK_EQ(EEPROM.writes, (uint32_t)sizeof(cache.data));   // <-- a new cache is stored once
+    time_t now = Time.now();
+    for (int i = 0; i < 3 * tzGpsCacheSize; i++) {
+        uint32_t writes = EEPROM.writes;
+        cache.insert(40.0f + i, -90.0f, now + i, "America/Chicago");
+        TZ_CHECK_EQ(EEPROM.writes - writes, (uint32_t)sizeof(cache.data.entry[0]));
+    }
+    TZ_CHECK_EQ(EEPROM.wear[cacheByte], 1u);    // <-- the signature is not rewritten
+    // the entries are stored where a reload finds them
+    TzGpsCache loaded;
+    loaded.load(cacheByte);
+    TZ_CHECK_EQ(memcmp(&loaded.data, &cache.data, sizeof(cache.data)), 0);
+    char id[65];
+    for (int i = 2 * tzGpsCacheSize; i < 3 * tzGpsCacheSize; i++) {
+        TZ_CHECK_EQ(loaded.find(40.0f + i, -90.0f, now + 100, id, sizeof(id)), EXIT_SUCCESS);
+        TZ_CHECK_EQ(strcmp(id, "America/Chicago"), 0);
+    }
+    TZ_CHECK_EQ(loaded.find(40.0f, -90.0f, now + 100, id, sizeof(id)), EXIT_FAILURE);
+}
+
+// Re-inserting a cached cell reuses its entry, even when an expired entry comes before it ... no live duplicate
+TZ_TEST(gpsCacheReinsertNoDuplicate) {
+    TzGpsCache cache;
+    time_t now = Time.now();
+    for (int i = 0; i < tzGpsCacheSize; i++) cache.insert(40.0f + i, -90.0f, now, "America/Chicago");
+    cache.data.entry[0].expires = (uint32_t)(now - 1);
+    cache.insert(40.0f + 2, -90.0f, now + 10, "America/Denver");
+    uint32_t cell = cache.cellOf(40.0f + 2, -90.0f);
+    int live = 0;
+    for (int i = 0; i < tzGpsCacheSize; i++) live += ((time_t)cache.data.entry[i].expires > now) && (cache.data.entry[i].cell == cell);
+    TZ_CHECK_EQ(live, 1);
+    TZ_CHECK_EQ(strcmp(cache.data.entry[2].id, "America/Denver"), 0);
+    // a new cell then takes the expired entry, not the least recently used one
+    cache.insert(30.0f, -90.0f, now + 20, "America/Chicago");
+    TZ_CHECK_EQ(cache.data.entry[0].cell, cache.cellOf(30.0f, -90.0f));
+}
+
+// The stored image has fixed-width fields & explicit padding ... the same layout from every compiler
+TZ_TEST(gpsCacheLayout) {
+    TzGpsCache cache;
+    TZ_CHECK_EQ(sizeof(cache.data), (size_t)332);
+    TZ_CHECK_EQ((size_t)((uint8_t*)&cache.data.entry[0] - (uint8_t*)&cache.data), (size_t)12);
+    TZ_CHECK_EQ(sizeof(cache.data.entry[0]), (size_t)80);
+}
+
+// The cache may not overlap TzCfg's region, or the TzJournal ring where the first write will put it
+TZ_TEST(gpsCacheEepromByteChecked) {
+    TzCfg tz;
+    tz.begin(cacheByte);
+    tz.setGpsCacheEepromByte(cacheByte + 100);
+    TZ_CHECK_EQ(tz.gpsCache.eepromByte, -1);
+    tz.setGpsCacheEepromByte(cacheByte - (int)sizeof(tz.gpsCache.data) + 1);
+    TZ_CHECK_EQ(tz.gpsCache.eepromByte, -1);
+    tz.setGpsCacheEepromByte(cacheByte + tzEepromSize);
+    TZ_CHECK_EQ(tz.gpsCache.eepromByte, cacheByte + tzEepromSize);
+    EEPROM.clear();
+    TzCfg unplaced;
+    unplaced.begin();
+    unplaced.setGpsCacheEepromByte(0);      // <-- the ring's default location
+    TZ_CHECK_EQ(unplaced.gpsCache.eepromByte, -1);
+    unplaced.setGpsCacheEepromByte(cacheByte);
+    TZ_CHECK_EQ(unplaced.gpsCache.eepromByte, cacheByte);
+}
@@ -0,0 +1,79 @@
+#include "TzStandIn.h"
+
+/*      Library: TzCfg
+        Host benchmarks: TzJournalBench.cpp measures EEPROM wear over ten years
+        of a device's life (America/Chicago, from the TzStandIn server): every
+        transition & refresh, with the device sleeping until nextDeadline().
+
+        Each time TzCfg writes a TzJournal record, the same settings are also
+        written the way the first versions of the library stored them (the
+        128-byte TzBlock struct, rewritten in place), so the two layouts are
+        compared on the same updates. Both count only changed bytes. The first
+        records fill erased slots, so the bytes written once the ring is full
+        (each record overwrites an older one) are also reported.
+*/
+
+static char chicago[] = "America/Chicago";
+static char testKey[] = "TESTKEY";
+const int legacyByte = 1500;    // <-- where the legacy TzBlock is written (clear of the ring at 0)
+
+// Writes the bytes of 'data' that differ from EEPROM at 'location' ... returns the number written
+static int writeChanged(int location, const void* data, int length) {
+    int n = 0;
+    for (int i = 0; i < length; i++) {
+        if (EEPROM.read(location + i) != ((const uint8_t*)data)[i]) {
+            EEPROM.write(location + i, ((const uint8_t*)data)[i]);
+            n++;
+        }
+    }
+    return n;
+}
+
+static uint32_t maxWear(int from, int to) {
+    uint32_t n = 0;
+    for (int i = from; i < to; i++) n = std::max(n, EEPROM.wear[i]);
+    return n;
+}
+
+TZ_BENCH(eepromWearBench) {
+    const int years = 10;
+    TzStandIn::install();
+    TzCfg tz;
+    tz.begin();
+    tz.setApiKey_timezonedb(testKey);
+    tz.setTimezoneByID(chicago);
+    int legacyBytes = writeChanged(legacyByte, &tz.tzEeprom, sizeof(TzBlock));
+    uint32_t records = 1, sequence = tz.journal.sequence;
+    uint32_t ringFull = 0;      // <-- bytes written once every slot held a record
+    int legacyFull = 0;
+    time_t end = Time.now() + (years * 365L * 86400L);
+    while (Time.now() < end) {
+        time_t deadline = tz.nextDeadline();
+        HostClock::set((deadline > Time.now()) ? deadline : Time.now() + 1);
+        tz.maintainLocalTime();
+        while (tz.getRefreshStatus() == TZ_PENDING) {
+            delay(1);
+            tz.maintainLocalTime();
+        }
+        if (tz.journal.sequence != sequence) {
+            sequence = tz.journal.sequence;
+            records++;
+            legacyBytes += writeChanged(legacyByte, &tz.tzEeprom, sizeof(TzBlock));
+            if (records == tzJournalSlots) {
+                ringFull = tz.getEepromBytesWritten();
+                legacyFull = legacyBytes;
+            }
+        }
+    }
+    TzStandIn::checkZone(tz, chicago);
+    uint32_t ringBytes = tz.getEepromBytesWritten();
+    TzTest::report("%d years: %u records written, %u lookups, %d timezonedb queries",
+        years, (unsigned)records, (unsigned)tz.getMetrics().lookups, TzStandIn::queries);
+    TzTest::report("TzJournal (3 x 224 bytes): %u bytes written (%.1f per record), most writes to one byte: %u",
+        (unsigned)ringBytes, (double)ringBytes / records, (unsigned)maxWear(0, tz.journal.size()));
+    TzTest::report("legacy TzBlock (128 bytes, in place): %d bytes written (%.1f per record), most writes to one byte: %u",
+        legacyBytes, (double)legacyBytes / records, (unsigned)maxWear(legacyByte, legacyByte + sizeof(TzBlock)));
+    TZ_CHECK(records > tzJournalSlots);
+    TzTest::report("after the first %d records: TzJournal %.1f bytes per record, legacy TzBlock %.1f",
+        tzJournalSlots, (double)(ringBytes - ringFull) / (records - tzJournalSlots), (double)(legacyBytes - legacyFull) / (records - tzJournalSlots));
+}
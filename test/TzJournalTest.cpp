@@ -0,0 +1,220 @@
+#include "TzStandIn.h"
+
+/*      Library: TzCfg
+        Host tests: TzJournalTest.cpp covers TzJournal.cpp ... where TzCfg
+        stores its settings in EEPROM, and that it writes no byte outside
+        its own ring (and region, begin(sb)).
+*/
+
+static char chicago[] = "America/Chicago";
+static char testKey[] = "TESTKEY";
+
+// Returns the number of EEPROM bytes written outside [from, to)
+static int writtenOutside(int from, int to) {
+    int n = 0;
+    for (int i = 0; i < (int)EEPROM.length(); i++) {
+        if (((i < from) || (i >= to)) && (EEPROM.wear[i] > 0)) n++;
+    }
+    return n;
+}
+
+// Stores a TzBlock the way the first versions of the library did (a raw TzBlock struct)
+static void storeLegacyBlock(int location) {
+    TzBlock blk;
+    strcpy(blk.id, chicago);
+    blk.stdOffset = -6;
+    blk.curOffset = -6;
+    strcpy(blk.curAbbr, "CST");
+    blk.tranTime = 1710057600;
+    blk.tranOffset = -5;
+    strcpy(blk.tranAbbr, "CDT");
+    EEPROM.put(location, blk);
+    memset(EEPROM.wear, 0, sizeof(EEPROM.wear));
+}
+
+TZ_TEST(footprintDefault) {
+    TzStandIn::install();
+    TzCfg tz;
+    tz.begin();
+    tz.setApiKey_timezonedb(testKey);
+    TZ_CHECK_EQ(tz.setTimezoneByID(chicago), EXIT_SUCCESS);
+    TZ_CHECK_EQ(tz.journal.base, 0);
+    TZ_CHECK_EQ(writtenOutside(0, tz.journal.size()), 0);
+    TzCfg reboot;
+    reboot.begin();
+    TZ_CHECK_EQ(strcmp(reboot.getTimezone(), chicago), 0);
+}
+
+TZ_TEST(footprintRegion) {
+    const int sb = 1024;
+    TzStandIn::install();
+    TzCfg tz;
+    tz.begin(sb);
+    tz.setApiKey_timezonedb(testKey);
+    TZ_CHECK_EQ(tz.setTimezoneByID(chicago), EXIT_SUCCESS);
+    TZ_CHECK_EQ(tz.journal.base, sb + (int)sizeof(TzDirectory));
+    TZ_CHECK_EQ(writtenOutside(sb, sb + tzEepromSize), 0);
+    EEPROM.reads = 0;
+    TzCfg reboot;
+    reboot.begin(sb);
+    TZ_CHECK(reboot.journal.foundViaDirectory);
+    TZ_CHECK(EEPROM.reads < (uint32_t)tzEepromSize);     // <-- the directory & the ring ... no scan
+    TZ_CHECK_EQ(strcmp(reboot.getTimezone(), chicago), 0);
+}
+
+TZ_TEST(regionOutOfRange) {
+    TzCfg tz;
+    tz.begin(EEPROM.length() - 100);
+    TZ_CHECK_EQ(tz.journal.directoryByte, -1);
+}
+
+TZ_TEST(legacyBlockMigrated) {
+    storeLegacyBlock(0);
+    TzCfg tz;
+    tz.begin();
+    TZ_CHECK(tz.tzEepromExists);
+    TZ_CHECK_EQ(tz.journal.sequence, 2u);
+    TZ_CHECK_EQ(writtenOutside(0, tz.journal.size()), 0);
+    TzCfg reboot;
+    reboot.begin();
+    TZ_CHECK(reboot.journal.sequence > 0);
+    TZ_CHECK_EQ(strcmp(reboot.getTimezone(), chicago), 0);
+    TZ_CHECK_EQ(reboot.getNextTransitionTime(), (time_t)1710057600);
+}
+
+// The ring is larger than the legacy TzBlock ... the application's data after it is never overwritten
+TZ_TEST(legacyBlockNextToData) {
+    storeLegacyBlock(0);
+    const char data[] = "application data";
+    EEPROM.put(300, data);
+    memset(EEPROM.wear, 0, sizeof(EEPROM.wear));
+    TzCfg tz;
+    tz.begin();
+    TZ_CHECK(tz.tzEepromExists);
+    TZ_CHECK_EQ(strcmp(tz.getTimezone(), chicago), 0);
+    TZ_CHECK_EQ(writtenOutside(0, 0), 0);   // <-- nothing written at all
+    char check[sizeof(data)];
+    EEPROM.get(300, check);
+    TZ_CHECK_EQ(strcmp(check, data), 0);
+    TzCfg reboot;
+    reboot.begin();
+    TZ_CHECK_EQ(strcmp(reboot.getTimezone(), chicago), 0);  // <-- the legacy TzBlock is still read
+}
+
+TZ_TEST(legacyBlockIntoRegion) {
+    const int sb = 1024;
+    storeLegacyBlock(0);
+    TzCfg tz;
+    tz.begin(sb);
+    TZ_CHECK_EQ(tz.journal.base, sb + (int)sizeof(TzDirectory));
+    TZ_CHECK(writtenOutside(sb, sb + tzEepromSize) <= (int)sizeof(TzBlock));  // <-- the legacy TzBlock, erased
+    for (int i = 0; i < (int)sizeof(TzBlock); i++) TZ_CHECK_EQ(EEPROM.read(i), 0xFF);
+    TzCfg reboot;
+    reboot.begin(sb);
+    TZ_CHECK(reboot.journal.foundViaDirectory);
+    TZ_CHECK_EQ(strcmp(reboot.getTimezone(), chicago), 0);
+}
+
+TZ_TEST(newRingNextToData) {
+    TzStandIn::install();
+    EEPROM.write(500, 0x42);
+    memset(EEPROM.wear, 0, sizeof(EEPROM.wear));
+    TzCfg tz;
+    tz.begin();
+    tz.setApiKey_timezonedb(testKey);
+    tz.setTimezoneByID(chicago);
+    TZ_CHECK( !tz.tzEepromExists);
+    TZ_CHECK_EQ(writtenOutside(0, 0), 0);
+    tz.setEepromStartByte(600);     // <-- moves the settings clear of the data
+    TZ_CHECK_EQ(tz.setTimezoneByID(chicago), EXIT_SUCCESS);
+    TZ_CHECK(tz.tzEepromExists);
+    TZ_CHECK_EQ(writtenOutside(600, 600 + tz.journal.size()), 0);
+    tz.setEepromStartByte(100);     // <-- rejected: the ring would overlap the data
+    TZ_CHECK_EQ(tz.journal.base, 600);
+    TZ_CHECK_EQ(EEPROM.read(500), 0x42);
+}
+
+// A first write interrupted by a reset leaves a ring that is recognized as TzCfg's own
+TZ_TEST(interruptedFirstWrite) {
+    TzCfg tz;
+    tz.begin();
+    tz.journal.locate(0);
+    TzBlock blk;
+    TzSchedule sched;
+    tz.journal.write(blk, sched);
+    for (int i = 6; i < 12; i++) EEPROM.write(i, 0);        // <-- the header's CRC & sequence were not written
+    TZ_CHECK(tz.journal.claimable(0, -1, 0));
+    TzCfg reboot;
+    reboot.begin();
+    TZ_CHECK( !reboot.tzEepromExists);
+}
+
+// Packed against the image it overwrites, a record keeps the transitions still scheduled in place
+TZ_TEST(recordPackedAgainstPrior) {
+    TzCfg tz;
+    TzRule rule;
+    TZ_CHECK_EQ(rule.compile("CST6CDT,M3.2.0,M11.1.0"), EXIT_SUCCESS);
+    TzBlock before, after, unpacked;
+    TzSchedule beforeSched, afterSched, unpackedSched;
+    strcpy(before.id, chicago);
+    strcpy(beforeSched.rule, "CST6CDT,M3.2.0,M11.1.0");
+    after = before;
+    afterSched = beforeSched;
+    tz.applyRule(rule, before, beforeSched, tzTestEpoch);
+    tz.applyRule(rule, after, afterSched, tzTestEpoch + (400 * 86400L));    // <-- 3 transitions later
+    TzRecord prior, canonical, aligned, repacked;
+    prior.pack(before, beforeSched);
+    canonical.pack(after, afterSched);
+    aligned.pack(after, afterSched, &prior);
+    TZ_CHECK(aligned.unpack(unpacked, unpackedSched));
+    repacked.pack(unpacked, unpackedSched);
+    TZ_CHECK(repacked == canonical);
+    int alignedChanges = 0, canonicalChanges = 0;
+    for (int i = 0; i < tzRecordSize; i++) {
+        alignedChanges += (aligned.data[i] != prior.data[i]);
+        canonicalChanges += (canonical.data[i] != prior.data[i]);
+    }
+    // the offset & abbreviation, the mask, and the 3 new entries (their times & abbreviations) at most
+    TZ_CHECK( !(alignedChanges > 2 + 6 + 1 + (3 * tzRecordEntrySize)));
+    TZ_CHECK(alignedChanges < canonicalChanges);
+}
+
+// Once every slot holds the schedule, a transition rewrites the header's sequence & CRC, the mask, the offset & the abbreviation
+TZ_TEST(transitionRewritesFewBytes) {
+    TzStandIn::install();
+    TzCfg tz;
+    tz.begin();
+    tz.setApiKey_timezonedb(testKey);
+    TZ_CHECK_EQ(tz.setTimezoneByID(chicago), EXIT_SUCCESS);
+    TzStandIn::settle(tz);      // <-- the record written with the schedule
+    uint32_t settled = tz.journal.sequence;
+    while (tz.journal.sequence < settled + tzJournalSlots - 1) tz.transitionNow();
+    while (tz.schedule.count > 0) {
+        uint32_t before = tz.getEepromBytesWritten(), sequence = tz.journal.sequence;
+        tz.transitionNow();
+        TZ_CHECK_EQ(tz.journal.sequence, sequence + 1);
+        TZ_CHECK( !(tz.getEepromBytesWritten() - before > 3 + 1 + 2 + 2));
+    }
+}
+
+// A TzSet is only persisted where its records overwrite nothing but erased bytes and its own records
+TZ_TEST(zoneSetNextToData) {
+    const int dataByte = 1900;
+    char site[] = "Site/Chicago";
+    char rule[] = "CST6CDT,M3.2.0,M11.1.0";
+    EEPROM.write(dataByte, 0x5A);
+    TzSet sites;
+    int z = sites.addByRule(site, rule);
+    TZ_CHECK(z >= 0);
+    sites.setEepromStartByte(1024);     // <-- rejected: the records would overlap the data
+    TZ_CHECK_EQ(sites.eepromStartByte, -1);
+    TZ_CHECK_EQ(EEPROM.read(dataByte), 0x5A);
+    TZ_CHECK_EQ(writtenOutside(dataByte, dataByte + 1), 0);
+    sites.setEepromStartByte(100);
+    TZ_CHECK_EQ(sites.eepromStartByte, 100);
+    TzSet reboot;
+    reboot.setEepromStartByte(100);     // <-- its own records ... restored
+    TZ_CHECK_EQ(reboot.eepromStartByte, 100);
+    TZ_CHECK(reboot.ready(z));
+    TZ_CHECK_EQ(strcmp(reboot.getTimezone(z), site), 0);
+}
@@ -0,0 +1,158 @@
+#include "TzStandIn.h"
+
+/*      Library: TzCfg
+        Host tests: TzProviderTest.cpp covers TzProvider.cpp ... lookups from a
+        provider that answers in one response (<schedule>, <rule> or a binary
+        body), and the IP lookup from ip-api.
+*/
+
+static char chatham[] = "Pacific/Chatham";
+static char sydney[] = "Australia/Sydney";
+static char testKey[] = "TESTKEY";
+
+// Pacific/Chatham has the longest schedule entries in the zone table ("1711806300,45900,+1245")
+TZ_TEST(proxyScheduleFull) {
+    TzStandIn::install();
+    TzCfg tz;
+    tz.begin();
+    tz.setZoneProvider(&tzStandInProxy);
+    TZ_CHECK_EQ(tz.setTimezoneByID(chatham), EXIT_SUCCESS);
+    TZ_CHECK_EQ(TzStandIn::proxyQueries, 1);
+    TZ_CHECK_EQ(tz.schedule.count, tzScheduleSize);
+    TzStandIn::checkZone(tz, chatham);
+}
+
+TZ_TEST(proxyScheduleTruncated) {
+    TzStandIn::install();
+    TzStandIn::scheduleEntries = tzScheduleSize + 3;    // <-- more than jsonSchedule holds
+    TzCfg tz;
+    tz.begin();
+    tz.setZoneProvider(&tzStandInProxy);
+    TZ_CHECK_EQ(tz.setTimezoneByID(chatham), EXIT_FAILURE);
+    TZ_CHECK_EQ(tz.getLastError(), TZ_E_SCHEDULE);
+    TZ_CHECK_EQ(strncmp(tz.getHttpStatus(), "(E766)", 6), 0);
+    TZ_CHECK( !tz.tzEepromExists);
+}
+
+// Europe/Paris's entries are short enough that a <schedule> of tzScheduleSize + 2 fits in jsonSchedule
+TZ_TEST(proxyScheduleTooLong) {
+    TzStandIn::install();
+    TzStandIn::scheduleEntries = tzScheduleSize + 2;
+    TzCfg tz;
+    tz.begin();
+    tz.setZoneProvider(&tzStandInProxy);
+    char paris[] = "Europe/Paris";
+    TZ_CHECK_EQ(tz.setTimezoneByID(paris), EXIT_FAILURE);
+    TZ_CHECK_EQ(tz.getLastError(), TZ_E_SCHEDULE);
+    TZ_CHECK( !tz.tzEepromExists);
+    TzStandIn::scheduleEntries = tzScheduleSize + 1;
+    TZ_CHECK_EQ(tz.setTimezoneByID(paris), EXIT_SUCCESS);
+    TzStandIn::checkZone(tz, paris);
+}
+
+TZ_TEST(proxyScheduleEmpty) {
+    TzStandIn::install();
+    TzCfg tz;
+    tz.begin();
+    tz.setZoneProvider(&tzStandInProxy);
+    char tokyo[] = "Asia/Tokyo";
+    TZ_CHECK_EQ(tz.setTimezoneByID(tokyo), EXIT_SUCCESS);
+    TZ_CHECK_EQ(tz.getNextTransitionTime(), (time_t)0);
+    TzStandIn::checkZone(tz, tokyo);
+}
+
+TZ_TEST(proxyRule) {
+    TzStandIn::install();
+    TzStandIn::proxyRule = true;
+    TzCfg tz;
+    tz.begin();
+    tz.setZoneProvider(&tzStandInProxy);
+    TZ_CHECK_EQ(tz.setTimezoneByID(sydney), EXIT_SUCCESS);
+    TZ_CHECK(tz.rule.valid);
+    TzStandIn::checkZone(tz, sydney);
+}
+
+TZ_TEST(proxyBinary) {
+    TzStandIn::install();
+    TzCfg tz;
+    tz.begin();
+    tz.setZoneProvider(&tzStandInProxyBinary);
+    TZ_CHECK_EQ(tz.setTimezoneByID(chatham), EXIT_SUCCESS);
+    TZ_CHECK(tz.http.parser.binary);
+    TZ_CHECK_EQ(tz.schedule.count, tzScheduleSize);
+    TzStandIn::checkZone(tz, chatham);
+    TzStandIn::proxyRule = true;
+    TZ_CHECK_EQ(tz.setTimezoneByID(sydney), EXIT_SUCCESS);
+    TZ_CHECK(tz.rule.valid);
+    TzStandIn::checkZone(tz, sydney);
+}
+
+TZ_TEST(proxyByPosition) {
+    TzStandIn::install();
+    TzCfg tz;
+    tz.begin();
+    tz.setZoneProvider(&tzStandInProxy);
+    TZ_CHECK_EQ(tz.setTimezoneByGPS(-33.9f, 151.2f), EXIT_SUCCESS);
+    TzStandIn::checkZone(tz, sydney);
+}
+
+TZ_TEST(ipApiLookup) {
+    TzStandIn::install();
+    TzCfg tz;
+    tz.begin();
+    tz.setApiKey_timezonedb(testKey);
+    TZ_CHECK_EQ(tz.setTimezoneByIP(), EXIT_SUCCESS);
+    TZ_CHECK_EQ(TzStandIn::ipQueries, 1);
+    TZ_CHECK_EQ(strcmp(tz.getLocalIP(), "203.0.113.7"), 0);
+    TzStandIn::checkZone(tz, "America/Chicago");
+}
+
+// The IP query is the lookup's first pass on the non-blocking path: the zone's passes follow it at once,
+// and the schedule is fetched in the background like setTimezoneByID()'s
+TZ_TEST(ipApiLookupPolled) {
+    TzStandIn::install();
+    TzCfg tz;
+    tz.begin();
+    tz.setApiKey_timezonedb(testKey);
+    unsigned long start = millis();
+    TZ_CHECK_EQ(tz.setTimezoneByIP(), EXIT_SUCCESS);
+    TZ_CHECK(millis() - start <= tzdbQueryGap + 100);
+    TZ_CHECK_EQ(tz.getRefreshStatus(), TZ_PENDING);
+    TZ_CHECK_EQ(tz.getMetrics().transactions, 3u);
+    TzStandIn::settle(tz);
+    TZ_CHECK_EQ(tz.getRefreshStatus(), EXIT_SUCCESS);
+    TZ_CHECK_EQ(TzStandIn::ipQueries, 1);
+    TZ_CHECK_EQ(tz.schedule.count, tzScheduleSize);
+    TzStandIn::checkZone(tz, "America/Chicago");
+}
+
+TZ_TEST(ipApiFailure) {
+    TzStandIn::install();
+    TzStandIn::ipZone = "";
+    TzCfg tz;
+    tz.begin();
+    tz.setApiKey_timezonedb(testKey);
+    TZ_CHECK_EQ(tz.setTimezoneByIP(), EXIT_FAILURE);
+    TZ_CHECK_EQ(tz.getLastError(), TZ_E_IPAPI_FAIL);
+    TZ_CHECK_EQ(strcmp(tz.getHttpStatus(), "(ip-api) reserved range"), 0);
+}
+
+// A zone without transitions (tranTime 0) stays current ... a reboot does not query timezonedb again
+TZ_TEST(ipApiUnchangedNoTransitions) {
+    TzStandIn::install();
+    TzStandIn::ipZone = "Asia/Tokyo";
+    {
+        TzCfg tz;
+        tz.begin();
+        tz.setApiKey_timezonedb(testKey);
+        TZ_CHECK_EQ(tz.setTimezoneByIP(), EXIT_SUCCESS);
+    }
+    int queries = TzStandIn::queries;
+    TzCfg tz;
+    tz.begin();
+    tz.setApiKey_timezonedb(testKey);
+    TZ_CHECK_EQ(tz.setTimezoneByIP(), EXIT_SUCCESS);
+    TZ_CHECK_EQ(TzStandIn::queries, queries);
+    TZ_CHECK_EQ(strcmp(tz.getHttpStatus(), "Time Zone Unchanged (ip-api)"), 0);
+    TzStandIn::checkZone(tz, "Asia/Tokyo");
+}
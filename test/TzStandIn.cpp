@@ -0,0 +1,300 @@
+#include "TzStandIn.h"
+
+/*      Library: TzCfg
+        Host tests: TzStandIn.cpp answers the requests TzCfg sends to its time
+        zone servers (see TzStandIn.h).
+
+        timezonedb: /v2/get-time-zone?key=&format=json&by=zone&zone=[&time=]
+                    /v2/get-time-zone?key=&format=json&by=position&lat=&lng=[&time=]
+            The response describes the period in effect at 'time' (default:
+            now): its offset, abbreviation & DST flag, and dstEnd, the last
+            second of the period (0 when the zone has no transitions).
+
+        ip-api:     /json?fields=...
+            The device's zone is ipZone, and its address 203.0.113.7.
+
+        proxy:      /proxy?zone=   /proxy?lat=&lng=
+            The current period, and the next scheduleEntries transitions as a
+            <schedule> (or the zone's <rule>) ... or, when the request accepts
+            tzStandInBinaryType, the same lookup as a binary body (the layout
+            is in TzProvider.cpp).
+*/
+
+const TzProvider tzStandInProxy = {
+    "proxy", "tz.example.com", 80,
+    "/proxy?zone=%z",
+    "/proxy?lat=%a&lng=%o",
+    NULL,
+    "OK",
+    { "status", "message", "gmtOffset", "dst", "", "", "zoneName", "abbreviation", "schedule", "rule", "" }
+};
+
+const TzProvider tzStandInProxyBinary = {
+    "proxy", "tz.example.com", 80,
+    "/proxy?zone=%z",
+    "/proxy?lat=%a&lng=%o",
+    NULL,
+    "OK",
+    { "status", "message", "gmtOffset", "dst", "", "", "zoneName", "abbreviation", "schedule", "rule", "" },
+    tzStandInBinaryType
+};
+
+const TzStandInZone TzStandIn::zones[] = {
+    { "America/Chicago",    "CST6CDT,M3.2.0,M11.1.0",                           41.88f,  -87.63f },
+    { "America/New_York",   "EST5EDT,M3.2.0,M11.1.0",                           40.71f,  -74.01f },
+    { "Europe/Paris",       "CET-1CEST,M3.5.0,M10.5.0/3",                       48.86f,    2.35f },
+    { "Australia/Sydney",   "AEST-10AEDT,M10.1.0,M4.1.0/3",                    -33.87f,  151.21f },
+    { "Pacific/Chatham",    "<+1245>-12:45<+1345>,M9.5.0/2:45,M4.1.0/3:45",    -43.95f, -176.55f },
+    { "Asia/Tokyo",         "JST-9",                                            35.68f,  139.69f },
+    { "Asia/Kolkata",       "IST-5:30",                                         28.61f,   77.21f }
+};
+const int TzStandIn::zoneCount = sizeof(TzStandIn::zones) / sizeof(TzStandIn::zones[0]);
+
+std::string TzStandIn::apiKey = "TESTKEY";
+bool TzStandIn::etags = false;
+unsigned long TzStandIn::rateLimitMillis = 0;
+int TzStandIn::queries = 0;
+int TzStandIn::notModified = 0;
+unsigned long TzStandIn::lastMillis = 0;
+bool TzStandIn::proxyRule = false;
+int TzStandIn::scheduleEntries = tzScheduleSize + 1;
+std::string TzStandIn::ipZone = "America/Chicago";
+int TzStandIn::ipQueries = 0;
+int TzStandIn::proxyQueries = 0;
+
+// ---------------------------------------------------------------------------- install()
+void TzStandIn::install(void) {
+    apiKey = "TESTKEY";
+    etags = false;
+    rateLimitMillis = 0;
+    queries = 0;
+    notModified = 0;
+    lastMillis = 0;
+    proxyRule = false;
+    scheduleEntries = tzScheduleSize + 1;
+    ipZone = "America/Chicago";
+    ipQueries = 0;
+    proxyQueries = 0;
+    HostNet::handler = serve;
+}
+
+// ---------------------------------------------------------------------------- find()
+const TzStandInZone* TzStandIn::find(const char* id) {
+    for (int i = 0; i < zoneCount; i++) {
+        if (strcmp(zones[i].id, id) == 0) return &zones[i];
+    }
+    return NULL;
+}
+
+// ---------------------------------------------------------------------------- offsetAt()
+long TzStandIn::offsetAt(const TzStandInZone* zone, time_t t, bool* dst, std::string* abbr) {
+    static std::string current;
+    if (current != zone->rule) {
+        current = zone->rule;
+        setenv("TZ", zone->rule, 1);
+        tzset();
+    }
+    struct tm tm;
+    localtime_r(&t, &tm);
+    if (dst != NULL) *dst = (tm.tm_isdst > 0);
+    if (abbr != NULL) *abbr = tm.tm_zone;
+    return tm.tm_gmtoff;
+}
+
+// ---------------------------------------------------------------------------- nextTransition()
+time_t TzStandIn::nextTransition(const TzStandInZone* zone, time_t t) {
+    long offset = offsetAt(zone, t);
+    for (time_t day = t + 86400; day < t + (2 * 366 * 86400L); day += 86400) {
+        if (offsetAt(zone, day) == offset) continue;
+        time_t lo = day - 86400, hi = day;  // <-- offset(lo) == offset, offset(hi) != offset
+        while (hi - lo > 1) {
+            time_t mid = lo + ((hi - lo) / 2);
+            if (offsetAt(zone, mid) == offset) lo = mid; else hi = mid;
+        }
+        return hi;
+    }
+    return 0;
+}
+
+// ---------------------------------------------------------------------------- locate()
+// Returns the zone a request names (zone=), or the nearest within 5 degrees of its position (lat= & lng=)
+const TzStandInZone* TzStandIn::locate(const std::string& path) {
+    if (param(path, "lat").empty()) return find(param(path, "zone").c_str());
+    const TzStandInZone* zone = NULL;
+    float lat = atof(param(path, "lat").c_str()), lng = atof(param(path, "lng").c_str());
+    float best = 25;
+    for (int i = 0; i < zoneCount; i++) {
+        float d = ((zones[i].lat - lat) * (zones[i].lat - lat)) + ((zones[i].lng - lng) * (zones[i].lng - lng));
+        if (d < best) {
+            best = d;
+            zone = &zones[i];
+        }
+    }
+    return zone;
+}
+
+// ---------------------------------------------------------------------------- checkZone()
+// Checks the device's settings, and the stored schedule, against the zone table at Time.now()
+void TzStandIn::checkZone(TzCfg& tz, const char* id) {
+    const TzStandInZone* zone = find(id);
+    time_t now = Time.now();
+    TZ_CHECK_EQ(strcmp(tz.getTimezone(), id), 0);
+    TZ_CHECK_EQ(tzMinutes(tz.tzEeprom.curOffset), offsetAt(zone, now) / 60);
+    TZ_CHECK_EQ(tz.getNextTransitionTime(), nextTransition(zone, now));
+    TZ_CHECK_EQ((long)((Time.zone() + (Time.isDST() ? Time.getDSTOffset() : 0)) * 3600), offsetAt(zone, now));
+    time_t t = tz.getNextTransitionTime();
+    for (int i = 0; (t > 0) && (i < tz.schedule.count); i++) {
+        t = nextTransition(zone, t);
+        TZ_CHECK_EQ(tz.schedule.tran[i].time, t);
+        TZ_CHECK_EQ(tzMinutes(tz.schedule.tran[i].offset), offsetAt(zone, t) / 60);
+    }
+}
+
+// ---------------------------------------------------------------------------- settle()
+void TzStandIn::settle(TzCfg& tz) {
+    while (tz.getRefreshStatus() == TZ_PENDING) {
+        delay(1);
+        tz.maintainLocalTime();
+    }
+}
+
+// ---------------------------------------------------------------------------- param()
+std::string TzStandIn::param(const std::string& path, const char* name) {
+    std::string key = std::string(name) + "=";
+    size_t at = path.find('?');
+    while (at != std::string::npos) {
+        at++;
+        if (path.compare(at, key.size(), key) == 0) {
+            size_t end = path.find('&', at);
+            return path.substr(at + key.size(), (end == std::string::npos) ? std::string::npos : end - at - key.size());
+        }
+        at = path.find('&', at);
+    }
+    return "";
+}
+
+// ---------------------------------------------------------------------------- response()
+std::string TzStandIn::response(int status, const std::string& body, const std::string& headers) {
+    const char* reason = (status == 200) ? "OK" : (status == 304) ? "Not Modified" : (status == 429) ? "Too Many Requests" : "Error";
+    std::string text = "HTTP/1.1 " + std::to_string(status) + " " + reason + "\r\n" + headers;
+    if (status != 304) {
+        if (headers.find("Content-Type:") == std::string::npos) text += "Content-Type: application/json\r\n";
+        text += "Content-Length: " + std::to_string(body.size()) + "\r\n";
+    }
+    text += "Connection: keep-alive\r\n\r\n";
+    return (status == 304) ? text : text + body;
+}
+
+// ---------------------------------------------------------------------------- serve()
+std::string TzStandIn::serve(const std::string& request) {
+    size_t start = request.find(' ');
+    size_t end = request.find(' ', start + 1);
+    std::string path = request.substr(start + 1, end - start - 1);
+    if (path.compare(0, 18, "/v2/get-time-zone?") == 0) return timezonedb(request, path);
+    if (path.compare(0, 6, "/json?") == 0) return ipApi(request, path);
+    if (path.compare(0, 7, "/proxy?") == 0) return proxy(request, path);
+    return response(404, "{\"status\":\"FAILED\",\"message\":\"Not found.\"}");
+}
+
+// ---------------------------------------------------------------------------- timezonedb()
+std::string TzStandIn::timezonedb(const std::string& request, const std::string& path) {
+    queries++;
+    bool limited = (rateLimitMillis > 0) && (queries > 1) && ((millis() - lastMillis) < rateLimitMillis);
+    lastMillis = millis();
+    if (limited) return response(200, "{\"status\":\"FAILED\",\"message\":\"You have exceeded the rate limit. Please try again later.\"}");
+    if (param(path, "key") != apiKey) return response(200, "{\"status\":\"FAILED\",\"message\":\"Invalid API key.\"}");
+    const TzStandInZone* zone = locate(path);
+    if (zone == NULL) return response(200, "{\"status\":\"FAILED\",\"message\":\"Record not found.\"}");
+    std::string time = param(path, "time");
+    time_t t = time.empty() ? Time.now() : (time_t)atol(time.c_str());
+    bool dst;
+    std::string abbr, nextAbbr;
+    long offset = offsetAt(zone, t, &dst, &abbr);
+    time_t tran = nextTransition(zone, t);
+    if (tran > 0) offsetAt(zone, tran, NULL, &nextAbbr);
+    std::string headers;
+    if (etags) {
+        std::string etag = "\"" + std::to_string((long)tran) + "-" + std::to_string(offset) + "\"";
+        if (request.find("If-None-Match: " + etag) != std::string::npos) {
+            notModified++;
+            return response(304, "", "ETag: " + etag + "\r\n");
+        }
+        headers = "ETag: " + etag + "\r\n";
+    }
+    std::string body = "{\"status\":\"OK\",\"message\":\"\",\"countryCode\":\"XX\",\"zoneName\":\"" + std::string(zone->id)
+        + "\",\"abbreviation\":\"" + abbr + "\",\"gmtOffset\":" + std::to_string(offset) + ",\"dst\":\"" + (dst ? "1" : "0")
+        + "\",\"zoneStart\":0,\"zoneEnd\":" + ((tran > 0) ? std::to_string((long)tran - 1) : "null")
+        + ",\"dstEnd\":" + ((tran > 0) ? std::to_string((long)tran - 1) : "0")
+        + ",\"nextAbbreviation\":\"" + nextAbbr + "\",\"timestamp\":" + std::to_string((long)(t + offset)) + "}";
+    return response(200, body, headers);
+}
+
+// ---------------------------------------------------------------------------- ipApi()
+std::string TzStandIn::ipApi(const std::string& request, const std::string& path) {
+    ipQueries++;
+    const TzStandInZone* zone = find(ipZone.c_str());
+    if (zone == NULL) return response(200, "{\"status\":\"fail\",\"message\":\"reserved range\",\"query\":\"203.0.113.7\"}");
+    return response(200, "{\"status\":\"success\",\"timezone\":\"" + ipZone + "\",\"offset\":"
+        + std::to_string(offsetAt(zone, Time.now())) + ",\"query\":\"203.0.113.7\"}");
+}
+
+// ---------------------------------------------------------------------------- proxy()
+std::string TzStandIn::proxy(const std::string& request, const std::string& path) {
+    proxyQueries++;
+    const TzStandInZone* zone = locate(path);
+    if (zone == NULL) return response(200, "{\"status\":\"FAILED\",\"message\":\"Unknown zone.\"}");
+    time_t now = Time.now();
+    bool dst;
+    std::string abbr;
+    long offset = offsetAt(zone, now, &dst, &abbr);
+    std::vector<time_t> times;
+    for (time_t t = nextTransition(zone, now); (t > 0) && ((int)times.size() < scheduleEntries); t = nextTransition(zone, t)) times.push_back(t);
+    if (request.find(std::string("Accept: ") + tzStandInBinaryType) != std::string::npos) {
+        std::vector<std::string> abbrs(1, abbr);
+        std::string body;
+        auto u8 = [&](int v) { body += (char)(uint8_t)v; };
+        auto str = [&](const std::string& v) { u8(v.size()); body += v; };
+        auto index = [&](const std::string& a) {
+            for (size_t i = 0; i < abbrs.size(); i++) if (abbrs[i] == a) return (int)i;
+            abbrs.push_back(a);
+            return (int)abbrs.size() - 1;
+        };
+        std::string tail;
+        if ( !proxyRule) {
+            tail += (char)times.size();
+            for (time_t t : times) {
+                std::string a;
+                long o = offsetAt(zone, t, NULL, &a) / 60;
+                int i = index(a);
+                for (int shift = 24; shift >= 0; shift -= 8) tail += (char)(uint8_t)((uint32_t)t >> shift);
+                tail += (char)(uint8_t)((uint16_t)o >> 8);
+                tail += (char)(uint8_t)o;
+                tail += (char)i;
+            }
+        }
+        u8(tzBinaryVersion);
+        u8((dst ? 2 : 0) | (proxyRule ? 4 : 0));
+        u8((uint16_t)(offset / 60) >> 8);
+        u8((uint16_t)(offset / 60));
+        str(zone->id);
+        u8(abbrs.size());
+        for (const std::string& a : abbrs) str(a);
+        u8(0);
+        body += proxyRule ? std::string(1, (char)strlen(zone->rule)) + zone->rule : tail;
+        return response(200, body, std::string("Content-Type: ") + tzStandInBinaryType + "\r\n");
+    }
+    std::string body = "{\"status\":\"OK\",\"message\":\"\",\"zoneName\":\"" + std::string(zone->id) + "\",\"abbreviation\":\"" + abbr
+        + "\",\"gmtOffset\":" + std::to_string(offset) + ",\"dst\":\"" + (dst ? "1" : "0") + "\",";
+    if (proxyRule) {
+        body += "\"rule\":\"" + std::string(zone->rule) + "\"}";
+    } else {
+        std::string schedule;
+        for (time_t t : times) {
+            std::string a;
+            long o = offsetAt(zone, t, NULL, &a);
+            schedule += (schedule.empty() ? "" : ";") + std::to_string((long)t) + "," + std::to_string(o) + "," + a;
+        }
+        body += "\"schedule\":\"" + schedule + "\"}";
+    }
+    return response(200, body);
+}
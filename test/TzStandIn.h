@@ -0,0 +1,62 @@
+#ifndef __TZSTANDIN_H_
+#define __TZSTANDIN_H_
+
+#include "TzTest.h"
+
+/*      Library: TzCfg
+        Host tests: TzStandIn is a local stand-in for the time zone servers,
+        installed as the HostNet handler. It answers timezonedb requests the
+        way api.timezonedb.com does, computing each zone's offsets and
+        transitions with the C library from the POSIX TZ rules in its zone
+        table (so it needs no tz database, and agrees with TzRule only by
+        being right).
+
+        It also answers as ip-api.com, and as a fleet's caching proxy that
+        returns a whole lookup in one response (tzStandInProxy): with a
+        <schedule>, a <rule>, or a compact binary body when the request
+        accepts tzStandInBinaryType.
+*/
+
+struct TzStandInZone {
+    const char* id;                         // <-- Time zone ID
+    const char* rule;                       // <-- POSIX TZ rule
+    float lat, lng;                         // <-- A position in the zone (lookups by position pick the nearest)
+};
+
+const char tzStandInBinaryType[] = "application/x-tzcfg";
+
+extern const TzProvider tzStandInProxy;         // <-- The proxy, with a <schedule> or <rule> (see TzStandIn::proxyRule)
+extern const TzProvider tzStandInProxyBinary;   // <-- The proxy, offered its binary response
+
+class TzStandIn {
+    public:
+        static void install(void);                  // <-- Resets the counters & options, and answers HostNet requests
+        static std::string serve(const std::string& request);  // <-- The HostNet handler
+        static std::string response(int status, const std::string& body, const std::string& headers = "");    // <-- Frames an HTTP/1.1 response
+        static const TzStandInZone* find(const char* id);   // <-- Looks up a zone in the table
+        static long offsetAt(const TzStandInZone* zone, time_t t, bool* dst = NULL, std::string* abbr = NULL); // <-- UTC offset (seconds) at t
+        static time_t nextTransition(const TzStandInZone* zone, time_t t);   // <-- First transition after t (0 = none within 2 years)
+        static std::string param(const std::string& path, const char* name);  // <-- Value of a query parameter ("" = absent)
+        static const TzStandInZone zones[];         // <-- The zone table
+        static const int zoneCount;
+        static std::string apiKey;                  // <-- Key timezonedb requests must carry
+        static bool etags;                          // <-- Send an ETag, and answer a matching If-None-Match with 304
+        static unsigned long rateLimitMillis;       // <-- Requests closer together than this are refused like timezonedb's free tier (0 = none)
+        static int queries;                         // <-- timezonedb requests answered
+        static int notModified;                     // <-- 304 responses sent
+        static bool proxyRule;                      // <-- The proxy sends the zone's <rule> instead of its <schedule>
+        static int scheduleEntries;                 // <-- Transitions in the proxy's <schedule> & binary response (default tzScheduleSize + 1)
+        static std::string ipZone;                  // <-- Zone ID ip-api reports for the device
+        static int ipQueries;                       // <-- ip-api requests answered
+        static int proxyQueries;                    // <-- Proxy requests answered
+        static void checkZone(TzCfg& tz, const char* id);   // <-- Checks a TzCfg's settings & schedule against the zone table
+        static void settle(TzCfg& tz);              // <-- Runs maintainLocalTime() until a pending lookup completes
+    private:
+        static std::string timezonedb(const std::string& request, const std::string& path);
+        static std::string ipApi(const std::string& request, const std::string& path);
+        static std::string proxy(const std::string& request, const std::string& path);
+        static const TzStandInZone* locate(const std::string& path);
+        static unsigned long lastMillis;
+};
+
+#endif
@@ -0,0 +1,80 @@
+#include "TzTest.h"
+#include <stdarg.h>
+
+/*      Library: TzCfg
+        Host tests: TzTest.cpp runs the registered tests (and, with --bench,
+        the benchmarks). A name given on the command line runs only the tests
+        & benchmarks whose names contain it.
+
+            tzcfg_test [--bench] [name]
+
+        The exit status is the number of failed checks (0 = success).
+*/
+
+TzTest* TzTest::first = NULL;
+int TzTest::failures = 0;
+
+TzTest::TzTest(const char* name, Function function, bool bench) {
+    this->name = name;
+    this->function = function;
+    this->bench = bench;
+    // keep the registration order (the order of the modules on the link line, then the file)
+    this->next = NULL;
+    TzTest** link = &first;
+    while (*link != NULL) link = &(*link)->next;
+    *link = this;
+}
+
+void TzTest::fail(const char* file, int line, const char* expression) {
+    failures++;
+    printf("    FAILED %s:%d: %s\n", file, line, expression);
+}
+
+void TzTest::report(const char* format, ...) {
+    va_list args;
+    va_start(args, format);
+    printf("    ");
+    vprintf(format, args);
+    printf("\n");
+    va_end(args);
+}
+
+double TzTest::nanos(void) {
+    return (double)std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+int TzTest::run(int argc, char** argv) {
+    bool bench = false;
+    const char* filter = NULL;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--bench") == 0) {
+            bench = true;
+        } else {
+            filter = argv[i];
+        }
+    }
+    int count = 0;
+    for (TzTest* t = first; t != NULL; t = t->next) {
+        if ((t->bench != bench) || ((filter != NULL) && (strstr(t->name, filter) == NULL))) continue;
+        EEPROM.resize(hostEepromSize);
+        HostClock::us = 0;
+        HostClock::valid = true;
+        HostClock::set(tzTestEpoch);
+        Time = TimeClass();
+        Serial.output.clear();
+        System.id = "e00fce68aabbccddeeff0011";
+        HostNet::reset();
+        int before = failures;
+        printf("%s %s\n", bench ? "BENCH" : "TEST ", t->name);
+        fflush(stdout);
+        t->function();
+        if (failures > before) printf("    (%d failed)\n", failures - before);
+        count++;
+    }
+    printf("%d %s, %d failed checks\n", count, bench ? "benchmarks" : "tests", failures);
+    return (failures > 255) ? 255 : failures;
+}
+
+int main(int argc, char** argv) {
+    return TzTest::run(argc, argv);
+}
@@ -0,0 +1,71 @@
+#ifndef __TZTEST_H_
+#define __TZTEST_H_
+
+/*      Library: TzCfg
+        Host tests: TzTest.h is included by every test & benchmark module.
+
+        TZ_TEST(name) defines a test, TZ_BENCH(name) a benchmark; both are
+        registered when the program starts and run by TzTest.cpp (see
+        test/Makefile). Each runs with a blank EEPROM, the mock clock at
+        tzTestEpoch and HostNet reset.
+
+        The tests reach into the library's private state, so private is
+        made public for the library header (the standard headers are
+        included first, untouched).
+*/
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <string>
+#include <vector>
+#include <deque>
+#include <chrono>
+#include <limits>
+#include <algorithm>
+#define private public
+#include "TzCfg.h"
+#undef private
+
+const time_t tzTestEpoch = 1704067200;  // <-- 2024-01-01 00:00:00 UTC ... the mock clock at the start of each test
+
+// ------------------------------------------------------------------- TzTest
+class TzTest {
+    public:
+        typedef void (*Function)(void);
+        TzTest(const char* name, Function function, bool bench);
+        static void fail(const char* file, int line, const char* expression);
+        static void report(const char* format, ...) __attribute__((format(printf, 1, 2)));  // <-- Prints a benchmark result line
+        static double nanos(void);                  // <-- Wall-clock nanoseconds (for benchmarks)
+        static int run(int argc, char** argv);
+    private:
+        const char* name;
+        Function function;
+        bool bench;
+        TzTest* next;
+        static TzTest* first;
+        static int failures;
+};
+
+#define TZ_TEST(name) \
+    static void name(void); \
+    static TzTest name##_test(#name, name, false); \
+    static void name(void)
+
+#define TZ_BENCH(name) \
+    static void name(void); \
+    static TzTest name##_bench(#name, name, true); \
+    static void name(void)
+
+#define TZ_CHECK(expression) \
+    do { if ( !(expression)) TzTest::fail(__FILE__, __LINE__, #expression); } while (0)
+
+#define TZ_CHECK_EQ(a, b) \
+    do { if ( !((a) == (b))) TzTest::fail(__FILE__, __LINE__, #a " == " #b); } while (0)
+
+// Keeps a benchmark's result from being optimized away
+template <typename T> inline void tzKeep(const T& value) {
+    asm volatile("" : : "g"(&value) : "memory");
+}
+
+#endif
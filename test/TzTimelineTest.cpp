@@ -0,0 +1,60 @@
+#include "TzStandIn.h"
+
+/*      Library: TzCfg
+        Host tests: TzTimelineTest.cpp covers TzTimeline.cpp ... arrays of
+        timestamps (in time order, shuffled, converted in place) checked
+        against the zone table one timestamp at a time.
+*/
+
+static char testKey[] = "TESTKEY";
+
+// Converts 'in' in each of the ways convertBatch() accepts, checking every result against the zone table
+static void checkBatch(TzCfg& tz, const char* id, std::vector<time_t> in) {
+    const TzStandInZone* zone = TzStandIn::find(id);
+    for (int order = 0; order < 3; order++) {
+        if (order == 1) std::reverse(in.begin(), in.end());
+        if (order == 2) for (size_t i = 0; i < in.size(); i++) std::swap(in[i], in[(i * 7919) % in.size()]);
+        std::vector<time_t> out(in.size()), inPlace = in;
+        tz.convertBatch(in.data(), out.data(), in.size());
+        tz.convertBatch(inPlace.data(), inPlace.data(), inPlace.size());
+        int wrong = 0;
+        for (size_t i = 0; i < in.size(); i++) {
+            if ((out[i] != in[i] + TzStandIn::offsetAt(zone, in[i])) || (inPlace[i] != out[i])) wrong++;
+        }
+        TZ_CHECK_EQ(wrong, 0);
+    }
+}
+
+// Timestamps from a month before the test epoch to the end of the stored schedule, with runs of every length
+TZ_TEST(convertBatchSchedule) {
+    TzStandIn::install();
+    TzCfg tz;
+    tz.begin();
+    tz.setApiKey_timezonedb(testKey);
+    char id[] = "America/Chicago";
+    TZ_CHECK_EQ(tz.setTimezoneByID(id), EXIT_SUCCESS);
+    TzStandIn::settle(tz);
+    TZ_CHECK_EQ(tz.schedule.count, tzScheduleSize);
+    time_t end = tz.schedule.tran[tz.schedule.count - 1].time;
+    std::vector<time_t> in;
+    for (time_t t = tzTestEpoch - (30 * 86400); t < end; t += 3593) in.push_back(t);
+    for (time_t t : { tz.getNextTransitionTime(), tz.schedule.tran[0].time }) {
+        for (time_t d = -3; d <= 3; d++) in.push_back(t + d);     // <-- either side of a transition
+    }
+    std::sort(in.begin(), in.end());
+    checkBatch(tz, id, in);
+}
+
+// A zone set by rule is converted by its rule outside the schedule, decades either side
+TZ_TEST(convertBatchRule) {
+    TzCfg tz;
+    tz.begin();
+    char id[] = "Europe/Paris";
+    char rule[] = "CET-1CEST,M3.5.0,M10.5.0/3";
+    TZ_CHECK_EQ(tz.setTimezoneByRule(id, rule), EXIT_SUCCESS);
+    std::vector<time_t> in;
+    for (time_t t = tzTestEpoch - (20L * 365 * 86400); t < tzTestEpoch + (20L * 365 * 86400); t += 86399) in.push_back(t);
+    checkBatch(tz, id, in);
+    checkBatch(tz, id, std::vector<time_t>(1, tzTestEpoch));
+    checkBatch(tz, id, std::vector<time_t>());
+}
@@ -0,0 +1,247 @@
+#include "application.h"
+
+/*      Library: TzCfg
+        Host shim: application.cpp implements the Device OS stand-ins declared
+        in application.h.
+*/
+
+TimeClass Time;
+EEPROMClass EEPROM;
+USBSerial Serial;
+SystemClass System;
+
+// ---------------------------------------------------------------------------- String
+String::String(float value, int decimalPlaces) : String((double)value, decimalPlaces) {}
+
+String::String(double value, int decimalPlaces) {
+    char text[48];
+    snprintf(text, sizeof(text), "%.*f", decimalPlaces, value);
+    this->text = text;
+}
+
+// ---------------------------------------------------------------------------- HostClock
+uint64_t HostClock::us = 0;
+time_t HostClock::epoch = 1704067200;   // <-- 2024-01-01 00:00:00 UTC
+bool HostClock::valid = true;
+
+void HostClock::set(time_t now) {
+    epoch = now - (time_t)(us / 1000000);
+}
+
+void HostClock::advance(unsigned long ms) {
+    us += (uint64_t)ms * 1000;
+}
+
+void HostClock::advanceMicros(unsigned long n) {
+    us += n;
+}
+
+unsigned long millis(void) {
+    return (unsigned long)(HostClock::us / 1000);
+}
+
+unsigned long micros(void) {
+    return (unsigned long)HostClock::us;
+}
+
+void delay(unsigned long ms) {
+    HostClock::advance(ms);
+}
+
+// ---------------------------------------------------------------------------- TimeClass
+time_t TimeClass::now(void) {
+    return HostClock::epoch + (time_t)(HostClock::us / 1000000);
+}
+
+bool TimeClass::isValid(void) {
+    return HostClock::valid;
+}
+
+void TimeClass::zone(float offset) {
+    this->zoneOffset = offset;
+}
+
+float TimeClass::zone(void) {
+    return this->zoneOffset;
+}
+
+bool TimeClass::isDST(void) {
+    return this->dst;
+}
+
+void TimeClass::beginDST(void) {
+    this->dst = true;
+}
+
+void TimeClass::endDST(void) {
+    this->dst = false;
+}
+
+float TimeClass::getDSTOffset(void) {
+    return this->dstOffset;
+}
+
+void TimeClass::setDSTOffset(float offset) {
+    this->dstOffset = offset;
+}
+
+time_t TimeClass::local(void) {
+    float offset = this->zoneOffset + (this->dst ? this->dstOffset : 0);
+    return now() + (time_t)lroundf(offset * 3600);
+}
+
+String TimeClass::format(time_t t, const char* format) {
+    char text[64];
+    struct tm tm;
+    gmtime_r(&t, &tm);
+    if ((format == NULL) || (strcmp(format, TIME_FORMAT_DEFAULT) == 0)) format = "%a %b %e %H:%M:%S %Y";
+    strftime(text, sizeof(text), format, &tm);
+    return String(text);
+}
+
+// ---------------------------------------------------------------------------- EEPROMClass
+uint8_t EEPROMClass::read(int address) {
+    this->reads++;
+    if ((address < 0) || (address >= (int)this->size)) return 0xFF;
+    return this->mem[address];
+}
+
+void EEPROMClass::write(int address, uint8_t value) {
+    this->writes++;
+    if ((address < 0) || (address >= (int)this->size)) return;
+    this->mem[address] = value;
+    this->wear[address]++;
+}
+
+void EEPROMClass::clear(void) {
+    memset(this->mem, 0xFF, sizeof(this->mem));
+    memset(this->wear, 0, sizeof(this->wear));
+    this->reads = 0;
+    this->writes = 0;
+}
+
+void EEPROMClass::resize(size_t size) {
+    this->size = (size < sizeof(this->mem)) ? size : sizeof(this->mem);
+    clear();
+}
+
+// ---------------------------------------------------------------------------- USBSerial & SystemClass
+void USBSerial::begin(long baud) {
+    (void)baud;
+}
+
+size_t USBSerial::write(const uint8_t* data, size_t size) {
+    this->output.append((const char*)data, size);
+    if (this->echo) fwrite(data, 1, size, stdout);
+    return size;
+}
+
+String SystemClass::deviceID(void) {
+    return String(this->id);
+}
+
+// ---------------------------------------------------------------------------- HostNet
+std::deque<std::string> HostNet::script;
+std::string (*HostNet::handler)(const std::string& request) = NULL;
+bool HostNet::refuse = false;
+bool HostNet::closeAfterResponse = false;
+unsigned long HostNet::connectMillis = 0;
+unsigned long HostNet::latencyMillis = 0;
+size_t HostNet::fragment = 0;
+unsigned long HostNet::fragmentMillis = 0;
+int HostNet::connects = 0;
+int HostNet::requests = 0;
+std::string HostNet::lastRequest;
+std::string HostNet::lastHost;
+
+void HostNet::reset(void) {
+    script.clear();
+    handler = NULL;
+    refuse = false;
+    closeAfterResponse = false;
+    connectMillis = 0;
+    latencyMillis = 0;
+    fragment = 0;
+    fragmentMillis = 0;
+    connects = 0;
+    requests = 0;
+    lastRequest.clear();
+    lastHost.clear();
+}
+
+// ---------------------------------------------------------------------------- TCPClient
+int TCPClient::connect(const char* host, uint16_t port) {
+    (void)port;
+    HostNet::connects++;
+    HostNet::lastHost = host;
+    delay(HostNet::connectMillis);
+    this->open = !HostNet::refuse;
+    this->closing = false;
+    this->request.clear();
+    this->response.clear();
+    this->position = 0;
+    return this->open ? 1 : 0;
+}
+
+uint8_t TCPClient::connected(void) {
+    if (this->closing && (this->position >= this->response.size())) this->open = false;
+    return this->open;
+}
+
+// Answers a complete request (headers end with a blank line; TzCfg's requests have no body)
+void TCPClient::respond(void) {
+    size_t end = this->request.find("\r\n\r\n");
+    if ((end == std::string::npos) || (this->position < this->response.size())) return;
+    std::string req = this->request.substr(0, end + 4);
+    this->request.erase(0, end + 4);
+    HostNet::requests++;
+    HostNet::lastRequest = req;
+    if (HostNet::handler != NULL) {
+        this->response = HostNet::handler(req);
+    } else if ( !HostNet::script.empty()) {
+        this->response = HostNet::script.front();
+        HostNet::script.pop_front();
+    } else {
+        this->response.clear();    // <-- no answer ... the server closes the connection
+        this->open = false;
+    }
+    this->position = 0;
+    this->readyMillis = millis() + HostNet::latencyMillis;
+    this->closing = HostNet::closeAfterResponse;
+}
+
+int TCPClient::available(void) {
+    if ( !this->open && (this->position >= this->response.size())) return 0;
+    respond();
+    if (millis() < this->readyMillis) return 0;
+    size_t released = this->response.size();
+    if ((HostNet::fragment > 0) && (HostNet::fragmentMillis > 0)) {
+        size_t fragments = 1 + ((millis() - this->readyMillis) / HostNet::fragmentMillis);
+        if (fragments * HostNet::fragment < released) released = fragments * HostNet::fragment;
+    }
+    return (released > this->position) ? (int)(released - this->position) : 0;
+}
+
+int TCPClient::read(void) {
+    if (available() <= 0) return -1;
+    return (uint8_t)this->response[this->position++];
+}
+
+void TCPClient::stop(void) {
+    this->open = false;
+    this->closing = false;
+    this->request.clear();
+    this->response.clear();
+    this->position = 0;
+}
+
+size_t TCPClient::print(const char* text) {
+    if (this->open) this->request += text;
+    return strlen(text);
+}
+
+size_t TCPClient::println(const char* text) {
+    print(text);
+    print("\r\n");
+    return strlen(text) + 2;
+}
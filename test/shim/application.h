@@ -0,0 +1,175 @@
+#ifndef __TZCFG_HOST_APPLICATION_H_
+#define __TZCFG_HOST_APPLICATION_H_
+
+/*      Library: TzCfg
+        Host shim: application.h stands in for the Particle Device OS header, so
+        the library builds and runs on Linux (see test/Makefile).
+
+        Only what TzCfg uses is provided: String, millis/micros/delay, Time,
+        EEPROM, Serial, System and TCPClient. The shim is deterministic:
+
+            HostClock ... a mock clock. millis() and Time.now() advance only
+                          when delay() is called or a test advances them.
+            EEPROM ...... the simulated EEPROM, with read & write counts and
+                          per-byte write counts for wear measurements.
+            HostNet ..... the server behind TCPClient. It replays canned
+                          responses, or asks a handler to answer each request,
+                          and can add connect & response latency and deliver a
+                          response in fragments.
+*/
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <time.h>
+#include <ctype.h>
+#include <math.h>
+#include <string>
+#include <deque>
+
+typedef uint8_t byte;
+
+#define TIME_FORMAT_DEFAULT "asctime"
+#define TIME_FORMAT_ISO8601_FULL "%Y-%m-%dT%H:%M:%S%z"
+
+// ------------------------------------------------------------------- String
+class String {
+    public:
+        String(void) {}
+        String(const char* text) : text((text != NULL) ? text : "") {}
+        String(const std::string& text) : text(text) {}
+        String(int value) : text(std::to_string(value)) {}
+        String(unsigned int value) : text(std::to_string(value)) {}
+        String(long value) : text(std::to_string(value)) {}
+        String(unsigned long value) : text(std::to_string(value)) {}
+        String(long long value) : text(std::to_string(value)) {}
+        String(float value, int decimalPlaces = 6);
+        String(double value, int decimalPlaces = 6);
+        const char* c_str(void) const { return this->text.c_str(); }
+        unsigned int length(void) const { return this->text.length(); }
+        operator const char*() const { return this->text.c_str(); }
+    private:
+        std::string text;
+};
+
+// ------------------------------------------------------------------- Timing
+unsigned long millis(void);
+unsigned long micros(void);
+void delay(unsigned long ms);
+
+class HostClock {
+    public:
+        static void set(time_t now);                // <-- Sets Time.now() (millis() carries on from where it is)
+        static void advance(unsigned long ms);      // <-- Advances millis(), micros() & Time.now()
+        static void advanceMicros(unsigned long us);    // <-- Advances micros() (and millis() once whole milliseconds pass)
+        static uint64_t us;                         // <-- Microseconds since the shim started
+        static time_t epoch;                        // <-- Time.now() when us was 0
+        static bool valid;                          // <-- Returned by Time.isValid()
+};
+
+// ------------------------------------------------------------------- Time
+class TimeClass {
+    public:
+        time_t now(void);
+        bool isValid(void);
+        void zone(float offset);
+        float zone(void);
+        bool isDST(void);
+        void beginDST(void);
+        void endDST(void);
+        float getDSTOffset(void);
+        void setDSTOffset(float offset);
+        time_t local(void);                         // <-- Time.now() with the zone & DST offsets applied
+        String format(time_t t, const char* format = NULL);
+    private:
+        float zoneOffset = 0;
+        float dstOffset = 1;
+        bool dst = false;
+};
+extern TimeClass Time;
+
+// ------------------------------------------------------------------- EEPROM
+const int hostEepromSize = 2047;    // <-- Photon / Electron emulated EEPROM
+
+class EEPROMClass {
+    public:
+        uint8_t read(int address);
+        void write(int address, uint8_t value);
+        size_t length(void) { return this->size; }
+        template <typename T> T& get(int address, T& t) {
+            for (size_t i = 0; i < sizeof(T); i++) ((uint8_t*)(void*)&t)[i] = read(address + i);
+            return t;
+        }
+        template <typename T> const T& put(int address, const T& t) {
+            for (size_t i = 0; i < sizeof(T); i++) write(address + i, ((const uint8_t*)(const void*)&t)[i]);
+            return t;
+        }
+        void clear(void);                           // <-- Erases the EEPROM (0xFF) and zeroes the counters
+        void resize(size_t size);                   // <-- Sets length() (at most sizeof(mem)), then clear()
+        uint8_t mem[8192];                          // <-- The EEPROM contents
+        uint32_t wear[8192];                        // <-- Writes per byte since clear()
+        uint32_t reads;                             // <-- read() calls (get() reads byte by byte) since clear()
+        uint32_t writes;                            // <-- write() calls since clear()
+    private:
+        size_t size = hostEepromSize;
+};
+extern EEPROMClass EEPROM;
+
+// ------------------------------------------------------------------- Serial & System
+class USBSerial {
+    public:
+        void begin(long baud = 9600);
+        size_t write(const uint8_t* data, size_t size);
+        bool echo = false;                          // <-- Set to copy Serial output to stdout
+        std::string output;                         // <-- Everything written since the last clear
+};
+extern USBSerial Serial;
+
+class SystemClass {
+    public:
+        String deviceID(void);
+        std::string id = "e00fce68aabbccddeeff0011";    // <-- Returned by deviceID()
+};
+extern SystemClass System;
+
+// ------------------------------------------------------------------- TCPClient
+class HostNet {
+    public:
+        static void reset(void);                    // <-- Closes the connection & restores the defaults below
+        static std::deque<std::string> script;      // <-- Canned responses, one per request (used when handler is NULL)
+        static std::string (*handler)(const std::string& request);  // <-- Answers each request (NULL = script)
+        static bool refuse;                         // <-- connect() fails
+        static bool closeAfterResponse;             // <-- The server closes the connection after each response
+        static unsigned long connectMillis;         // <-- Time connect() blocks (DNS & handshake)
+        static unsigned long latencyMillis;         // <-- Time from a complete request to the first response byte
+        static size_t fragment;                     // <-- Bytes per fragment (0 = the whole response at once)
+        static unsigned long fragmentMillis;        // <-- Time between fragments
+        static int connects;                        // <-- connect() calls since reset()
+        static int requests;                        // <-- Requests received since reset()
+        static std::string lastRequest;             // <-- The last complete request
+        static std::string lastHost;                // <-- The host of the last connect()
+};
+
+class TCPClient {
+    public:
+        int connect(const char* host, uint16_t port);
+        uint8_t connected(void);
+        int available(void);
+        int read(void);
+        void stop(void);
+        void flush(void) {}
+        size_t print(const char* text);
+        size_t println(const char* text = "");
+    private:
+        void respond(void);                         // <-- Has the server answer a complete request
+        bool open = false;                          // <-- Set while connected
+        bool closing = false;                       // <-- The server closes once the response has been read
+        std::string request;                        // <-- Request bytes received by the server
+        std::string response;                       // <-- Response being delivered
+        size_t position = 0;                        // <-- Response bytes read
+        unsigned long readyMillis = 0;              // <-- When the first response byte becomes available
+};
+
+#endif
@@ -0,0 +1,256 @@
+#!/usr/bin/env python3
+"""
+    Library: TzCfg
+    Tool: TzGeoGen.py generates src/TzGeo.h, the geographic index that
+    TzCfg::setTimezoneByGPS() searches when TZCFG_GEO_INDEX is defined.
+
+    Input: time zone boundary polygons as GeoJSON (a FeatureCollection whose
+    features have a "tzid" property and Polygon/MultiPolygon geometry, e.g.
+    the combined.json release of timezone-boundary-builder).
+
+    Polygons are simplified (Douglas-Peucker, --tolerance degrees), quantized
+    to int16 (~0.0055 degree steps), and bucketed into a lat/lng grid
+    (--cell degrees). A grid cell that lies inside a single zone stores that
+    zone directly, so most lookups need no point-in-polygon test at all.
+
+    Index layout (all const, so it stays in flash):
+        tzGeoZones ........ zone IDs, NUL terminated (referenced by offset)
+        tzGeoZoneIDs ...... offset of each zone ID within tzGeoZones
+        tzGeoCells ........ one entry per cell: 0x8000 | zone (0xFFFF = no zone),
+                            or an offset into tzGeoCellPolys
+        tzGeoCellPolys .... [polygon count][polygon index]... per mixed cell
+        tzGeoPolys ........ zone, first ring, ring count, bounding box
+        tzGeoRings ........ first vertex and vertex count of each ring
+        tzGeoVertices ..... quantized lat/lng pairs
+
+    Usage:
+        python3 tools/TzGeoGen.py combined.json [--tolerance 0.01] [--cell 4] [--check 10000]
+
+    A size report is printed; --check compares the index against the
+    unsimplified polygons at random points and reports the agreement.
+"""
+
+import argparse
+import json
+import os
+import random
+import sys
+import time
+
+SCALE_LAT = 32767.0 / 90.0
+SCALE_LNG = 32767.0 / 180.0
+
+
+def q_lat(v):
+    return max(-32767, min(32767, int(round(v * SCALE_LAT))))
+
+
+def q_lng(v):
+    return max(-32767, min(32767, int(round(v * SCALE_LNG))))
+
+
+def simplify(points, tolerance):
+    # Douglas-Peucker, iterative. points: [(lng, lat), ...]
+    if len(points) < 4 or tolerance <= 0:
+        return points
+    keep = [False] * len(points)
+    keep[0] = keep[-1] = True
+    stack = [(0, len(points) - 1)]
+    while stack:
+        first, last = stack.pop()
+        (x1, y1), (x2, y2) = points[first], points[last]
+        dx, dy = x2 - x1, y2 - y1
+        norm = (dx * dx + dy * dy) ** 0.5
+        index, dmax = -1, tolerance
+        for i in range(first + 1, last):
+            x, y = points[i]
+            d = abs(dy * x - dx * y + x2 * y1 - y2 * x1) / norm if norm else ((x - x1) ** 2 + (y - y1) ** 2) ** 0.5
+            if d > dmax:
+                index, dmax = i, d
+        if index >= 0:
+            keep[index] = True
+            stack.append((first, index))
+            stack.append((index, last))
+    result = [p for p, k in zip(points, keep) if k]
+    return result if len(result) >= 4 else points
+
+
+def inside(rings, lat, lng):
+    # even-odd rule across all rings (outer ring and holes)
+    c = False
+    for ring in rings:
+        j = len(ring) - 1
+        for i in range(len(ring)):
+            yi, xi = ring[i][1], ring[i][0]
+            yj, xj = ring[j][1], ring[j][0]
+            if (yi > lat) != (yj > lat) and lng < (xj - xi) * (lat - yi) / (yj - yi) + xi:
+                c = not c
+            j = i
+    return c
+
+
+def load(path, tolerance):
+    with open(path) as f:
+        data = json.load(f)
+    polygons = []   # (tzid, exact rings, simplified rings)
+    for feature in data["features"]:
+        tzid = feature["properties"]["tzid"]
+        geometry = feature["geometry"]
+        parts = geometry["coordinates"] if geometry["type"] == "MultiPolygon" else [geometry["coordinates"]]
+        for part in parts:
+            exact = [[(p[0], p[1]) for p in ring] for ring in part]
+            polygons.append((tzid, exact, [simplify(ring, tolerance) for ring in exact]))
+    return polygons
+
+
+def bbox(rings):
+    xs = [p[0] for r in rings for p in r]
+    ys = [p[1] for r in rings for p in r]
+    return min(ys), min(xs), max(ys), max(xs)
+
+
+def build(polygons, cell):
+    zones = sorted({p[0] for p in polygons})
+    zone_index = {z: i for i, z in enumerate(zones)}
+    rows, cols = int(180 / cell), int(360 / cell)
+    boxes = [bbox(p[2]) for p in polygons]
+
+    cells, cell_polys = [], []
+    for r in range(rows):
+        lat0 = -90 + r * cell
+        for c in range(cols):
+            lng0 = -180 + c * cell
+            hits = [i for i, (s, w, n, e) in enumerate(boxes)
+                    if s <= lat0 + cell and n >= lat0 and w <= lng0 + cell and e >= lng0]
+            # a cell is "pure" when its corners, center and edge midpoints all fall in one zone
+            # and every candidate polygon belongs to that zone
+            samples = [(lat0 + a * cell, lng0 + b * cell) for a in (0, 0.5, 1) for b in (0, 0.5, 1)]
+            found = set()
+            for lat, lng in samples:
+                z = None
+                for i in hits:
+                    if inside(polygons[i][2], lat, lng):
+                        z = polygons[i][0]
+                        break
+                found.add(z)
+            hit_zones = {polygons[i][0] for i in hits}
+            if not hits:
+                cells.append(0xFFFF)
+            elif len(found) == 1 and None not in found and hit_zones == found:
+                cells.append(0x8000 | zone_index[found.pop()])
+            else:
+                cells.append(len(cell_polys))
+                cell_polys.append(len(hits))
+                cell_polys.extend(hits)
+    if len(cell_polys) >= 0x8000:
+        sys.exit("Too many cell entries ... increase --cell")
+
+    polys, rings, vertices = [], [], []
+    for tzid, _, simple in polygons:
+        s, w, n, e = bbox(simple)
+        polys.append((zone_index[tzid], len(rings), len(simple), q_lat(s), q_lng(w), q_lat(n), q_lng(e)))
+        for ring in simple:
+            rings.append((len(vertices), len(ring)))
+            vertices.extend((q_lat(p[1]), q_lng(p[0])) for p in ring)
+    if len(zones) >= 0x7FFF or len(rings) > 32767 or any(p[2] > 32767 for p in polys):
+        sys.exit("Too many zones or rings for the int16 polygon table ... increase --tolerance")
+    return zones, rows, cols, cells, cell_polys, polys, rings, vertices
+
+
+def lookup(index, cell, lat, lng):
+    # Python model of TzCfg::findGeoZone()
+    zones, rows, cols, cells, cell_polys, polys, rings, vertices = index
+    r = min(rows - 1, int((lat + 90) / cell))
+    c = min(cols - 1, int((lng + 180) / cell))
+    entry = cells[r * cols + c]
+    if entry == 0xFFFF:
+        return None
+    if entry & 0x8000:
+        return zones[entry & 0x7FFF]
+    qlat, qlng = q_lat(lat), q_lng(lng)
+    for i in cell_polys[entry + 1: entry + 1 + cell_polys[entry]]:
+        zone, first, count, s, w, n, e = polys[i]
+        if not (s <= qlat <= n and w <= qlng <= e):
+            continue
+        ring_list = []
+        for k in range(first, first + count):
+            start, length = rings[k]
+            ring_list.append([(v[1], v[0]) for v in vertices[start:start + length]])
+        if inside(ring_list, qlat, qlng):
+            return zones[zone]
+    return None
+
+
+def c_array(ctype, name, values, per_line=16):
+    lines = []
+    for i in range(0, len(values), per_line):
+        lines.append("    " + ", ".join(str(v) for v in values[i:i + per_line]) + ",")
+    return "const %s %s[%d] = {\n%s\n};\n\n" % (ctype, name, len(values), "\n".join(lines))
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Generate TzCfg's geographic zone index")
+    parser.add_argument("geojson")
+    parser.add_argument("--tolerance", type=float, default=0.01, help="simplification tolerance (degrees)")
+    parser.add_argument("--cell", type=float, default=4.0, help="grid cell size (degrees, must divide 180)")
+    parser.add_argument("--check", type=int, default=0, help="random points to verify against the exact polygons")
+    parser.add_argument("--output", default=os.path.join(os.path.dirname(__file__), "..", "src", "TzGeo.h"))
+    args = parser.parse_args()
+
+    polygons = load(args.geojson, args.tolerance)
+    index = build(polygons, args.cell)
+    zones, rows, cols, cells, cell_polys, polys, rings, vertices = index
+
+    names = bytearray()
+    offsets = []
+    for z in zones:
+        offsets.append(len(names))
+        names += z.encode("ascii") + b"\0"
+    poly_values = [v for p in polys for v in p]
+    ring_values = [v for r in rings for v in r]
+    vertex_values = [v for p in vertices for v in p]
+
+    with open(args.output, "w") as out:
+        out.write("#ifndef __TZGEO_H_\n#define __TZGEO_H_\n")
+        out.write("/*  Library: TzCfg\n")
+        out.write("    Module: TzGeo.h is GENERATED by tools/TzGeoGen.py ... do not edit.\n")
+        out.write("    source: %s, tolerance: %g degrees, cell: %g degrees\n*/\n\n" % (os.path.basename(args.geojson), args.tolerance, args.cell))
+        out.write("const float TZ_GEO_CELL = %g;\n" % args.cell)
+        out.write("const uint16_t TZ_GEO_ROWS = %d;\n" % rows)
+        out.write("const uint16_t TZ_GEO_COLS = %d;\n\n" % cols)
+        out.write("const char tzGeoZones[] =\n%s;\n\n" % "\n".join('    "%s\\0"' % z for z in zones))
+        out.write(c_array("uint16_t", "tzGeoZoneIDs", offsets))
+        out.write(c_array("uint16_t", "tzGeoCells", cells))
+        out.write(c_array("uint16_t", "tzGeoCellPolys", cell_polys))
+        out.write("// zone, first ring, ring count, south, west, north, east\n")
+        out.write(c_array("int16_t", "tzGeoPolys", poly_values, 7))
+        out.write("// first vertex, vertex count\n")
+        out.write(c_array("uint32_t", "tzGeoRings", ring_values))
+        out.write("// lat, lng\n")
+        out.write(c_array("int16_t", "tzGeoVertices", vertex_values))
+        out.write("#endif\n")
+
+    sizes = [("tzGeoZones", len(names)), ("tzGeoZoneIDs", 2 * len(offsets)), ("tzGeoCells", 2 * len(cells)),
+             ("tzGeoCellPolys", 2 * len(cell_polys)), ("tzGeoPolys", 14 * len(polys)),
+             ("tzGeoRings", 8 * len(rings)), ("tzGeoVertices", 4 * len(vertices))]
+    print("TzGeoGen: %d zones, %d polygons, %d vertices (tolerance %g, cell %g)" % (len(zones), len(polys), len(vertices), args.tolerance, args.cell))
+    for name, size in sizes:
+        print("  %-15s %8d bytes" % (name, size))
+    print("  total flash     %8d bytes" % sum(s for _, s in sizes))
+    pure = sum(1 for c in cells if (c & 0x8000) and c != 0xFFFF)
+    print("  cells resolved without a polygon test: %d of %d" % (pure, len(cells)))
+
+    if args.check:
+        random.seed(1)
+        agree = 0
+        start = time.time()
+        for _ in range(args.check):
+            lat, lng = random.uniform(-60, 75), random.uniform(-180, 180)
+            exact = next((tzid for tzid, rings_exact, _ in polygons if inside(rings_exact, lat, lng)), None)
+            if lookup(index, args.cell, lat, lng) == exact:
+                agree += 1
+        print("  check: %d of %d random points agree with the exact polygons (%.1fs)" % (agree, args.check, time.time() - start))
+
+
+if __name__ == "__main__":
+    main()
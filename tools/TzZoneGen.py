@@ -0,0 +1,139 @@
+#!/usr/bin/env python3
+"""
+    Library: TzCfg
+    Tool: TzZoneGen.py generates src/TzZones.h, the built-in zone table that
+    TzCfg::setTimezoneByID() searches when TZCFG_ZONE_TABLE is defined.
+
+    The table is built from a compiled tzdata tree (e.g. /usr/share/zoneinfo).
+    Each TZif (version 2+) file ends with the POSIX TZ rule that describes the
+    zone's current and future transitions ... that rule is what TzCfg needs.
+
+    Table layout (all const, so it stays in flash):
+        tzZoneRules ....... interned rule strings, NUL terminated (referenced by offset)
+        tzZoneNames ....... sorted zone IDs, prefix compressed against the
+                            previous ID. Each entry is:
+                                [shared prefix length][suffix length][suffix][rule offset (2 bytes, big endian)]
+                            Every TZ_ZONE_RESTART'th entry is stored in full
+                            (shared prefix length = 0), so it can be binary searched.
+        tzZoneRestarts .... offsets of the full entries within tzZoneNames
+
+    Usage:
+        python3 tools/TzZoneGen.py [--zoneinfo DIR] [--restart N] [--output FILE]
+
+    A size report is printed, since flash is limited on Photon/Electron.
+"""
+
+import argparse
+import os
+import sys
+
+SKIP_DIRS = {"posix", "right"}
+SKIP_FILES = {"localtime", "posixrules", "Factory"}
+
+
+def read_rule(path):
+    # Returns the POSIX TZ rule from a TZif v2+ file, or None
+    with open(path, "rb") as f:
+        data = f.read()
+    if not data.startswith(b"TZif") or data[4:5] not in (b"2", b"3", b"4"):
+        return None
+    footer = data.rstrip(b"\n")
+    nl = footer.rfind(b"\n")
+    if nl < 0:
+        return None
+    rule = footer[nl + 1:].decode("ascii", "replace")
+    return rule or None
+
+
+def collect(zoneinfo):
+    zones = {}
+    for root, dirs, files in os.walk(zoneinfo):
+        dirs[:] = sorted(d for d in dirs if d not in SKIP_DIRS)
+        for name in files:
+            path = os.path.join(root, name)
+            zone_id = os.path.relpath(path, zoneinfo).replace(os.sep, "/")
+            if name in SKIP_FILES or "." in name or len(zone_id) > 64:
+                continue
+            rule = read_rule(path)
+            if rule and len(rule) < 48:     # <-- must fit TzSchedule::rule
+                zones[zone_id] = rule
+    return dict(sorted(zones.items(), key=lambda kv: kv[0].encode("ascii")))
+
+
+def build(zones, restart):
+    rules = bytearray()
+    rule_offsets = {}
+    for rule in zones.values():
+        if rule not in rule_offsets:
+            rule_offsets[rule] = len(rules)
+            rules += rule.encode("ascii") + b"\0"
+
+    names = bytearray()
+    restarts = []
+    previous = b""
+    for i, (zone_id, rule) in enumerate(zones.items()):
+        zid = zone_id.encode("ascii")
+        shared = 0
+        if i % restart == 0:
+            restarts.append(len(names))
+        else:
+            while shared < min(len(previous), len(zid), 255) and previous[shared] == zid[shared]:
+                shared += 1
+        suffix = zid[shared:]
+        offset = rule_offsets[rule]
+        names += bytes([shared, len(suffix)]) + suffix + bytes([offset >> 8, offset & 0xFF])
+        previous = zid
+    return rules, names, restarts
+
+
+def c_bytes(data, indent="    "):
+    lines = []
+    for i in range(0, len(data), 16):
+        lines.append(indent + ", ".join("0x%02X" % b for b in data[i:i + 16]) + ",")
+    return "\n".join(lines)
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Generate TzCfg's built-in zone table")
+    parser.add_argument("--zoneinfo", default="/usr/share/zoneinfo")
+    parser.add_argument("--restart", type=int, default=16, help="entries between full (searchable) zone IDs")
+    parser.add_argument("--output", default=os.path.join(os.path.dirname(__file__), "..", "src", "TzZones.h"))
+    args = parser.parse_args()
+
+    zones = collect(args.zoneinfo)
+    if not zones:
+        sys.exit("No TZif files with POSIX rules found in " + args.zoneinfo)
+    rules, names, restarts = build(zones, args.restart)
+
+    version = "unknown"
+    tzdata_zi = os.path.join(args.zoneinfo, "tzdata.zi")
+    if os.path.exists(tzdata_zi):
+        with open(tzdata_zi) as f:
+            first = f.readline().strip()
+            if first.startswith("# version"):
+                version = first.split()[-1]
+
+    with open(args.output, "w") as out:
+        out.write("#ifndef __TZZONES_H_\n#define __TZZONES_H_\n")
+        out.write("/*  Library: TzCfg\n")
+        out.write("    Module: TzZones.h is GENERATED by tools/TzZoneGen.py ... do not edit.\n")
+        out.write("    tzdata version: %s, zones: %d, rules: %d\n*/\n\n" % (version, len(zones), len(rules.split(b"\0")) - 1))
+        out.write("const char TZ_ZONE_VERSION[] = \"%s\";\n" % version)
+        out.write("const uint16_t TZ_ZONE_COUNT = %d;\n" % len(zones))
+        out.write("const uint8_t TZ_ZONE_RESTART = %d;\n\n" % args.restart)
+        out.write("const char tzZoneRules[] =\n%s;\n\n" % "\n".join('    "%s\\0"' % r for r in rules.decode("ascii").split("\0")[:-1]))
+        out.write("const uint8_t tzZoneNames[%d] = {\n%s\n};\n\n" % (len(names), c_bytes(names)))
+        out.write("const uint16_t tzZoneRestarts[%d] = {\n    %s\n};\n\n" % (len(restarts), ", ".join(str(r) for r in restarts)))
+        out.write("#endif\n")
+
+    raw = sum(len(z) + 1 for z in zones) + sum(len(r) + 1 for r in zones.values())
+    total = len(rules) + len(names) + 2 * len(restarts)
+    print("TzZoneGen: tzdata %s, %d zones, %d distinct rules" % (version, len(zones), len(rules.split(b"\0")) - 1))
+    print("  tzZoneRules    %6d bytes" % len(rules))
+    print("  tzZoneNames    %6d bytes" % len(names))
+    print("  tzZoneRestarts %6d bytes" % (2 * len(restarts)))
+    print("  total flash    %6d bytes (uncompressed IDs + rules: %d bytes)" % (total, raw))
+
+
+if __name__ == "__main__":
+    main()